@@ -88,13 +88,24 @@ float SDM::readVal(uint16_t reg, uint8_t node) {
 }
 
 void SDM::startReadVal(uint16_t reg, uint8_t node, uint8_t functionCode) {
+  startReadVals(reg, SDM_B_06, node, functionCode);
+}
+
+uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
+  return readValsReady(SDM_B_06, node, functionCode);
+}
+
+void SDM::startReadVals(uint16_t reg, uint8_t nrRegisters, uint8_t node, uint8_t functionCode) {
+  if (nrRegisters > SDM_MAX_NR_REGISTERS)
+    nrRegisters = SDM_MAX_NR_REGISTERS;
+
   uint8_t data[] = {
     node,             // Address
     functionCode,     // Modbus function
     highByte(reg),    // Start address high byte
     lowByte(reg),     // Start address low byte
     SDM_B_05,         // Number of points high byte
-    SDM_B_06,         // Number of points low byte
+    nrRegisters,      // Number of points low byte
     0,                // Checksum low byte
     0};               // Checksum high byte
 
@@ -102,14 +113,18 @@ void SDM::startReadVal(uint16_t reg, uint8_t node, uint8_t functionCode) {
   modbusWrite(data, messageLength);
 }
 
-uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
+uint16_t SDM::readValsReady(uint8_t nrRegisters, uint8_t node, uint8_t functionCode) {
+  if (nrRegisters > SDM_MAX_NR_REGISTERS)
+    nrRegisters = SDM_MAX_NR_REGISTERS;
+
+  const int framesize = 5 + 2 * nrRegisters;                                    //address, function, byte count, data, crc
   uint16_t readErr = SDM_ERR_NO_ERROR;
-  if (sdmSer.available() < FRAMESIZE && ((millis() - resptime) < msturnaround)) 
+  if (sdmSer.available() < framesize && ((millis() - resptime) < msturnaround)) 
   {
     return SDM_ERR_STILL_WAITING;
   }
 
-  while (sdmSer.available() < FRAMESIZE) {
+  while (sdmSer.available() < framesize) {
     if ((millis() - resptime) > msturnaround) {
       readErr = SDM_ERR_TIMEOUT;                                                //err debug (4)
 
@@ -117,6 +132,7 @@ uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
         for(int n=0; n<5; n++) {
           sdmarr[n] = sdmSer.read();
         }
+        sdmarrsize = 5;
         if (validChecksum(sdmarr, 5)) {
           readErr = sdmarr[2];
         }
@@ -128,16 +144,17 @@ uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
 
   if (readErr == SDM_ERR_NO_ERROR) {                                            //if no timeout...
 
-    if (sdmSer.available() >= FRAMESIZE) {
+    if (sdmSer.available() >= framesize) {
 
-      for(int n=0; n<FRAMESIZE; n++) {
+      for(int n=0; n<framesize; n++) {
         sdmarr[n] = sdmSer.read();
       }
+      sdmarrsize = framesize;
 
       if (sdmarr[0] == node && 
           sdmarr[1] == functionCode && 
-          sdmarr[2] == SDM_REPLY_BYTE_COUNT) {
-        if (!validChecksum(sdmarr, FRAMESIZE)) {
+          sdmarr[2] == 2 * nrRegisters) {
+        if (!validChecksum(sdmarr, framesize)) {
           readErr = SDM_ERR_CRC_ERROR;                                          //err debug (1)
         }
 
@@ -169,13 +186,15 @@ uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
   return readErr;
 }
 
-float SDM::decodeFloatValue() const {
-  if (validChecksum(sdmarr, FRAMESIZE)) {
+float SDM::decodeFloatValue(uint8_t regOffset) const {
+  const int pos = 3 + 2 * regOffset;                                            //skip address, function and byte count
+
+  if ((pos + 4 + 2) <= sdmarrsize && validChecksum(sdmarr, sdmarrsize)) {
     float res{};
-    ((uint8_t*)&res)[3]= sdmarr[3];
-    ((uint8_t*)&res)[2]= sdmarr[4];
-    ((uint8_t*)&res)[1]= sdmarr[5];
-    ((uint8_t*)&res)[0]= sdmarr[6];
+    ((uint8_t*)&res)[3]= sdmarr[pos];
+    ((uint8_t*)&res)[2]= sdmarr[pos + 1];
+    ((uint8_t*)&res)[1]= sdmarr[pos + 2];
+    ((uint8_t*)&res)[0]= sdmarr[pos + 3];
     return res;
   }
   constexpr float res = NAN;
@@ -103,6 +103,8 @@
 #define SDM_WRITE_HOLDING_REGISTER                    0x10
 
 #define FRAMESIZE                                     9                         //  size of out/in array
+#define SDM_MAX_NR_REGISTERS                          20                        //  max. nr of registers to read in a single request
+#define SDM_MAX_FRAMESIZE                             (5 + 2 * SDM_MAX_NR_REGISTERS)
 #define SDM_REPLY_BYTE_COUNT                          0x04                      //  number of bytes with data
 
 #define SDM_B_01                                      0x01                      //  BYTE 1 -> slave address (default value 1 read from node 1)
@@ -338,7 +340,9 @@ class SDM {
     float readVal(uint16_t reg, uint8_t node = SDM_B_01);                       //  read value from register = reg and from deviceId = node
     void startReadVal(uint16_t reg, uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);                   //  Start sending out the request to read a register from a specific node (allows for async access)
     uint16_t readValReady(uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);                             //  Check to see if a reply is ready reading from a node (allow for async access)
-    float decodeFloatValue() const;
+    void startReadVals(uint16_t reg, uint8_t nrRegisters, uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);   //  Start reading nrRegisters consecutive registers (max. SDM_MAX_NR_REGISTERS) in a single request
+    uint16_t readValsReady(uint8_t nrRegisters, uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);           //  Check to see if a reply is ready reading nrRegisters from a node
+    float decodeFloatValue(uint8_t regOffset = 0) const;                         //  Decode the value at regOffset registers from the first register read
 
     float readHoldingRegister(uint16_t reg, uint8_t node = SDM_B_01);
     bool writeHoldingRegister(float value, uint16_t reg, uint8_t node = SDM_B_01);
@@ -392,7 +396,8 @@ class SDM {
     uint32_t readingerrcount = 0;                                               //  total errors counter
     uint32_t readingsuccesscount = 0;                                           //  total success counter
     unsigned long resptime = 0;
-    uint8_t sdmarr[FRAMESIZE] = {};
+    uint8_t sdmarr[SDM_MAX_FRAMESIZE] = {};
+    uint8_t sdmarrsize = FRAMESIZE;                                             //  size of the last received frame
     uint16_t calculateCRC(const uint8_t *array, uint8_t len) const;
     void flush(unsigned long _flushtime = 0);                                   //  read serial if any old data is available or for a given time in ms
     void dereSet(bool _state = LOW);                                            //  for control MAX485 DE/RE pins, LOW receive from SDM, HIGH transmit to SDM
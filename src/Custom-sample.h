@@ -23,6 +23,9 @@
 // Can be set to 1 to enable, 0 to disable, or not set to use the default (usually via define_plugin_sets.h)
 
 #define FEATURE_RULES_EASY_COLOR_CODE   1  // Use code highlighting, autocompletion and command suggestions in Rules
+// #define FEATURE_RULES_CALCULATE_COMPILED 1  // Cache compiled (RPN) versions of calculations, only numbers are parsed again when changed
+// #define FEATURE_RULES_COMPILED       1  // Compile rules blocks once into a program (needs 'Enable Rules Cache') instead of parsing each line per event
+// #define FEATURE_TASKVALUE_DEADBAND   1  // Send on change: Only send task values to controllers when changed more than a deadband, with optional heartbeat
 #define FEATURE_ESPEASY_P2P             1  // (1/0) enables the ESP Easy P2P protocol
 #define FEATURE_ARDUINO_OTA             1  // enables the Arduino OTA capabilities
 #define FEATURE_THINGSPEAK_EVENT        1  // generate an event when requesting last value of a field in thingspeak via SendToHTTP(e.g. sendToHTTP,api.thingspeak.com,80,/channels/1667332/fields/5/last)
@@ -238,6 +241,8 @@
 // #define FEATURE_SEND_TO_HTTP 1 // Enable availability of the SendToHTTP command
 // #define FEATURE_POST_TO_HTTP 1 // Enable availability of the PostToHTTP command
 // #define FEATURE_PUT_TO_HTTP 1 // Enable availability of the PutToHTTP command
+// #define FEATURE_HTTP_KEEPALIVE 1 // Allow HTTP controllers to keep their connection open for the next message (HTTP/1.1 keep-alive)
+// #define FEATURE_EXTENDED_METRICS 1 // Export timing histograms and controller queue counters on the /metrics page
 // #define FEATURE_I2C_DEVICE_CHECK 0 // Disable the I2C Device check feature
 // #define FEATURE_I2C_GET_ADDRESS 0 // Disable fetching the I2C address from I2C plugins. Will be enabled when FEATURE_I2C_DEVICE_CHECK is enabled
 // #define FEATURE_RTTTL 1   // Enable rtttl command
@@ -19,6 +19,7 @@ bool CPlugin_004(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_004;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
       proto.defaultPort  = 80;
@@ -72,7 +73,7 @@ bool CPlugin_004(CPlugin::Function function, struct EventStruct *event, String&
         break;
       }
 
-      std::unique_ptr<C004_queue_element> element(new (std::nothrow) C004_queue_element(event));
+      std::unique_ptr<C004_queue_element> element(new (C004_DelayHandler->elementPool) C004_queue_element(event));
 
       success = C004_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C004_DELAY_QUEUE, C004_DelayHandler->getNextScheduleTime());
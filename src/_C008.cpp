@@ -20,6 +20,7 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_008;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesTemplate = true;
       proto.usesAccount  = true;
       proto.usesPassword = true;
@@ -79,7 +80,7 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
       const bool contains_valname = pubname.indexOf(F("%valname%")) != -1;
 
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
-      std::unique_ptr<C008_queue_element> element(new (std::nothrow) C008_queue_element(event, valueCount));
+      std::unique_ptr<C008_queue_element> element(new (C008_DelayHandler->elementPool) C008_queue_element(event, valueCount));
       success = C008_DelayHandler->addToQueue(std::move(element));
 
       if (success) {
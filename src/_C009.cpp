@@ -46,6 +46,7 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_009;
       proto.usesMQTT     = false;
+      proto.usesHTTP     = true;
       proto.usesTemplate = false;
       proto.usesAccount  = true;
       proto.usesPassword = true;
@@ -80,7 +81,7 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
           break;
         }
 
-        std::unique_ptr<C009_queue_element> element(new (std::nothrow) C009_queue_element(event));
+        std::unique_ptr<C009_queue_element> element(new (C009_DelayHandler->elementPool) C009_queue_element(event));
         success = C009_DelayHandler->addToQueue(std::move(element));
         Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C009_DELAY_QUEUE, C009_DelayHandler->getNextScheduleTime());
       }
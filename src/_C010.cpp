@@ -9,6 +9,16 @@
 # define CPLUGIN_ID_010         10
 # define CPLUGIN_NAME_010       "Generic UDP"
 
+// Max. number of queued samples combined in a single UDP packet
+# define C010_MAX_BATCH_SIZE    10
+
+// Keep the combined UDP payload below the typical MTU to prevent fragmentation
+# define C010_MAX_BATCH_PAYLOAD 1400
+
+// *INDENT-OFF*
+size_t do_process_c010_delay_queue_batch(cpluginID_t cpluginID, const std::vector<const Queue_element_base *>& elements, ControllerSettingsStruct& ControllerSettings);
+// *INDENT-ON*
+
 bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String& string)
 {
   bool success = false;
@@ -24,6 +34,7 @@ bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesPassword = false;
       proto.defaultPort  = 514;
       proto.usesID       = false;
+      proto.maxBatchSize = C010_MAX_BATCH_SIZE;
       break;
     }
 
@@ -43,6 +54,10 @@ bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_c010_delay_queue(event->ControllerIndex);
+
+      if (success) {
+        C010_DelayHandler->batch_func = do_process_c010_delay_queue_batch;
+      }
       break;
     }
 
@@ -69,7 +84,7 @@ bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String&
 
       //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
-      std::unique_ptr<C010_queue_element> element(new (std::nothrow) C010_queue_element(event, valueCount));
+      std::unique_ptr<C010_queue_element> element(new (C010_DelayHandler->elementPool) C010_queue_element(event, valueCount));
 
 
       {
@@ -162,4 +177,72 @@ bool do_process_c010_delay_queue(cpluginID_t cpluginID, const Queue_element_base
   return element.checkDone(true);
 }
 
+// ********************************************************************************
+// Generic UDP message, combining multiple samples
+// Each value is sent on a separate line, all in a single UDP packet.
+// ********************************************************************************
+
+// *INDENT-OFF*
+size_t do_process_c010_delay_queue_batch(cpluginID_t cpluginID, const std::vector<const Queue_element_base *>& elements, ControllerSettingsStruct& ControllerSettings) {
+// *INDENT-ON*
+  String payload;
+  size_t nrElements = 0;
+
+  if (!reserve_special(payload, C010_MAX_BATCH_PAYLOAD)) {
+    return 0;
+  }
+
+  for (auto it = elements.begin(); it != elements.end(); ++it) {
+    const C010_queue_element& element = static_cast<const C010_queue_element&>(**it);
+
+    // Values of the first element may have been partially sent already
+    size_t length = 0;
+
+    for (uint8_t x = element.valuesSent; x < element.valueCount && x < VARS_PER_TASK; ++x) {
+      if (!element.txt[x].isEmpty()) {
+        length += element.txt[x].length() + 1;
+      }
+    }
+
+    if ((nrElements != 0) && ((payload.length() + length) > C010_MAX_BATCH_PAYLOAD)) {
+      break;
+    }
+
+    for (uint8_t x = element.valuesSent; x < element.valueCount && x < VARS_PER_TASK; ++x) {
+      if (!element.txt[x].isEmpty()) {
+        if (!payload.isEmpty()) {
+          payload += '\n';
+        }
+        payload += element.txt[x];
+      }
+    }
+    ++nrElements;
+  }
+
+  if (payload.isEmpty()) {
+    // No valid values, nothing to send
+    return nrElements;
+  }
+
+  WiFiUDP C010_portUDP;
+
+  if (!beginWiFiUDP_randomPort(C010_portUDP)) { return 0; }
+
+  if (!try_connect_host(cpluginID, C010_portUDP, ControllerSettings)) {
+    return 0;
+  }
+
+  C010_portUDP.write(
+    reinterpret_cast<const uint8_t *>(payload.c_str()),
+    payload.length());
+  const bool reply = C010_portUDP.endPacket();
+
+  C010_portUDP.stop();
+
+  if (ControllerSettings.MustCheckReply && !reply) {
+    return 0;
+  }
+  return nrElements;
+}
+
 #endif // ifdef USES_C010
@@ -59,7 +59,7 @@ bool CPlugin_012(CPlugin::Function function, struct EventStruct *event, String&
 
       // Collect the values at the same run, to make sure all are from the same sample
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
-      std::unique_ptr<C012_queue_element> element(new (std::nothrow) C012_queue_element(event, valueCount));
+      std::unique_ptr<C012_queue_element> element(new (C012_DelayHandler->elementPool) C012_queue_element(event, valueCount));
 
       for (uint8_t x = 0; x < valueCount; x++)
       {
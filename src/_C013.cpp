@@ -155,7 +155,7 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
   // For example sending different sensor type data from one dummy to another is probably not going to work well
   dataReply.sensorType = event->getSensorType();
 
-  const TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(event->TaskIndex);
+  const TaskValues_Data_t *taskValues = static_cast<const UserVarStruct&>(UserVar).getRawTaskValues_Data(event->TaskIndex);
 
 
   if (taskValues != nullptr) {
@@ -387,6 +387,7 @@ void C013_Receive(struct EventStruct *event) {
 
               if (taskValues != nullptr) {
                 memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
+                UserVar.markChanged(dataReply.destTaskIndex);
               }
               STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
 
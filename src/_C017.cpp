@@ -67,7 +67,7 @@ bool CPlugin_017(CPlugin::Function function, struct EventStruct *event, String&
         break;
       }
 
-      std::unique_ptr<C017_queue_element> element(new (std::nothrow) C017_queue_element(event));
+      std::unique_ptr<C017_queue_element> element(new (C017_DelayHandler->elementPool) C017_queue_element(event));
       success = C017_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C017_DELAY_QUEUE, C017_DelayHandler->getNextScheduleTime());
       break;
@@ -186,7 +186,7 @@ bool CPlugin_018(CPlugin::Function function, struct EventStruct *event, String&
 
       if (C018_data != nullptr) {
         {
-          std::unique_ptr<C018_queue_element> element(new (std::nothrow) C018_queue_element(event, C018_data->getSampleSetCount(event->TaskIndex)));
+          std::unique_ptr<C018_queue_element> element(new (C018_DelayHandler->elementPool) C018_queue_element(event, C018_data->getSampleSetCount(event->TaskIndex)));
           success = C018_DelayHandler->addToQueue(std::move(element));
           Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C018_DELAY_QUEUE,
                                            C018_DelayHandler->getNextScheduleTime());
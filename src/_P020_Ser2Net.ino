@@ -8,6 +8,7 @@
 
 /************
  * Changelog:
+ * 2026-10-18: Add option Transparent bridge mode: forward data unchanged using ring buffers in both directions, without blocking
  * 2023-08-26 tonhuisman: P044 mode: Set RX time-out default to 50 msec for better receive pace of P1 data
  * 2023-08-17 tonhuisman: P1 data: Allow some extra reading timeout between the data and the checksum, as some meters need more time to
  *                        calculate the CRC. Add CR/LF before sending P1 data.
@@ -237,6 +238,11 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
         if (!P020_Emulate_P044) { // Not appropriate for P1 WiFi Gateway
           addFormCheckBox(F("Multiple lines processing"), F("pmultiline"), P020_HANDLE_MULTI_LINE);
+
+          addFormCheckBox(F("Transparent bridge mode"), F("pbridge"), P020_GET_BRIDGE_MODE);
+          # ifndef LIMIT_BUILD_SIZE
+          addFormNote(F("Forward data unchanged in both directions, no events. Serial data is sent after the RX Receive Timeout."));
+          # endif // ifndef LIMIT_BUILD_SIZE
         }
       }
       {
@@ -258,6 +264,18 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         addFormCheckBox(F("Led inverted"), F("pledinv"), P020_GET_LED_INVERTED == 1);
       }
 
+      {
+        P020_Task *task = static_cast<P020_Task *>(getPluginTaskData(event->TaskIndex));
+
+        if ((nullptr != task) && task->_bridgeMode) {
+          addFormSubHeader(F("Statistics"));
+          addRowLabel(F("Bytes serial/network"));
+          addHtml(strformat(F("%u/%u"), task->_bytesSerialToNet, task->_bytesNetToSerial));
+          addRowLabel(F("Buffer overflows"));
+          addHtmlInt(task->_bridgeOverflows);
+        }
+      }
+
       success = true;
       break;
     }
@@ -298,6 +316,7 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         bitSet(lSettings, P020_FLAG_P044_MODE_SAVED); // Set to P044 configuration done on every save
       } else {
         bitWrite(lSettings, P020_FLAG_MULTI_LINE, isFormItemChecked(F("pmultiline")));
+        bitWrite(lSettings, P020_FLAG_BRIDGE_MODE, isFormItemChecked(F("pbridge")));
       }
 
       P020_FLAGS = lSettings;
@@ -396,6 +415,8 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
       task->serial_processing = static_cast<P020_Events>(P020_SERIAL_PROCESSING);
       task->_P1EventData      = P020_GET_P1_EVENT_DATA;
+      task->_bridgeMode       = P020_GET_BRIDGE_MODE && !P020_Emulate_P044;
+      task->_bridgeIdleGap    = P020_RX_WAIT;
 
       task->blinkLED();
 
@@ -445,7 +466,9 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       if (nullptr != task) {
         bool hasClient = task->hasClientConnected();
 
-        if (P020_IGNORE_CLIENT_CONNECTED || hasClient) {
+        if (task->_bridgeMode) {
+          task->handleBridge();
+        } else if (P020_IGNORE_CLIENT_CONNECTED || hasClient) {
           if (hasClient) {
             task->handleClientIn(event);
           }
@@ -462,7 +485,10 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       P020_Task *task = static_cast<P020_Task *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != task) {
-        if (P020_IGNORE_CLIENT_CONNECTED || task->hasClientConnected()) {
+        if (task->_bridgeMode) {
+          task->hasClientConnected();
+          task->handleBridge();
+        } else if (P020_IGNORE_CLIENT_CONNECTED || task->hasClientConnected()) {
           task->handleSerialIn(event);
         } else {
           task->discardSerialIn();
@@ -687,6 +687,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
 bool MQTT_unsubscribe_037(struct EventStruct *event)
 {
+  P037_MQTT_router.unsubscribe(event->TaskIndex);
+
   P037_data_struct *P037_data = static_cast<P037_data_struct *>(getPluginTaskData(event->TaskIndex));
 
   if (nullptr == P037_data) {
@@ -757,12 +759,16 @@ bool MQTTSubscribe_037(struct EventStruct *event)
   // FIXME TD-er: Should not be needed to load, as it is loaded when constructing it.
   P037_data->loadSettings();
 
+  // Incoming messages are only routed to this task for the topics subscribed to below
+  P037_MQTT_router.unsubscribe(event->TaskIndex);
+
   // Now loop over all import variables and subscribe to those that are not blank
   for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
     String subscribeTo = P037_data->getFullMQTTTopic(x);
 
     if (!subscribeTo.isEmpty()) {
       parseSystemVariables(subscribeTo, false);
+      P037_MQTT_router.subscribe(event->TaskIndex, subscribeTo);
 
       if (MQTTclient.subscribe(subscribeTo.c_str())) {
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
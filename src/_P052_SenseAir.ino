@@ -154,6 +154,12 @@ boolean Plugin_052(uint8_t function, struct EventStruct *event, String& string)
             P052_data->modbus.getStatistics(reads_pass, reads_crc_failed, reads_nodata);
             addHtml(strformat(F("%d/%d/%d"), reads_pass, reads_crc_failed, reads_nodata));
           }
+          addRowLabel(F("Latency (avg/max)"));
+          {
+            uint32_t latency_avg, latency_max;
+            P052_data->modbus.getLatency(latency_avg, latency_max);
+            addHtml(strformat(F("%u/%u ms"), latency_avg, latency_max));
+          }
 
           bool hasFactorySettings = false;
           bool enabledABC         = false;
@@ -374,99 +380,27 @@ boolean Plugin_052(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P052_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P052_data) && P052_data->isInitialized()) {
-        event->sensorType = static_cast<Sensor_VType>(PCONFIG(P052_SENSOR_TYPE_INDEX));
-        String log = F("Senseair: ");
-        String logPrefix;
-
-        for (int varnr = 0; varnr < P052_NR_OUTPUT_VALUES; ++varnr) {
-          uint8_t errorcode = 0;
-          float   value     = 0;
-
-          switch (PCONFIG(varnr)) {
-            case 1: {
-              value     = P052_data->modbus.readInputRegister(P052_IR4_MEASURED_FILTERED_CO2, errorcode);
-              logPrefix = F("co2=");
-              break;
-            }
-            case 2: {
-              int temperatureX100 = P052_data->modbus.readInputRegister(P052_IR5_TEMPERATURE, errorcode);
-
-              if (errorcode == 2) {
-                // Exception code: Illegal Data Address
-                // SenseAir S8, not for other modules.
-                temperatureX100 = P052_data->modbus.read_RAM_EEPROM(
-                  P052_CMD_READ_RAM, P052_RAM_ADDR_DET_TEMPERATURE, 2, errorcode);
-              }
+        if (!P052_data->newValuesAvailable()) {
+          // Values are read in the background, a read is scheduled when all values are received.
+          P052_data->startRead(event);
+        }
 
-              if (temperatureX100 >= 32768) {
-                // 2-complement value.
-                temperatureX100 -= 65536;
-              }
-              value     = static_cast<float>(temperatureX100) / 100.0f;
-              logPrefix = F("temp=");
-              break;
-            }
-            case 3: {
-              int rhX100 = P052_data->modbus.readInputRegister(P052_IR6_SPACE_HUMIDITY, errorcode);
-              value     = static_cast<float>(rhX100) / 100.0f;
-              logPrefix = F("hum=");
-              break;
-            }
-            case 4: {
-              int status = P052_data->modbus.readInputRegister(P052_IR29_FW_REV, errorcode);
-
-              if (errorcode == 0) {
-                int relayStatus = (status >> 8) & 0x1;
-                UserVar.setFloat(event->TaskIndex, varnr, relayStatus);
-                log += F("relay status=");
-                log += relayStatus;
-              }
-              break;
-            }
-            case 5: {
-              int temperatureAdjustment = P052_data->modbus.readInputRegister(P052_IR11_MEASURED_CONCENTRATION_UNFILTERED, errorcode);
-              value     = static_cast<float>(temperatureAdjustment);
-              logPrefix = F("temp adj=");
-              break;
-            }
+        if (P052_data->newValuesAvailable()) {
+          event->sensorType = static_cast<Sensor_VType>(PCONFIG(P052_SENSOR_TYPE_INDEX));
+          success           = P052_data->setTaskValues(event);
+        }
+      }
+      break;
+    }
 
-            case 7: {
-              const int errorWord = P052_data->modbus.readInputRegister(P052_IR_ERRORSTATUS, errorcode);
-
-              if (errorcode == 0) {
-                value = errorWord;
-
-                for (size_t i = 0; i < 9; i++) {
-                  if (bitRead(errorWord, i)) {
-                    log += F("err=");
-                    log += i;
-                    break;
-                  }
-                }
-              } else {
-                value = -1;
-                log  += F("err=");
-                log  += -1;
-              }
-              break;
-            }
-            case 0:
-            default: {
-              UserVar.setFloat(event->TaskIndex, varnr, 0);
-              break;
-            }
-          }
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P052_data_struct *P052_data =
+        static_cast<P052_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-          if ((errorcode == 0) && (P052_data->modbus.getLastError() == 0)) {
-            success = true;
-            UserVar.setFloat(event->TaskIndex, varnr, value);
-            log += logPrefix;
-            log += value;
-          }
-        }
-        addLogMove(LOG_LEVEL_INFO, log);
-        break;
+      if ((nullptr != P052_data) && P052_data->loop()) {
+        Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + 10);
       }
+      success = true;
       break;
     }
 
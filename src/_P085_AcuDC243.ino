@@ -130,6 +130,10 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
         uint32_t reads_pass, reads_crc_failed, reads_nodata;
         P085_data->modbus.getStatistics(reads_pass, reads_crc_failed, reads_nodata);
         addHtml(strformat(F("%u/%u/%u"), reads_pass, reads_crc_failed, reads_nodata));
+        addRowLabel(F("Latency (avg/max)"));
+        uint32_t latency_avg, latency_max;
+        P085_data->modbus.getLatency(latency_avg, latency_max);
+        addHtml(strformat(F("%u/%u ms"), latency_avg, latency_max));
 
         addFormSubHeader(F("Calibration"));
 
@@ -279,13 +283,27 @@ boolean Plugin_085(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P085_data) && P085_data->isInitialized()) {
-        for (int i = 0; i < P085_NR_OUTPUT_VALUES; ++i) {
-          UserVar.setFloat(event->TaskIndex, i, p085_readValue(PCONFIG(i + P085_QUERY1_CONFIG_POS), event));
-          delay(1);
+        if (!P085_data->newValuesAvailable()) {
+          // Values are read in the background, a read is scheduled when all values are received.
+          P085_data->startRead(event);
         }
 
-        success = true;
+        if (P085_data->newValuesAvailable()) {
+          P085_data->setTaskValues(event);
+          success = true;
+        }
+      }
+      break;
+    }
+
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P085_data_struct *P085_data =
+        static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != P085_data) && P085_data->loop()) {
+        Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + 10);
       }
+      success = true;
       break;
     }
 # if FEATURE_PACKED_RAW_DATA
@@ -138,6 +138,10 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
         uint32_t reads_pass, reads_crc_failed, reads_nodata;
         P108_data->modbus.getStatistics(reads_pass, reads_crc_failed, reads_nodata);
         addHtml(strformat(F("%d/%d/%d"), reads_pass, reads_crc_failed, reads_nodata));
+        addRowLabel(F("Latency (avg/max)"));
+        uint32_t latency_avg, latency_max;
+        P108_data->modbus.getLatency(latency_avg, latency_max);
+        addHtml(strformat(F("%u/%u ms"), latency_avg, latency_max));
 
         addFormSubHeader(F("Logged Values"));
         p108_showValueLoadPage(P108_QUERY_Wh_imp, event);
@@ -234,13 +238,27 @@ boolean Plugin_108(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P108_data) && P108_data->isInitialized()) {
-        for (int i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
-          UserVar.setFloat(event->TaskIndex, i, p108_readValue(PCONFIG(i + P108_QUERY1_CONFIG_POS), event));
-          delay(1);
+        if (!P108_data->newValuesAvailable()) {
+          // Values are read in the background, a read is scheduled when all values are received.
+          P108_data->startRead(event);
         }
 
-        success = true;
+        if (P108_data->newValuesAvailable()) {
+          P108_data->setTaskValues(event);
+          success = true;
+        }
+      }
+      break;
+    }
+
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P108_data_struct *P108_data =
+        static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != P108_data) && P108_data->loop()) {
+        Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + 10);
       }
+      success = true;
       break;
     }
 
@@ -9,6 +9,7 @@
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/Serial.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/Settings.h"
 
@@ -36,6 +37,10 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 	if (HasArgv(Line, 2)) {
 	  Settings.Unit = event->Par1;
 	  update_mDNS();
+	  #if FEATURE_MQTT
+	  // Cached MQTT topics may contain the unit number
+	  Cache.mqttTopics.clear();
+	  #endif // if FEATURE_MQTT
 	} else {
       return return_result(event, concat(F("Unit:"), static_cast<int>(Settings.Unit)));
 	}
@@ -44,6 +49,12 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 
 String Command_Settings_Name(struct EventStruct *event, const char* Line)
 {
+	#if FEATURE_MQTT
+	if (HasArgv(Line, 2)) {
+	  // Cached MQTT topics may contain the system name
+	  Cache.mqttTopics.clear();
+	}
+	#endif // if FEATURE_MQTT
 	return Command_GetORSetString(event, F("Name:"),
 							Line,
 							Settings.Name,
@@ -34,7 +34,7 @@ C016_queue_element::C016_queue_element(const struct EventStruct *event, uint8_t
   _controller_idx = event->ControllerIndex;
   _taskIndex      = event->TaskIndex;
   values.clear();
-  const TaskValues_Data_t* data = UserVar.getRawTaskValues_Data(event->TaskIndex);
+  const TaskValues_Data_t* data = static_cast<const UserVarStruct&>(UserVar).getRawTaskValues_Data(event->TaskIndex);
 
   if (data != nullptr) {
     for (uint8_t i = 0; i < value_count; ++i) {
@@ -1,5 +1,21 @@
 #include "../ControllerQueue/ControllerDelayHandlerStruct.h"
 
+#if FEATURE_EXTENDED_METRICS
+ControllerQueueStats controllerQueueStats[CONTROLLER_MAX];
+
+const __FlashStringHelper* getControllerQueueCounterName(ControllerQueueCounter counter) {
+  switch (counter) {
+    case ControllerQueueCounter::Enqueued:    return F("enqueued");
+    case ControllerQueueCounter::Duplicate:   return F("duplicates");
+    case ControllerQueueCounter::Dropped:     return F("dropped");
+    case ControllerQueueCounter::Removed:     return F("removed");
+    case ControllerQueueCounter::Retry:       return F("retries");
+    case ControllerQueueCounter::Sent:        return F("sent");
+    case ControllerQueueCounter::NR_ELEMENTS: break;
+  }
+  return F("unknown");
+}
+#endif // if FEATURE_EXTENDED_METRICS
 
 ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   lastSend(0),
@@ -8,6 +24,7 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   max_queue_depth(CONTROLLER_DELAY_QUEUE_DEPTH_DFLT),
   attempt(0),
   max_retries(CONTROLLER_DELAY_QUEUE_RETRY_DFLT),
+  max_batch_size(1),
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
@@ -33,6 +50,7 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
   must_check_reply       = settings.MustCheckReply;
   deduplicate            = settings.deduplicate();
   useLocalSystemTime     = settings.useLocalSystemTime();
+  max_batch_size         = settings.maxBatchSize();
 
   if (settings.allowExpire()) {
     expire_timeout = max_queue_depth * max_retries * (minTimeBetweenMessages + settings.ClientTimeout);
@@ -53,6 +71,10 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
 
   // No less than 10 msec between messages.
   if (minTimeBetweenMessages < 10) { minTimeBetweenMessages = 10; }
+
+  // One extra, as a new element is allocated before the oldest is removed from a full queue.
+  elementPool.setCapacity(max_queue_depth + 1);
+  nodePool.setCapacity(max_queue_depth + 1);
 }
 
 bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& element) const {
@@ -102,7 +124,13 @@ bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) c
     log += getQueueMemorySize();
     log += F(" bytes ");
     log += sendQueue.size();
-    log += F(" items ");
+    log += F(" items, pool: ");
+    log += elementPool.getUsed();
+    log += '/';
+    log += elementPool.getCapacity();
+    log += F(" (");
+    log += elementPool.getFallbackCount();
+    log += F(" on heap) ");
     log += freeHeap;
     log += F(" free");
     addLogMove(LOG_LEVEL_DEBUG, log);
@@ -150,16 +178,20 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (!element) { 
     return false;
   }
+  const controllerIndex_t controller_idx = element->_controller_idx;
+
   if (isDuplicate(*element)) {
+    countQueueEvent(controller_idx, ControllerQueueCounter::Duplicate);
     return true;
   }
 
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-    while (queueFull(element->_controller_idx)) {
+    while (queueFull(controller_idx)) {
       sendQueue.pop_front();
       attempt = 0;
+      countQueueEvent(controller_idx, ControllerQueueCounter::Removed);
     }
   }
 
@@ -170,9 +202,11 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
     #endif // ifdef USE_SECOND_HEAP
 
     sendQueue.push_back(std::move(element));
+    countQueueEvent(controller_idx, ControllerQueueCounter::Enqueued);
 
     return true;
   }
+  countQueueEvent(controller_idx, ControllerQueueCounter::Dropped);
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -189,8 +223,10 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
   if (sendQueue.empty()) { return nullptr; }
 
   if (attempt > max_retries) {
+    const controllerIndex_t controller_idx = sendQueue.front() ? sendQueue.front()->_controller_idx : INVALID_CONTROLLER_INDEX;
     sendQueue.pop_front();
     attempt = 0;
+    countQueueEvent(controller_idx, ControllerQueueCounter::Removed);
   }
 
   if (expire_timeout != 0) {
@@ -200,8 +236,10 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
       if ((sendQueue.front().get() != nullptr) && (timePassedSince(sendQueue.front()->_timestamp) < static_cast<long>(expire_timeout))) {
         done = true;
       } else {
+        const controllerIndex_t controller_idx = sendQueue.front() ? sendQueue.front()->_controller_idx : INVALID_CONTROLLER_INDEX;
         sendQueue.pop_front();
         attempt = 0;
+        countQueueEvent(controller_idx, ControllerQueueCounter::Removed);
       }
     }
   }
@@ -215,13 +253,38 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
 // @param remove_from_queue indicates whether the elements should be removed from the queue.
 unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue) {
   if (sendQueue.empty()) { return 0; }
+  const controllerIndex_t controller_idx = sendQueue.front() ? sendQueue.front()->_controller_idx : INVALID_CONTROLLER_INDEX;
 
   if (remove_from_queue) {
     sendQueue.pop_front();
     attempt  = 0;
     lastSend = millis();
+    countQueueEvent(controller_idx, ControllerQueueCounter::Sent);
   } else {
     ++attempt;
+    countQueueEvent(controller_idx, ControllerQueueCounter::Retry);
+  }
+  return getNextScheduleTime();
+}
+
+unsigned long ControllerDelayHandlerStruct::markBatchProcessed(size_t nrProcessed) {
+  if (sendQueue.empty()) { return 0; }
+  const controllerIndex_t controller_idx = sendQueue.front() ? sendQueue.front()->_controller_idx : INVALID_CONTROLLER_INDEX;
+
+  if (nrProcessed == 0) {
+    ++attempt;
+    countQueueEvent(controller_idx, ControllerQueueCounter::Retry);
+  } else {
+    size_t nrSent = 0;
+
+    while (nrProcessed > 0 && !sendQueue.empty()) {
+      sendQueue.pop_front();
+      --nrProcessed;
+      ++nrSent;
+    }
+    attempt  = 0;
+    lastSend = millis();
+    countQueueEvent(controller_idx, ControllerQueueCounter::Sent, nrSent);
   }
   return getNextScheduleTime();
 }
@@ -254,6 +317,10 @@ size_t ControllerDelayHandlerStruct::getQueueMemorySize() const {
       totalSize += it->get()->getSize();
     }
   }
+
+  // Elements are already counted, only add the unused slots of the element pool
+  totalSize += elementPool.getFreeMemorySize();
+  totalSize += nodePool.getMemorySize();
   return totalSize;
 }
 
@@ -274,7 +341,12 @@ void ControllerDelayHandlerStruct::process(
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
       START_TIMER;
-      markProcessed(func(cpluginID, *element, *ControllerSettings));
+
+      if ((batch_func != nullptr) && (max_batch_size > 1)) {
+        markBatchProcessed(processBatch(cpluginID, *ControllerSettings));
+      } else {
+        markProcessed(func(cpluginID, *element, *ControllerSettings));
+      }
       #if FEATURE_TIMING_STATS
       STOP_TIMER_VAR(timerstats_id);
       #endif
@@ -282,3 +354,60 @@ void ControllerDelayHandlerStruct::process(
   }
   Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
 }
+
+size_t ControllerDelayHandlerStruct::processBatch(
+  cpluginID_t               cpluginID,
+  ControllerSettingsStruct& ControllerSettings)
+{
+  // Keep the allocated capacity, to prevent heap fragmentation.
+  batch.clear();
+
+  if (batch.capacity() < max_batch_size) {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+    batch.reserve(max_batch_size);
+  }
+
+  for (auto it = sendQueue.begin(); it != sendQueue.end() && batch.size() < max_batch_size; ++it) {
+    if (it->get() == nullptr) {
+      break;
+    }
+    batch.push_back(it->get());
+  }
+
+  if (batch.empty()) {
+    return 0;
+  }
+  const size_t nrProcessed = batch_func(cpluginID, batch, ControllerSettings);
+
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(
+                 F("%s : Batch processed %u of %u"),
+                 get_formatted_Controller_number(cpluginID).c_str(),
+                 static_cast<unsigned>(nrProcessed),
+                 static_cast<unsigned>(batch.size())));
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  batch.clear();
+  return nrProcessed;
+}
+
+void ControllerDelayHandlerStruct::countQueueEvent(
+  controllerIndex_t      controller_idx,
+  ControllerQueueCounter counter,
+  size_t                 count)
+{
+#if FEATURE_EXTENDED_METRICS
+
+  if (!validControllerIndex(controller_idx) || (counter >= ControllerQueueCounter::NR_ELEMENTS)) {
+    return;
+  }
+  ControllerQueueStats& stats = controllerQueueStats[controller_idx];
+
+  stats.counters[static_cast<uint8_t>(counter)] += count;
+  stats.depth                                    = sendQueue.size();
+#endif // if FEATURE_EXTENDED_METRICS
+}
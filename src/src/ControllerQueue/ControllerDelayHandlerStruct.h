@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../ControllerQueue/Queue_element_base.h"
+#include "../ControllerQueue/Queue_element_pool.h"
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
@@ -23,6 +24,7 @@
 #include <list>
 #include <memory> // For std::shared_ptr
 #include <new>    // std::nothrow
+#include <vector>
 
 #ifndef CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME
   # define CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME 10000
@@ -32,6 +34,38 @@ typedef bool (*do_process_function)(cpluginID_t,
                                     const Queue_element_base&,
                                     ControllerSettingsStruct&);
 
+// Process a batch of queued elements in a single message.
+// The elements are given in queue order, starting at the front of the queue.
+// Return the number of elements (counted from the front) which can be removed from the queue.
+typedef size_t (*do_process_batch_function)(cpluginID_t,
+                                            const std::vector<const Queue_element_base *>&,
+                                            ControllerSettingsStruct&);
+
+// Events counted per controller queue.
+// Must not be excluded when FEATURE_EXTENDED_METRICS is not enabled, as it is used in the function arguments.
+enum class ControllerQueueCounter : uint8_t {
+  Enqueued,  // Added to the queue
+  Duplicate, // Not added, as it was considered a duplicate
+  Dropped,   // Not added, as the queue was full
+  Removed,   // Removed without being sent: oldest of a full queue, max retries reached or expired
+  Retry,     // Failed attempt to process
+  Sent,      // Removed from the queue after being processed
+
+  NR_ELEMENTS
+};
+
+#if FEATURE_EXTENDED_METRICS
+const __FlashStringHelper* getControllerQueueCounterName(ControllerQueueCounter counter);
+
+// Queue statistics per controller, exported on the /metrics page.
+struct ControllerQueueStats {
+  uint32_t counters[static_cast<uint8_t>(ControllerQueueCounter::NR_ELEMENTS)] = {};
+  uint8_t  depth                                                               = 0;
+};
+
+extern ControllerQueueStats controllerQueueStats[CONTROLLER_MAX];
+#endif // if FEATURE_EXTENDED_METRICS
+
 /*********************************************************************************************\
 * ControllerDelayHandlerStruct
 \*********************************************************************************************/
@@ -61,6 +95,10 @@ struct ControllerDelayHandlerStruct {
   // @param remove_from_queue indicates whether the elements should be removed from the queue.
   unsigned long markProcessed(bool remove_from_queue);
 
+  // Same as markProcessed, for when a batch of elements was processed.
+  // @param nrProcessed the number of elements to remove from the front of the queue, 0 means a failed attempt.
+  unsigned long markBatchProcessed(size_t nrProcessed);
+
   unsigned long getNextScheduleTime() const;
 
   // Set the "lastSend" to "now" + some additional delay.
@@ -68,6 +106,7 @@ struct ControllerDelayHandlerStruct {
   // msecFromNow + minTimeBetweenMessages
   void   setAdditionalDelay(unsigned long msecFromNow);
 
+  // Memory used by the queued elements, including the memory reserved in the pools.
   size_t getQueueMemorySize() const;
 
   void   process(
@@ -76,7 +115,28 @@ struct ControllerDelayHandlerStruct {
     TimingStatsElements                timerstats_id,
     SchedulerIntervalTimer_e timerID);
 
-  std::list<std::unique_ptr<Queue_element_base> >sendQueue;
+  // Collect up to max_batch_size elements from the front of the queue and pass them to batch_func.
+  // Return the number of elements which were processed.
+  size_t processBatch(
+    cpluginID_t               cpluginID,
+    ControllerSettingsStruct& ControllerSettings);
+
+  // Update the queue statistics of the controller, when FEATURE_EXTENDED_METRICS is enabled.
+  void countQueueEvent(controllerIndex_t      controller_idx,
+                       ControllerQueueCounter counter,
+                       size_t                 count = 1);
+
+  // Pools are used by the sendQueue, so must be declared before the sendQueue.
+  // Capacity of the pools is set from max_queue_depth.
+  Queue_element_pool                             elementPool;
+  Queue_element_pool                             nodePool;
+
+  std::list<std::unique_ptr<Queue_element_base>,
+            Queue_element_pool_allocator<std::unique_ptr<Queue_element_base> > >sendQueue {
+    Queue_element_pool_allocator<std::unique_ptr<Queue_element_base> >(nodePool)
+  };
+  std::vector<const Queue_element_base *>        batch;
+  do_process_batch_function                      batch_func             = nullptr; // Set by controllers supporting batches
   mutable UnitLastMessageCount_map               unitLastMessageCount;
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
@@ -84,6 +144,7 @@ struct ControllerDelayHandlerStruct {
   uint8_t                                        max_queue_depth        = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   uint8_t                                        attempt                = 0;
   uint8_t                                        max_retries            = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
+  uint8_t                                        max_batch_size         = 1;
   bool                                           delete_oldest          = false;
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
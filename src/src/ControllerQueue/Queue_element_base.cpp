@@ -10,3 +10,23 @@ Queue_element_base::Queue_element_base() :
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+void * Queue_element_base::operator new(size_t size, Queue_element_pool& pool) noexcept
+{
+  return pool.allocate(size);
+}
+
+void * Queue_element_base::operator new(size_t size, const std::nothrow_t& tag) noexcept
+{
+  return ::operator new(size, tag);
+}
+
+void Queue_element_base::operator delete(void *ptr, Queue_element_pool& pool) noexcept
+{
+  pool.deallocate(ptr);
+}
+
+void Queue_element_base::operator delete(void *ptr) noexcept
+{
+  Queue_element_pool::release(ptr);
+}
@@ -4,6 +4,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/Queue_element_pool.h"
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
@@ -16,6 +17,19 @@ public:
 
   virtual ~Queue_element_base();
 
+  // Elements should be allocated from the pool of the controller queue:
+  //   new (C0xx_DelayHandler->elementPool) C0xx_queue_element(...)
+  // When the pool is full, the element is allocated on the heap.
+  // Just like new (std::nothrow), this returns nullptr when allocation failed.
+  static void* operator new(size_t              size,
+                            Queue_element_pool& pool) noexcept;
+  static void* operator new(size_t                size,
+                            const std::nothrow_t& tag) noexcept;
+
+  static void  operator delete(void               *ptr,
+                               Queue_element_pool& pool) noexcept;
+  static void  operator delete(void *ptr) noexcept;
+
   virtual size_t                    getSize() const = 0;
 
   virtual bool                      isDuplicate(const Queue_element_base& other) const = 0;
@@ -0,0 +1,134 @@
+#include "../ControllerQueue/Queue_element_pool.h"
+
+#include "../Helpers/Memory.h"
+
+Queue_element_pool *Queue_element_pool::_first = nullptr;
+
+Queue_element_pool::Queue_element_pool()
+{
+  _next  = _first;
+  _first = this;
+}
+
+Queue_element_pool::~Queue_element_pool()
+{
+  freeSlab();
+
+  Queue_element_pool **it = &_first;
+
+  while (*it != nullptr) {
+    if (*it == this) {
+      *it = _next;
+      return;
+    }
+    it = &((*it)->_next);
+  }
+}
+
+void Queue_element_pool::setCapacity(uint8_t nrSlots)
+{
+  if (nrSlots >= QUEUE_ELEMENT_POOL_NO_SLOT) {
+    nrSlots = QUEUE_ELEMENT_POOL_NO_SLOT - 1;
+  }
+  _wantedSlots = nrSlots;
+}
+
+void * Queue_element_pool::allocate(size_t size)
+{
+  // Keep slots aligned for any type stored in the queue elements
+  const size_t slotSize = (size + 7) & ~static_cast<size_t>(7);
+
+  if ((_used == 0) && ((_slab == nullptr) || (_nrSlots != _wantedSlots) || (slotSize > _slotSize))) {
+    if ((_slab != nullptr) && (slotSize < _slotSize)) {
+      // Keep the larger slot size, the pool may be used for different objects
+      initSlab(_slotSize);
+    } else {
+      initSlab(slotSize);
+    }
+  }
+
+  if ((_freeHead != QUEUE_ELEMENT_POOL_NO_SLOT) && (slotSize <= _slotSize)) {
+    uint8_t *slot = _slab + (_freeHead * _slotSize);
+    _freeHead = *slot;
+    ++_used;
+    return slot;
+  }
+  ++_fallbackCount;
+  return ::operator new(size, std::nothrow);
+}
+
+void Queue_element_pool::deallocate(void *ptr)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  if (!contains(ptr)) {
+    ::operator delete(ptr);
+    return;
+  }
+  uint8_t *slot = static_cast<uint8_t *>(ptr);
+
+  *slot     = _freeHead;
+  _freeHead = (slot - _slab) / _slotSize;
+  --_used;
+}
+
+void Queue_element_pool::release(void *ptr)
+{
+  for (Queue_element_pool *pool = _first; pool != nullptr; pool = pool->_next) {
+    if (pool->contains(ptr)) {
+      pool->deallocate(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+bool Queue_element_pool::contains(const void *ptr) const
+{
+  const uint8_t *p = static_cast<const uint8_t *>(ptr);
+
+  return _slab != nullptr && p >= _slab && p < (_slab + getMemorySize());
+}
+
+bool Queue_element_pool::initSlab(size_t slotSize)
+{
+  freeSlab();
+
+  if (_wantedSlots == 0) {
+    return false;
+  }
+  {
+    #ifdef USE_SECOND_HEAP
+
+    // Do not store in 2nd heap, the queue elements have never been allocated there
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+    _slab = static_cast<uint8_t *>(malloc(_wantedSlots * slotSize));
+  }
+
+  if (_slab == nullptr) {
+    return false;
+  }
+  _slotSize = slotSize;
+  _nrSlots  = _wantedSlots;
+
+  for (uint8_t i = 0; i < _nrSlots; ++i) {
+    _slab[i * _slotSize] = (i + 1 < _nrSlots) ? i + 1 : QUEUE_ELEMENT_POOL_NO_SLOT;
+  }
+  _freeHead = 0;
+  return true;
+}
+
+void Queue_element_pool::freeSlab()
+{
+  if (_slab != nullptr) {
+    free(_slab);
+    _slab = nullptr;
+  }
+  _slotSize = 0;
+  _nrSlots  = 0;
+  _used     = 0;
+  _freeHead = QUEUE_ELEMENT_POOL_NO_SLOT;
+}
@@ -0,0 +1,126 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include <new>
+
+// Slot index which marks the end of the free list, also limits the number of slots
+#define QUEUE_ELEMENT_POOL_NO_SLOT  255
+
+/*********************************************************************************************\
+* Queue_element_pool
+* Fixed size slab of equally sized slots, used by a controller queue to store its
+* elements and list nodes without allocating and freeing them on the heap for every message.
+*
+* The slab is allocated on first use, with the (aligned) size of the first allocated object.
+* When the pool is full, or an object does not fit in a slot, memory is taken from the heap.
+* The number of slots is only changed when all slots are free.
+\*********************************************************************************************/
+class Queue_element_pool {
+public:
+
+  Queue_element_pool();
+
+  ~Queue_element_pool();
+
+  Queue_element_pool(const Queue_element_pool& other)            = delete;
+  Queue_element_pool& operator=(const Queue_element_pool& other) = delete;
+
+  // Set the number of slots, will be applied when all slots are free.
+  void         setCapacity(uint8_t nrSlots);
+
+  void       * allocate(size_t size);
+
+  void         deallocate(void *ptr);
+
+  // Return the memory to the pool it was allocated from, or to the heap.
+  static void  release(void *ptr);
+
+  bool         contains(const void *ptr) const;
+
+  uint8_t      getCapacity() const {
+    return _nrSlots;
+  }
+
+  uint8_t      getUsed() const {
+    return _used;
+  }
+
+  // Number of allocations which did not fit in the pool since boot
+  uint32_t     getFallbackCount() const {
+    return _fallbackCount;
+  }
+
+  size_t       getMemorySize() const {
+    return _nrSlots * _slotSize;
+  }
+
+  size_t       getFreeMemorySize() const {
+    return (_nrSlots - _used) * _slotSize;
+  }
+
+private:
+
+  bool         initSlab(size_t slotSize);
+
+  void         freeSlab();
+
+  uint8_t            *_slab          = nullptr;
+  size_t              _slotSize      = 0;
+  uint32_t            _fallbackCount = 0;
+  uint8_t             _nrSlots       = 0;
+  uint8_t             _wantedSlots   = 0;
+  uint8_t             _used          = 0;
+  uint8_t             _freeHead      = QUEUE_ELEMENT_POOL_NO_SLOT; // Index of the first free slot, the index of the next one is stored in the slot itself
+
+  // All pools are linked, to find the pool an object was allocated from.
+  Queue_element_pool *_next = nullptr;
+
+  static Queue_element_pool *_first;
+};
+
+
+/*********************************************************************************************\
+* Allocator to let std containers take their nodes from a Queue_element_pool
+\*********************************************************************************************/
+template<class T>
+struct Queue_element_pool_allocator {
+  typedef T value_type;
+
+  explicit Queue_element_pool_allocator(Queue_element_pool& pool) noexcept : _pool(&pool) {}
+
+  template<class U>
+  Queue_element_pool_allocator(const Queue_element_pool_allocator<U>& other) noexcept : _pool(other._pool) {}
+
+  T* allocate(size_t n) {
+    if (n == 1) {
+      return static_cast<T *>(_pool->allocate(sizeof(T)));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, size_t n) noexcept {
+    if (n == 1) {
+      _pool->deallocate(ptr);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  Queue_element_pool *_pool;
+};
+
+template<class T, class U>
+bool operator==(const Queue_element_pool_allocator<T>& lhs, const Queue_element_pool_allocator<U>& rhs) {
+  return lhs._pool == rhs._pool;
+}
+
+template<class T, class U>
+bool operator!=(const Queue_element_pool_allocator<T>& lhs, const Queue_element_pool_allocator<U>& rhs) {
+  return lhs._pool != rhs._pool;
+}
+
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
@@ -153,6 +153,9 @@
 #ifndef UDP_PACKETSIZE_MAX
   #define UDP_PACKETSIZE_MAX               512 // Currently only needed for C013_Receive
 #endif
+#ifndef UDP_PACKETS_PER_CHECK
+  #define UDP_PACKETS_PER_CHECK              8 // Max. nr of ESPEasy p2p packets processed per call to checkUDP()
+#endif
 #ifndef TIMER_GRATUITOUS_ARP_MAX
   #define TIMER_GRATUITOUS_ARP_MAX           5000
 #endif
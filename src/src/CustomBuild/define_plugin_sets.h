@@ -3121,6 +3121,18 @@ To create/register a plugin, you have to :
 #define FEATURE_RULES_EASY_COLOR_CODE         0
 #endif
 
+#ifndef FEATURE_RULES_CALCULATE_COMPILED
+#define FEATURE_RULES_CALCULATE_COMPILED      0
+#endif
+
+#ifndef FEATURE_RULES_COMPILED
+#define FEATURE_RULES_COMPILED                0
+#endif
+
+#ifndef FEATURE_TASKVALUE_DEADBAND
+#define FEATURE_TASKVALUE_DEADBAND            0
+#endif
+
 
 #ifndef FEATURE_CUSTOM_PROVISIONING
 #define FEATURE_CUSTOM_PROVISIONING           0
@@ -3340,6 +3352,24 @@ To create/register a plugin, you have to :
   #define FEATURE_HTTP_CLIENT   1 // Enable because required for these controllers/features
 #endif
 
+#ifndef FEATURE_HTTP_KEEPALIVE
+  #define FEATURE_HTTP_KEEPALIVE  0 // Disable by default
+#endif
+
+#if FEATURE_HTTP_KEEPALIVE && !FEATURE_HTTP_CLIENT
+  #undef FEATURE_HTTP_KEEPALIVE
+  #define FEATURE_HTTP_KEEPALIVE  0 // Only used by HTTP controllers
+#endif
+
+#ifndef FEATURE_EXTENDED_METRICS
+  #define FEATURE_EXTENDED_METRICS  0 // Disable by default
+#endif
+
+#if FEATURE_EXTENDED_METRICS && !defined(WEBSERVER_METRICS)
+  #undef FEATURE_EXTENDED_METRICS
+  #define FEATURE_EXTENDED_METRICS  0 // Only exported on the /metrics page
+#endif
+
 #ifndef FEATURE_AUTO_DARK_MODE
   #ifdef LIMIT_BUILD_SIZE
     #define FEATURE_AUTO_DARK_MODE            0
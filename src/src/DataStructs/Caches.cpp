@@ -22,23 +22,34 @@ void Caches::clearAllButTaskCaches() {
   clearFileCaches();
   WiFi_AP_Candidates.clearCache();
   rulesHelper.closeAllFiles();
+  #if FEATURE_MQTT
+
+  // Publish topics may contain system name, unit number and task IDX
+  mqttTopics.clear();
+  #endif // if FEATURE_MQTT
 }
 
 void Caches::clearAllTaskCaches() {
-  taskIndexName.clear();
-  taskIndexValueName.clear();
+  taskNameIndex.clear();
+  extraTaskSettings_RAM.clear();
   extraTaskSettings_cache.clear();
+  #if FEATURE_MQTT
+  mqttTopics.clear();
+  #endif // if FEATURE_MQTT
   updateActiveTaskUseSerial0();
 }
 
 void Caches::clearTaskCache(taskIndex_t TaskIndex) {
-  clearTaskIndexFromMaps(TaskIndex);
+  taskNameIndex.invalidate(TaskIndex);
 
   auto it = extraTaskSettings_cache.find(TaskIndex);
 
   if (it != extraTaskSettings_cache.end()) {
     extraTaskSettings_cache.erase(it);
   }
+  #if FEATURE_MQTT
+  mqttTopics.clear(TaskIndex);
+  #endif // if FEATURE_MQTT
   updateActiveTaskUseSerial0();
 }
 
@@ -294,6 +305,57 @@ PluginStats_Config_t Caches::getPluginStatsConfig(taskIndex_t TaskIndex, taskVar
 
 #endif // if FEATURE_PLUGIN_STATS
 
+#if FEATURE_TASKVALUE_DEADBAND
+bool Caches::sendOnChange(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.sendOnChange;
+    }
+  }
+  return false;
+}
+
+uint16_t Caches::getSendOnChangeMaxSilence(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.sendOnChangeMaxSilence;
+    }
+  }
+  return 0;
+}
+
+float Caches::getDeadbandAbsolute(taskIndex_t TaskIndex, taskVarIndex_t taskVarIndex)
+{
+  if (validTaskIndex(TaskIndex) && (taskVarIndex < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.deadbandAbs[taskVarIndex];
+    }
+  }
+  return 0.0f;
+}
+
+float Caches::getDeadbandRelative(taskIndex_t TaskIndex, taskVarIndex_t taskVarIndex)
+{
+  if (validTaskIndex(TaskIndex) && (taskVarIndex < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.deadbandRel[taskVarIndex];
+    }
+  }
+  return 0.0f;
+}
+
+#endif // if FEATURE_TASKVALUE_DEADBAND
+
 
 void Caches::updateExtraTaskSettingsCache()
 {
@@ -309,9 +371,13 @@ void Caches::updateExtraTaskSettingsCache()
       tmp.md5checksum                = it->second.md5checksum;
       tmp.defaultTaskDeviceValueName = it->second.defaultTaskDeviceValueName;
 
+      if (!(tmp.md5checksum == ExtraTaskSettings.computeChecksum())) {
+        // Task settings differ from the stored ones, names may have changed.
+        taskNameIndex.invalidate(TaskIndex);
+      }
+
       // Now clear it so we can create a fresh copy.
       extraTaskSettings_cache.erase(it);
-      clearTaskIndexFromMaps(TaskIndex);
     }
     move_special(tmp.TaskDeviceName, String(ExtraTaskSettings.TaskDeviceName));
 
@@ -338,7 +404,15 @@ void Caches::updateExtraTaskSettingsCache()
 
       tmp.pluginStatsConfig[i] = ExtraTaskSettings.getPluginStatsConfig(i);
       #endif // if FEATURE_PLUGIN_STATS
+      #if FEATURE_TASKVALUE_DEADBAND
+      tmp.deadbandAbs[i] = ExtraTaskSettings.getDeadbandAbsolute(i);
+      tmp.deadbandRel[i] = ExtraTaskSettings.getDeadbandRelative(i);
+      #endif // if FEATURE_TASKVALUE_DEADBAND
     }
+    #if FEATURE_TASKVALUE_DEADBAND
+    tmp.sendOnChange           = ExtraTaskSettings.SendOnChange != 0;
+    tmp.sendOnChangeMaxSilence = ExtraTaskSettings.SendOnChangeMaxSilence;
+    #endif // if FEATURE_TASKVALUE_DEADBAND
     #ifdef ESP32
     tmp.TaskDevicePluginConfigLong_index_used = 0;
     tmp.TaskDevicePluginConfig_index_used     = 0;
@@ -396,33 +470,6 @@ ExtraTaskSettingsMap::const_iterator Caches::getExtraTaskSettings(taskIndex_t Ta
   return extraTaskSettings_cache.end();
 }
 
-void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
-{
-  {
-    auto it = taskIndexName.begin();
-
-    for (; it != taskIndexName.end();) {
-      if (it->second == TaskIndex) {
-        it = taskIndexName.erase(it);
-      } else {
-        ++it;
-      }
-    }
-  }
-  {
-    const String searchstr = String('#') + TaskIndex;
-    auto it                = taskIndexValueName.begin();
-
-    for (; it != taskIndexValueName.end();) {
-      if (it->first.endsWith(searchstr)) {
-        it = taskIndexValueName.erase(it);
-      } else {
-        ++it;
-      }
-    }
-  }
-}
-
   #ifdef ESP32
 bool Caches::getControllerSettings(controllerIndex_t index,  ControllerSettingsStruct& ControllerSettings) const
 {
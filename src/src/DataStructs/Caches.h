@@ -5,6 +5,11 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#include "../DataStructs/ExtraTaskSettings_RAM_cache.h"
+#include "../DataStructs/TaskNameIndex.h"
+#if FEATURE_MQTT
+# include "../DataStructs/MQTT_TopicCache.h"
+#endif // if FEATURE_MQTT
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
 # include "../DataTypes/ControllerIndex.h"
@@ -51,10 +56,14 @@ struct ExtraTaskSettings_cache_t {
   PluginStats_Config_t pluginStatsConfig[VARS_PER_TASK] = {};
   #endif // if FEATURE_PLUGIN_STATS
   uint8_t hasFormula = 0; // Bitmap which task value has formula and whether a formula needs previous value
+  #if FEATURE_TASKVALUE_DEADBAND
+  float    deadbandAbs[VARS_PER_TASK] = {};
+  float    deadbandRel[VARS_PER_TASK] = {};
+  uint16_t sendOnChangeMaxSilence{};
+  bool     sendOnChange{};
+  #endif // if FEATURE_TASKVALUE_DEADBAND
 };
 
-typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
-typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
 typedef std::map<String, uint8_t>                        FilePresenceMap;
 typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
 
@@ -108,6 +117,18 @@ struct Caches {
 
   #endif // if FEATURE_PLUGIN_STATS
 
+  #if FEATURE_TASKVALUE_DEADBAND
+  bool     sendOnChange(taskIndex_t TaskIndex);
+
+  uint16_t getSendOnChangeMaxSilence(taskIndex_t TaskIndex);
+
+  float    getDeadbandAbsolute(taskIndex_t    TaskIndex,
+                               taskVarIndex_t taskVarIndex);
+
+  float    getDeadbandRelative(taskIndex_t    TaskIndex,
+                               taskVarIndex_t taskVarIndex);
+  #endif // if FEATURE_TASKVALUE_DEADBAND
+
 
   // Update all cached values, except the checksum.
   void updateExtraTaskSettingsCache();
@@ -131,14 +152,17 @@ private:
 
   ExtraTaskSettingsMap::const_iterator getExtraTaskSettings(taskIndex_t TaskIndex);
 
-  void                                 clearTaskIndexFromMaps(taskIndex_t TaskIndex);
-
 public:
 
-  TaskIndexNameMap      taskIndexName;
-  TaskIndexValueNameMap taskIndexValueName;
+  TaskNameIndex         taskNameIndex;
+
+  // Only to be updated from LoadTaskSettings() or SaveTaskSettings()
+  ExtraTaskSettings_RAM_cache extraTaskSettings_RAM;
   FilePresenceMap       fileExistsMap;  // Filesize. -1 if not present
   RulesHelperClass      rulesHelper;
+  #if FEATURE_MQTT
+  MQTT_TopicCache       mqttTopics;
+  #endif // if FEATURE_MQTT
 
 private:
 
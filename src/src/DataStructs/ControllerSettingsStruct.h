@@ -46,6 +46,10 @@
 # define CONTROLLER_DELAY_QUEUE_RETRY_DFLT  10
 #endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
 
+// Max. number of queued messages a controller may send in a single batch.
+// Stored in 4 bits, so cannot be larger than 15.
+#define CONTROLLER_DELAY_QUEUE_BATCH_MAX    15
+
 // Timeout of the client in msec.
 #ifndef CONTROLLER_CLIENTTIMEOUT_MAX
 # define CONTROLLER_CLIENTTIMEOUT_MAX     4000 // Not sure if this may trigger SW watchdog.
@@ -91,8 +95,12 @@ struct ControllerSettingsStruct
     CONTROLLER_FULL_QUEUE_ACTION,
     CONTROLLER_ALLOW_EXPIRE,
     CONTROLLER_DEDUPLICATE,
+    CONTROLLER_MAX_BATCH_SIZE,
     CONTROLLER_USE_LOCAL_SYSTEM_TIME,
     CONTROLLER_CHECK_REPLY,
+#if FEATURE_HTTP_KEEPALIVE
+    CONTROLLER_HTTP_KEEP_ALIVE,
+#endif
     CONTROLLER_CLIENT_ID,
 #if FEATURE_MQTT
     CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT,
@@ -179,6 +187,13 @@ struct ControllerSettingsStruct
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
+  // Stored value 0 (default) means: no batches, thus 1 element per message.
+  uint8_t      maxBatchSize() const { return VariousBits1.maxBatchSize == 0 ? 1 : VariousBits1.maxBatchSize; }
+  void         maxBatchSize(uint8_t value) { VariousBits1.maxBatchSize = value > CONTROLLER_DELAY_QUEUE_BATCH_MAX ? CONTROLLER_DELAY_QUEUE_BATCH_MAX : value; }
+
+  bool         httpKeepAlive() const { return VariousBits1.httpKeepAlive; }
+  void         httpKeepAlive(bool value) { VariousBits1.httpKeepAlive = value; }
+
 #if FEATURE_MQTT_TLS
   TLS_types TLStype() const { return static_cast<TLS_types>(VariousBits1.TLStype); }
   void      TLStype(TLS_types tls_type) { VariousBits1.TLStype = static_cast<uint8_t>(tls_type); }
@@ -223,11 +238,8 @@ struct ControllerSettingsStruct
     uint32_t deduplicate                      : 1; // Bit 10
     uint32_t useLocalSystemTime               : 1; // Bit 11
     uint32_t TLStype                          : 4; // Bit 12...15: TLS type
-    uint32_t unused_16                        : 1; // Bit 16
-    uint32_t unused_17                        : 1; // Bit 17
-    uint32_t unused_18                        : 1; // Bit 18
-    uint32_t unused_19                        : 1; // Bit 19
-    uint32_t unused_20                        : 1; // Bit 20
+    uint32_t maxBatchSize                     : 4; // Bit 16...19: Max. number of queued messages sent in one batch
+    uint32_t httpKeepAlive                    : 1; // Bit 20
     uint32_t unused_21                        : 1; // Bit 21
     uint32_t unused_22                        : 1; // Bit 22
     uint32_t unused_23                        : 1; // Bit 23
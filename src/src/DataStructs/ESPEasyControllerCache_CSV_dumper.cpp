@@ -132,7 +132,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
 
   // Fetch samples from Cache Controller bin files.
   if (_element_processed) {
-    if (!C016_getTaskSample(_element)) {
+    if (!getNextSample()) {
       return !_outputLine.line.isEmpty();
     }
     _outputLine.markEnd();
@@ -204,7 +204,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
       ++csv_values_left;
     }
     _outputLine.markEnd();
-    _element_processed = !C016_getTaskSample(_element);
+    _element_processed = !getNextSample();
   }
 
   if (csv_values_left > 0) {
@@ -219,6 +219,27 @@ void ESPEasyControllerCache_CSV_dumper::setPeekFilePos(int peekFileNr, int peekR
   _element_processed = true;
 }
 
+bool ESPEasyControllerCache_CSV_dumper::setTimeRange(uint32_t startTime, uint32_t endTime)
+{
+  _endTime = endTime;
+
+  if (startTime != 0) {
+    if (!C016_seekTaskSample(startTime)) {
+      return false;
+    }
+    _element_processed = true;
+  }
+  return true;
+}
+
+bool ESPEasyControllerCache_CSV_dumper::getNextSample()
+{
+  if (!C016_getTaskSample(_element)) {
+    return false;
+  }
+  return (_endTime == 0) || (static_cast<uint32_t>(_element.unixTime) <= _endTime);
+}
+
 void ESPEasyControllerCache_CSV_dumper::flushValuesLeft(uint32_t csv_values_left)
 {
   if (_joinTimestamp) {
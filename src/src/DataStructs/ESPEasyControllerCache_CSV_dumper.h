@@ -51,6 +51,11 @@ struct ESPEasyControllerCache_CSV_dumper {
   void setPeekFilePos(int peekFileNr,
                       int peekReadPos);
 
+  // Only output samples with a timestamp in [startTime ... endTime], 0 = no limit.
+  // Return false when there is no sample at or after startTime.
+  bool setTimeRange(uint32_t startTime,
+                    uint32_t endTime);
+
 private:
 
   uint32_t writeToTarget(const String& str,
@@ -61,11 +66,14 @@ private:
 
   void     flushValuesLeft(uint32_t csv_values_left);
 
+  bool     getNextSample();
+
   String  _csv_values[VARS_PER_TASK * TASKS_MAX];
   uint8_t _nrDecimals[VARS_PER_TASK * TASKS_MAX] = { 0 };
   bool    _includeTask[TASKS_MAX]                = { 0 };
   bool    _joinTimestamp                         = true;
   bool    _onlySetTasks                          = true;
+  uint32_t _endTime                              = 0;
   char    _separator                             = ',';
 
   C016_binary_element                _element;
@@ -0,0 +1,566 @@
+#include "../DataStructs/ESPEasyControllerCache_file.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../DataTypes/SensorVType.h"
+# include "../Globals/Cache.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+
+static_assert(sizeof(ESPEasyControllerCache_block_header) == 24, "Changed size of cache block header");
+static_assert(TASKS_MAX <= 32,                                   "Task mask of the cache block header uses uint32_t");
+
+// Flags per sample
+# define CACHE_SAMPLE_VALUECOUNT_MASK  0x07
+# define CACHE_SAMPLE_DESCRIPTOR       0x08
+# define CACHE_SAMPLE_RAW_VALUES       0x10
+
+// Max. nr of decimals to quantize values, more will be stored raw.
+# define CACHE_MAX_QUANTIZE_DECIMALS   6
+
+namespace {
+const double powers_of_10[CACHE_MAX_QUANTIZE_DECIMALS + 1] = { 1.0, 10.0, 100.0, 1e3, 1e4, 1e5, 1e6 };
+
+// Per task state, needed for delta encoding within a block
+struct CacheTaskState {
+  taskIndex_t  taskIndex  = INVALID_TASK_INDEX;
+  pluginID_t   pluginID   = INVALID_PLUGIN_ID;
+  Sensor_VType sensorType = Sensor_VType::SENSOR_TYPE_NONE;
+  uint8_t      valueCount = 0;
+  uint8_t      decimals[VARS_PER_TASK]{};
+  int32_t      prev[VARS_PER_TASK]{};
+};
+
+CacheTaskState* getTaskState(std::vector<CacheTaskState>& states, taskIndex_t taskIndex)
+{
+  for (auto it = states.begin(); it != states.end(); ++it) {
+    if (it->taskIndex == taskIndex) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+uint64_t zigzagEncode(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void appendVarint(std::vector<uint8_t>& block, uint64_t value)
+{
+  while (value >= 0x80) {
+    block.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  block.push_back(static_cast<uint8_t>(value));
+}
+
+struct PayloadReader {
+  PayloadReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+  bool readByte(uint8_t& value) {
+    if (_pos >= _size) { return false; }
+    value = _data[_pos++];
+    return true;
+  }
+
+  bool readBytes(uint8_t *dest, size_t nrBytes) {
+    if ((_pos + nrBytes) > _size) { return false; }
+    memcpy(dest, _data + _pos, nrBytes);
+    _pos += nrBytes;
+    return true;
+  }
+
+  bool readVarint(uint64_t& value) {
+    value = 0;
+
+    for (uint8_t shift = 0; shift < 64; shift += 7) {
+      uint8_t c;
+
+      if (!readByte(c)) { return false; }
+      value |= static_cast<uint64_t>(c & 0x7F) << shift;
+
+      if ((c & 0x80) == 0) { return true; }
+    }
+    return false;
+  }
+
+  bool atEnd() const {
+    return _pos == _size;
+  }
+
+  const uint8_t *_data;
+  size_t         _size;
+  size_t         _pos = 0;
+};
+
+// Convert all values to integers suitable for delta encoding, return false when not possible.
+// Float values are quantized using the nr of decimals, 32-bit integer values are kept as-is.
+bool getDeltaEncodeValues(const C016_binary_element& element, const uint8_t *decimals, uint8_t valueCount, int32_t *quantized)
+{
+  if (!isFloatOutputDataType(element.sensorType)) {
+    if (!is32bitOutputDataType(element.sensorType)) {
+      return false;
+    }
+
+    for (uint8_t i = 0; i < valueCount; ++i) {
+      quantized[i] = element.values.getInt32(i);
+    }
+    return true;
+  }
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    if (decimals[i] > CACHE_MAX_QUANTIZE_DECIMALS) {
+      return false;
+    }
+    const float value = element.values.getFloat(i);
+
+    if (!isfinite(value)) {
+      return false;
+    }
+    const double scaled = static_cast<double>(value) * powers_of_10[decimals[i]];
+
+    if ((scaled >= 2147483647.0) || (scaled <= -2147483647.0)) {
+      return false;
+    }
+    quantized[i] = static_cast<int32_t>(lround(scaled));
+  }
+  return true;
+}
+} // namespace
+
+bool ESPEasyControllerCache_block_header::isValid() const
+{
+  return magic == CACHE_BLOCK_MAGIC &&
+         version == CACHE_BLOCK_VERSION &&
+         nrSamples != 0;
+}
+
+bool ESPEasyControllerCache_file::open(const String& fname)
+{
+  close();
+  _file = tryOpenFile(fname, F("r"));
+
+  if (!_file) {
+    return false;
+  }
+
+  // Empty files will only be appended with blocks
+  _compact = true;
+
+  if (_file.size() != 0) {
+    uint32_t magic = 0;
+    _compact = (_file.read(reinterpret_cast<uint8_t *>(&magic), sizeof(magic)) == sizeof(magic)) &&
+               (magic == CACHE_BLOCK_MAGIC);
+    _file.seek(0);
+  }
+  return true;
+}
+
+void ESPEasyControllerCache_file::close()
+{
+  if (_file) {
+    _file.close();
+  }
+  _compact          = false;
+  _pos              = 0;
+  _blockFirstSample = 0;
+  _cursor           = HeaderCursor();
+  _scanned          = HeaderCursor();
+  _scannedFileSize  = 0;
+  _samples.clear();
+}
+
+size_t ESPEasyControllerCache_file::size() const
+{
+  if (!_file) {
+    return 0;
+  }
+
+  if (!_compact) {
+    return _file.size();
+  }
+  const size_t fileSize = _file.size();
+
+  if (fileSize != _scannedFileSize) {
+    // Only count the samples in the blocks appended since the last call
+    _scannedFileSize = fileSize;
+    ESPEasyControllerCache_block_header header;
+
+    while (readHeader(_scanned, header)) {
+      _scanned.filePos     += sizeof(ESPEasyControllerCache_block_header) + header.payloadSize;
+      _scanned.firstSample += header.nrSamples;
+    }
+  }
+  return _scanned.firstSample * sizeof(C016_binary_element);
+}
+
+size_t ESPEasyControllerCache_file::position() const
+{
+  if (!_compact) {
+    return _file.position();
+  }
+  return _pos;
+}
+
+bool ESPEasyControllerCache_file::seek(size_t pos, fs::SeekMode mode)
+{
+  if (!_compact) {
+    return _file.seek(pos, mode);
+  }
+  const size_t fileSize = size();
+
+  if (mode == fs::SeekEnd) {
+    pos = (pos > fileSize) ? 0 : fileSize - pos;
+  } else if (mode == fs::SeekCur) {
+    pos += _pos;
+  }
+
+  if (pos > fileSize) {
+    return false;
+  }
+  _pos = pos;
+  return true;
+}
+
+size_t ESPEasyControllerCache_file::read(uint8_t *data, size_t size)
+{
+  if (!_compact) {
+    return _file.read(data, size);
+  }
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  size_t bytesRead             = 0;
+
+  while (bytesRead < size) {
+    const size_t sampleNr = _pos / elementSize;
+
+    if ((sampleNr < _blockFirstSample) ||
+        (sampleNr >= (_blockFirstSample + _samples.size()))) {
+      if (!loadBlock(sampleNr)) {
+        break;
+      }
+    }
+    const size_t offset = _pos % elementSize;
+    size_t nrBytes      = elementSize - offset;
+
+    if (nrBytes > (size - bytesRead)) {
+      nrBytes = size - bytesRead;
+    }
+    memcpy(data + bytesRead,
+           reinterpret_cast<const uint8_t *>(&_samples[sampleNr - _blockFirstSample]) + offset,
+           nrBytes);
+    bytesRead += nrBytes;
+    _pos      += nrBytes;
+  }
+  return bytesRead;
+}
+
+bool ESPEasyControllerCache_file::getBlockInfo(size_t pos, BlockInfo& info) const
+{
+  if (!_compact) {
+    return false;
+  }
+  HeaderCursor cursor;
+  ESPEasyControllerCache_block_header header;
+
+  if (!findBlock(pos / sizeof(C016_binary_element), cursor, header)) {
+    return false;
+  }
+  info.firstTimestamp = header.firstTimestamp;
+  info.lastTimestamp  = header.lastTimestamp;
+  info.taskMask       = header.taskMask;
+  info.pos            = cursor.firstSample * sizeof(C016_binary_element);
+  info.nrSamples      = header.nrSamples;
+  return true;
+}
+
+bool ESPEasyControllerCache_file::canAppendBlock(const String& fname)
+{
+  if (!fileExists(fname)) {
+    return true;
+  }
+  ESPEasyControllerCache_file file;
+
+  if (!file.open(fname)) {
+    return false;
+  }
+  bool res = false;
+
+  if (file.isCompact()) {
+    // All blocks must be complete
+    file.size();
+    res = file._scanned.filePos == file._file.size();
+  }
+  file.close();
+  return res;
+}
+
+bool ESPEasyControllerCache_file::encodeBlock(const uint8_t *data, size_t size, std::vector<uint8_t>& block)
+{
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  const size_t     nrSamples   = size / elementSize;
+
+  block.clear();
+
+  if ((data == nullptr) || (nrSamples == 0) || (nrSamples > 255)) {
+    return false;
+  }
+  ESPEasyControllerCache_block_header header;
+  header.nrSamples = nrSamples;
+
+  // Reserve the space for the header, filled in when the payload is complete.
+  block.reserve(sizeof(header) + size / 2);
+  block.resize(sizeof(header));
+
+  std::vector<CacheTaskState> states;
+  uint32_t prevTimestamp = 0;
+
+  for (size_t i = 0; i < nrSamples; ++i) {
+    C016_binary_element element;
+    memcpy(reinterpret_cast<uint8_t *>(&element), data + (i * elementSize), elementSize);
+
+    const uint32_t timestamp = element.unixTime;
+
+    if (i == 0) {
+      header.firstTimestamp = timestamp;
+      header.lastTimestamp  = timestamp;
+      prevTimestamp         = timestamp;
+    }
+
+    if (timestamp > header.lastTimestamp) {
+      header.lastTimestamp = timestamp;
+    }
+    appendVarint(block, zigzagEncode(static_cast<int64_t>(timestamp) - prevTimestamp));
+    prevTimestamp = timestamp;
+
+    if (validTaskIndex(element.TaskIndex)) {
+      header.taskMask |= (1u << element.TaskIndex);
+    }
+
+    uint8_t valueCount = element.valueCount;
+
+    if (valueCount > VARS_PER_TASK) {
+      valueCount = VARS_PER_TASK;
+    }
+    uint8_t decimals[VARS_PER_TASK]{};
+
+    if (validTaskIndex(element.TaskIndex)) {
+      for (uint8_t v = 0; v < valueCount; ++v) {
+        decimals[v] = Cache.getTaskDeviceValueDecimals(element.TaskIndex, v);
+      }
+    }
+
+    CacheTaskState *state     = getTaskState(states, element.TaskIndex);
+    const bool newDescriptor  = (state == nullptr) ||
+                                (state->pluginID != element.pluginID) ||
+                                (state->sensorType != element.sensorType) ||
+                                (state->valueCount != valueCount) ||
+                                (memcmp(state->decimals, decimals, VARS_PER_TASK) != 0);
+
+    if (state == nullptr) {
+      states.emplace_back();
+      state            = &states.back();
+      state->taskIndex = element.TaskIndex;
+    }
+
+    if (newDescriptor) {
+      state->pluginID   = element.pluginID;
+      state->sensorType = element.sensorType;
+      state->valueCount = valueCount;
+      memcpy(state->decimals, decimals, VARS_PER_TASK);
+      memset(state->prev, 0, sizeof(state->prev));
+    }
+
+    int32_t quantized[VARS_PER_TASK]{};
+    const bool raw = !getDeltaEncodeValues(element, decimals, valueCount, quantized);
+
+    uint8_t flags = valueCount;
+
+    if (newDescriptor) { flags |= CACHE_SAMPLE_DESCRIPTOR; }
+
+    if (raw) { flags |= CACHE_SAMPLE_RAW_VALUES; }
+
+    block.push_back(element.TaskIndex);
+    block.push_back(flags);
+
+    if (newDescriptor) {
+      block.push_back(element.pluginID.value);
+      block.push_back(static_cast<uint8_t>(element.sensorType));
+
+      for (uint8_t v = 0; v < valueCount; ++v) {
+        block.push_back(decimals[v]);
+      }
+    }
+
+    if (raw) {
+      block.insert(block.end(), element.values.binary, element.values.binary + sizeof(element.values.binary));
+    } else {
+      for (uint8_t v = 0; v < valueCount; ++v) {
+        appendVarint(block, zigzagEncode(static_cast<int64_t>(quantized[v]) - state->prev[v]));
+        state->prev[v] = quantized[v];
+      }
+    }
+  }
+
+  const size_t payloadSize = block.size() - sizeof(header);
+
+  if (payloadSize > 0xFFFF) {
+    block.clear();
+    return false;
+  }
+  header.payloadSize = payloadSize;
+  header.checksum    = calc_CRC32(&block[sizeof(header)], payloadSize);
+  memcpy(&block[0], &header, sizeof(header));
+  return true;
+}
+
+bool ESPEasyControllerCache_file::readHeader(const HeaderCursor& cursor, ESPEasyControllerCache_block_header& header) const
+{
+  const size_t fileSize = _file.size();
+
+  if ((cursor.filePos + sizeof(header)) > fileSize) {
+    return false;
+  }
+
+  if (!_file.seek(cursor.filePos) ||
+      (_file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header))) {
+    return false;
+  }
+
+  // Incomplete block at the end of the file, e.g. due to a failed write, is ignored.
+  return header.isValid() &&
+         (cursor.filePos + sizeof(header) + header.payloadSize) <= fileSize;
+}
+
+bool ESPEasyControllerCache_file::findBlock(size_t sampleNr, HeaderCursor& cursor, ESPEasyControllerCache_block_header& header) const
+{
+  // Continue from the last found block when possible, as reading is mostly sequential.
+  cursor = (sampleNr >= _cursor.firstSample) ? _cursor : HeaderCursor();
+
+  while (readHeader(cursor, header)) {
+    if (sampleNr < (cursor.firstSample + header.nrSamples)) {
+      _cursor = cursor;
+      return true;
+    }
+    cursor.filePos     += sizeof(header) + header.payloadSize;
+    cursor.firstSample += header.nrSamples;
+  }
+  return false;
+}
+
+bool ESPEasyControllerCache_file::loadBlock(size_t sampleNr)
+{
+  HeaderCursor cursor;
+  ESPEasyControllerCache_block_header header;
+
+  if (!findBlock(sampleNr, cursor, header)) {
+    return false;
+  }
+  _blockFirstSample = cursor.firstSample;
+
+  std::vector<uint8_t> payload;
+  payload.resize(header.payloadSize);
+
+  const bool success = _file.read(&payload[0], header.payloadSize) == header.payloadSize &&
+                       header.checksum == calc_CRC32(&payload[0], header.payloadSize) &&
+                       decodeBlock(header, &payload[0], _samples);
+
+  if (!success) {
+    // Keep positions consistent, but make sure the samples will not be used.
+    _samples.clear();
+    _samples.resize(header.nrSamples);
+  }
+  return true;
+}
+
+bool ESPEasyControllerCache_file::decodeBlock(
+  const ESPEasyControllerCache_block_header& header,
+  const uint8_t                            *payload,
+  std::vector<C016_binary_element>         & samples)
+{
+  samples.clear();
+  samples.resize(header.nrSamples);
+
+  PayloadReader reader(payload, header.payloadSize);
+  std::vector<CacheTaskState> states;
+  uint32_t timestamp = header.firstTimestamp;
+
+  for (auto it = samples.begin(); it != samples.end(); ++it) {
+    uint64_t delta;
+    uint8_t  taskIndex, flags;
+
+    if (!reader.readVarint(delta) ||
+        !reader.readByte(taskIndex) ||
+        !reader.readByte(flags)) {
+      return false;
+    }
+    timestamp = static_cast<uint32_t>(static_cast<int64_t>(timestamp) + zigzagDecode(delta));
+
+    const uint8_t valueCount = flags & CACHE_SAMPLE_VALUECOUNT_MASK;
+
+    if (valueCount > VARS_PER_TASK) {
+      return false;
+    }
+    CacheTaskState *state = getTaskState(states, taskIndex);
+
+    if (flags & CACHE_SAMPLE_DESCRIPTOR) {
+      if (state == nullptr) {
+        states.emplace_back();
+        state            = &states.back();
+        state->taskIndex = taskIndex;
+      }
+      uint8_t pluginID, sensorType;
+
+      if (!reader.readByte(pluginID) ||
+          !reader.readByte(sensorType) ||
+          !reader.readBytes(state->decimals, valueCount)) {
+        return false;
+      }
+      state->pluginID   = pluginID_t(pluginID);
+      state->sensorType = static_cast<Sensor_VType>(sensorType);
+      state->valueCount = valueCount;
+      memset(state->prev, 0, sizeof(state->prev));
+    }
+
+    if ((state == nullptr) || (state->valueCount != valueCount)) {
+      return false;
+    }
+
+    it->unixTime   = timestamp;
+    it->TaskIndex  = taskIndex;
+    it->pluginID   = state->pluginID;
+    it->sensorType = state->sensorType;
+    it->valueCount = valueCount;
+
+    if (flags & CACHE_SAMPLE_RAW_VALUES) {
+      if (!reader.readBytes(it->values.binary, sizeof(it->values.binary))) {
+        return false;
+      }
+    } else {
+      const bool isFloat = isFloatOutputDataType(state->sensorType);
+
+      for (uint8_t v = 0; v < valueCount; ++v) {
+        if (!reader.readVarint(delta)) {
+          return false;
+        }
+        state->prev[v] = static_cast<int32_t>(static_cast<int64_t>(state->prev[v]) + zigzagDecode(delta));
+
+        if (!isFloat) {
+          it->values.setInt32(v, state->prev[v]);
+        } else if (state->decimals[v] <= CACHE_MAX_QUANTIZE_DECIMALS) {
+          it->values.setFloat(v, static_cast<float>(state->prev[v] / powers_of_10[state->decimals[v]]));
+        } else {
+          return false;
+        }
+      }
+    }
+  }
+  return reader.atEnd();
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
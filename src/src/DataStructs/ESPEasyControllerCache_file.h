@@ -0,0 +1,139 @@
+#ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILE_H
+#define DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILE_H
+
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../ControllerQueue/C016_queue_element.h"
+
+# include <FS.h>
+# include <vector>
+
+// "Compact" cache file format, stored as blocks.
+// Each flush of the RTC buffer is written as a single block:
+//  - Header (see ESPEasyControllerCache_block_header)
+//  - Per sample:
+//    - Zigzag varint: timestamp delta to the previous sample in the block
+//    - Task index
+//    - Flags: value count (bit 0..2), descriptor follows (bit 3), raw values (bit 4)
+//    - Descriptor, only when the task first appears in the block or its settings changed:
+//      pluginID, sensor type and the number of decimals per value
+//    - Values, stored as zigzag varint delta to the previous sample of the same task in the block.
+//      Float values are quantized using the task value decimals, 32-bit integer values are stored as-is.
+//      Other types and values which cannot be quantized are stored raw (16 bytes).
+//
+// Files with the old format (plain C016_binary_element records) can still be read.
+// Magic is a NaN pattern, which will not be the first value of a plain record.
+# define CACHE_BLOCK_MAGIC    0xFFC016B1
+# define CACHE_BLOCK_VERSION  1
+
+struct __attribute__((__packed__)) ESPEasyControllerCache_block_header {
+  uint32_t magic          = CACHE_BLOCK_MAGIC;
+  uint32_t firstTimestamp = 0;
+  uint32_t lastTimestamp  = 0;
+  uint32_t taskMask       = 0;
+  uint32_t checksum       = 0; // CRC32 of the payload
+  uint16_t payloadSize    = 0;
+  uint8_t  nrSamples      = 0;
+  uint8_t  version        = CACHE_BLOCK_VERSION;
+
+  bool isValid() const;
+};
+
+
+/*********************************************************************************************\
+* ESPEasyControllerCache_file
+* Read access to a cache file, regardless of its format.
+*
+* Sizes and positions are expressed as if the file contains plain C016_binary_element records.
+* Thus callers can keep using positions in multiples of sizeof(C016_binary_element),
+* while compact files are decoded one block at a time.
+\*********************************************************************************************/
+class ESPEasyControllerCache_file {
+public:
+
+  struct BlockInfo {
+    uint32_t firstTimestamp = 0;
+    uint32_t lastTimestamp  = 0;
+    uint32_t taskMask       = 0;
+    size_t   pos            = 0; // Position of the first sample of the block
+    size_t   nrSamples      = 0;
+  };
+
+  bool open(const String& fname);
+
+  void close();
+
+  explicit operator bool() const {
+    return _file ? true : false;
+  }
+
+  bool isCompact() const {
+    return _compact;
+  }
+
+  size_t size() const;
+
+  size_t position() const;
+
+  bool   seek(size_t       pos,
+              fs::SeekMode mode = fs::SeekSet);
+
+  size_t read(uint8_t *data,
+              size_t   size);
+
+  // Get the header information of the block containing position pos.
+  // Only possible on compact files.
+  bool getBlockInfo(size_t     pos,
+                    BlockInfo& info) const;
+
+  // Check whether the file is empty or a compact file without an incomplete block at the end.
+  static bool canAppendBlock(const String& fname);
+
+  // Encode a buffer of C016_binary_element records into a single block.
+  static bool encodeBlock(const uint8_t        *data,
+                          size_t                size,
+                          std::vector<uint8_t>& block);
+
+private:
+
+  struct HeaderCursor {
+    size_t filePos     = 0; // Position of the header in the file
+    size_t firstSample = 0; // Sample nr of the first sample of the block
+  };
+
+  // Read the header at the cursor position, return false when no complete block is present.
+  bool readHeader(const HeaderCursor                 & cursor,
+                  ESPEasyControllerCache_block_header& header) const;
+
+  // Position the cursor at the block containing sampleNr
+  bool findBlock(size_t                              sampleNr,
+                 HeaderCursor                      & cursor,
+                 ESPEasyControllerCache_block_header& header) const;
+
+  bool loadBlock(size_t sampleNr);
+
+  static bool decodeBlock(const ESPEasyControllerCache_block_header& header,
+                          const uint8_t                            *payload,
+                          std::vector<C016_binary_element>         & samples);
+
+  mutable fs::File _file;
+  bool             _compact = false;
+
+  // Logical read position
+  size_t _pos = 0;
+
+  // Compact file: decoded samples of the current block
+  std::vector<C016_binary_element> _samples;
+  size_t                           _blockFirstSample = 0;
+
+  mutable HeaderCursor _cursor;
+  mutable HeaderCursor _scanned; // Number of bytes in the file and nr of samples already counted
+  mutable size_t       _scannedFileSize = 0;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILE_H
@@ -0,0 +1,258 @@
+#include "../DataStructs/ESPEasyControllerCache_index.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../ESPEasyCore/ESPEasy_backgroundtasks.h"
+# include "../Globals/C016_ControllerCache.h"
+# include "../Helpers/ESPEasy_Storage.h"
+
+static_assert(TASKS_MAX <= 32, "Task mask of the controller cache index uses uint32_t");
+
+// Number of samples read at once when scanning a file
+# define CACHE_INDEX_SCAN_SAMPLES  8
+
+bool ESPEasyControllerCache_index::find(uint32_t startTime, taskIndex_t taskIndex, int& fileNr, int& readPos)
+{
+  const uint32_t taskBit = validTaskIndex(taskIndex) ? (1u << taskIndex) : 0xFFFFFFFFu;
+  bool   islast          = false;
+  int    nr              = 0;
+
+  // File number is set to the oldest cache file
+  String fname = C016_getCacheFileName(nr, islast);
+
+  // Remove summaries of files which no longer exist.
+  for (auto it = _files.begin(); it != _files.end();) {
+    if (fname.isEmpty() || (it->fileNr < nr)) {
+      it = _files.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  while (!fname.isEmpty()) {
+    ESPEasyControllerCache_file file;
+
+    if (file.open(fname)) {
+      FileSummary *summary = getSummary(nr);
+
+      if (summary == nullptr) {
+        _files.emplace_back();
+        summary         = &_files.back();
+        summary->fileNr = nr;
+      }
+
+      bool found = false;
+
+      if (updateSummary(file, *summary) &&
+          (summary->lastTimestamp >= startTime) &&
+          (summary->taskMask & taskBit)) {
+        found = findInFile(file, *summary, startTime, taskIndex, readPos);
+      }
+      file.close();
+
+      if (found) {
+        fileNr = nr;
+        return true;
+      }
+    }
+
+    if (islast) {
+      return false;
+    }
+    backgroundtasks();
+    ++nr;
+    fname = C016_getCacheFileName(nr, islast);
+  }
+  return false;
+}
+
+void ESPEasyControllerCache_index::clear()
+{
+  _files.clear();
+}
+
+bool ESPEasyControllerCache_index::updateSummary(ESPEasyControllerCache_file& file, FileSummary& summary)
+{
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  const size_t     fileSize    = file.size() - (file.size() % elementSize);
+
+  if (summary.indexedSize != 0) {
+    C016_binary_element element;
+
+    // The file may have been replaced, e.g. after all cache files were deleted.
+    if ((fileSize < summary.indexedSize) ||
+        !readElement(file, 0, element) ||
+        (static_cast<uint32_t>(element.unixTime) != summary.firstTimestamp)) {
+      const int fileNr = summary.fileNr;
+      summary        = FileSummary();
+      summary.fileNr = fileNr;
+    }
+  }
+
+  if (summary.indexedSize >= fileSize) {
+    return true;
+  }
+
+  if (file.isCompact()) {
+    // Only the block headers need to be read
+    ESPEasyControllerCache_file::BlockInfo info;
+
+    while (summary.indexedSize < fileSize) {
+      if (!file.getBlockInfo(summary.indexedSize, info)) {
+        return false;
+      }
+
+      if (summary.indexedSize == 0) {
+        summary.firstTimestamp = info.firstTimestamp;
+      }
+
+      if (info.lastTimestamp > summary.lastTimestamp) {
+        summary.lastTimestamp = info.lastTimestamp;
+      }
+      summary.taskMask   |= info.taskMask;
+      summary.indexedSize = info.pos + (info.nrSamples * elementSize);
+    }
+    return true;
+  }
+
+  if (!file.seek(summary.indexedSize)) {
+    return false;
+  }
+  C016_binary_element elements[CACHE_INDEX_SCAN_SAMPLES];
+
+  while (summary.indexedSize < fileSize) {
+    size_t nrElements = (fileSize - summary.indexedSize) / elementSize;
+
+    if (nrElements > CACHE_INDEX_SCAN_SAMPLES) {
+      nrElements = CACHE_INDEX_SCAN_SAMPLES;
+    }
+    const size_t nrBytes = nrElements * elementSize;
+
+    if (file.read(reinterpret_cast<uint8_t *>(&elements[0]), nrBytes) != nrBytes) {
+      return false;
+    }
+
+    for (size_t i = 0; i < nrElements; ++i) {
+      const uint32_t timestamp = elements[i].unixTime;
+
+      if (summary.indexedSize == 0) {
+        summary.firstTimestamp = timestamp;
+      }
+      summary.lastTimestamp = timestamp;
+
+      if (validTaskIndex(elements[i].TaskIndex)) {
+        summary.taskMask |= (1u << elements[i].TaskIndex);
+      }
+      summary.indexedSize += elementSize;
+    }
+  }
+  return true;
+}
+
+bool ESPEasyControllerCache_index::findInFile(
+  ESPEasyControllerCache_file& file,
+  const FileSummary          & summary,
+  uint32_t                     startTime,
+  taskIndex_t                  taskIndex,
+  int                        & readPos)
+{
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  const size_t     nrElements  = summary.indexedSize / elementSize;
+  C016_binary_element element;
+
+  if (file.isCompact()) {
+    // Skip blocks which end before startTime or do not contain the task
+    const uint32_t taskBit = validTaskIndex(taskIndex) ? (1u << taskIndex) : 0xFFFFFFFFu;
+    ESPEasyControllerCache_file::BlockInfo info;
+    size_t pos = 0;
+
+    while ((pos < summary.indexedSize) && file.getBlockInfo(pos, info)) {
+      pos = info.pos + (info.nrSamples * elementSize);
+
+      if ((info.lastTimestamp >= startTime) &&
+          (info.taskMask & taskBit) &&
+          findFromPos(file, info.pos, pos, startTime, taskIndex, readPos)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Binary search for the first sample with timestamp >= startTime
+  size_t low  = 0;
+  size_t high = nrElements;
+
+  if (summary.firstTimestamp < startTime) {
+    while (low < high) {
+      const size_t mid = low + (high - low) / 2;
+
+      if (!readElement(file, mid * elementSize, element)) {
+        return false;
+      }
+
+      if (static_cast<uint32_t>(element.unixTime) < startTime) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+  }
+
+  if (!validTaskIndex(taskIndex)) {
+    if (low >= nrElements) {
+      return false;
+    }
+    readPos = low * elementSize;
+    return true;
+  }
+
+  // Skip samples of other tasks
+  return findFromPos(file, low * elementSize, summary.indexedSize, startTime, taskIndex, readPos);
+}
+
+bool ESPEasyControllerCache_index::findFromPos(
+  ESPEasyControllerCache_file& file,
+  size_t                       pos,
+  size_t                       fileSize,
+  uint32_t                     startTime,
+  taskIndex_t                  taskIndex,
+  int                        & readPos)
+{
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  C016_binary_element element;
+
+  if (!file.seek(pos)) {
+    return false;
+  }
+
+  for (; (pos + elementSize) <= fileSize; pos += elementSize) {
+    if (file.read(reinterpret_cast<uint8_t *>(&element), elementSize) != elementSize) {
+      return false;
+    }
+
+    if ((static_cast<uint32_t>(element.unixTime) >= startTime) &&
+        (!validTaskIndex(taskIndex) || (element.TaskIndex == taskIndex))) {
+      readPos = pos;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ESPEasyControllerCache_index::readElement(ESPEasyControllerCache_file& file, size_t pos, C016_binary_element& element)
+{
+  return file.seek(pos) &&
+         file.read(reinterpret_cast<uint8_t *>(&element), sizeof(C016_binary_element)) == sizeof(C016_binary_element);
+}
+
+ESPEasyControllerCache_index::FileSummary * ESPEasyControllerCache_index::getSummary(int fileNr)
+{
+  for (auto it = _files.begin(); it != _files.end(); ++it) {
+    if (it->fileNr == fileNr) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
@@ -0,0 +1,77 @@
+#ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_INDEX_H
+#define DATASTRUCTS_ESPEASYCONTROLLERCACHE_INDEX_H
+
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ESPEasyControllerCache_file.h"
+
+# include <vector>
+
+/*********************************************************************************************\
+* ESPEasyControllerCache_index
+* Index of the cache files to quickly find samples for a time range.
+*
+* Per cache file only a small summary is kept in RAM: first and last timestamp and
+* a bitmask of the tasks present in the file.
+* Files are scanned once, files still being written to are only scanned for the appended part.
+* Compact files are scanned and searched using only the block headers,
+* so only the block containing the first sample of a time range needs to be decoded.
+* Files with plain records are searched using a binary search, as the records are of fixed size
+* and stored in chronological order.
+\*********************************************************************************************/
+struct ESPEasyControllerCache_index {
+  // Find the first sample with a timestamp >= startTime.
+  // When taskIndex is a valid task index, only samples of that task are considered.
+  // Return false when no such sample was found, else fileNr and readPos can be used in setPeekFilePos()
+  bool find(uint32_t    startTime,
+            taskIndex_t taskIndex,
+            int       & fileNr,
+            int       & readPos);
+
+  void clear();
+
+private:
+
+  struct FileSummary {
+    uint32_t firstTimestamp = 0;
+    uint32_t lastTimestamp  = 0;
+    uint32_t indexedSize    = 0; // Number of bytes of the file already included in this summary
+    uint32_t taskMask       = 0;
+    int      fileNr         = 0;
+  };
+
+  // Update the summary with the samples added to the file since the last update.
+  bool        updateSummary(ESPEasyControllerCache_file& file,
+                            FileSummary                & summary);
+
+  // Find the first sample in the file with timestamp >= startTime for the given task.
+  bool        findInFile(ESPEasyControllerCache_file& file,
+                         const FileSummary          & summary,
+                         uint32_t                     startTime,
+                         taskIndex_t                  taskIndex,
+                         int                        & readPos);
+
+  // Find the first sample with timestamp >= startTime for the given task, starting at file position pos.
+  static bool findFromPos(ESPEasyControllerCache_file& file,
+                          size_t                       pos,
+                          size_t                       fileSize,
+                          uint32_t                     startTime,
+                          taskIndex_t                  taskIndex,
+                          int                        & readPos);
+
+  static bool readElement(ESPEasyControllerCache_file& file,
+                          size_t                       pos,
+                          C016_binary_element        & element);
+
+  FileSummary* getSummary(int fileNr);
+
+  std::vector<FileSummary> _files;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_INDEX_H
@@ -2,53 +2,67 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/StringConverter.h"
 
 
+static_assert(EVENT_QUEUE_SIZE < 256, "Counting filter uses uint8_t counters");
+static_assert((EVENT_QUEUE_DEDUPLICATE_SIZE & (EVENT_QUEUE_DEDUPLICATE_SIZE - 1)) == 0,
+              "EVENT_QUEUE_DEDUPLICATE_SIZE must be a power of 2");
+
 
 void EventQueueStruct::add(const String& event, bool deduplicate)
 {
-  if (!deduplicate || !isDuplicate(event)) {
+  if (_records.empty()) {
     #ifdef USE_SECOND_HEAP
-    String tmp;
-    reserve_special(tmp, event.length());
-    tmp = event;
 
-    // Do not add to the list while on 2nd heap
+    // Do not allocate the queue on 2nd heap
     HeapSelectDram ephemeral;
-
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.push_back(event);
     #endif // ifdef USE_SECOND_HEAP
+    // One extra record to encode a new event, also when the queue is full.
+    _records.resize(EVENT_QUEUE_SIZE + 1);
+  }
+  EventQueueRecord& record = _records[(_head + _count) % _records.size()];
+
+  if (encode(event, record)) {
+    if (deduplicate && isDuplicate(record)) {
+      releaseRecord(record);
+      return;
+    }
+
+    if (_count < EVENT_QUEUE_SIZE) {
+      ++_dedupeCount[record._hash & (EVENT_QUEUE_DEDUPLICATE_SIZE - 1)];
+      ++_count;
+
+      if (_count > _highWatermark) {
+        _highWatermark = _count;
+      }
+      return;
+    }
+    releaseRecord(record);
+  }
+
+  ++_dropCount;
+
+  if (!_dropping) {
+    // Only log once until the queue has been emptied
+    _dropping = true;
+    addLog(LOG_LEVEL_ERROR, concat(F("Event queue full, dropped: "), event));
   }
 }
 
 void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
 {
-  String str;
-  move_special(str, String(event));
-  add(str, deduplicate);
+  add(String(event), deduplicate);
 }
 
 void EventQueueStruct::addMove(String&& event, bool deduplicate)
 {
   if (!event.length()) { return; }
-
-  if (!deduplicate || !isDuplicate(event)) {
-    #ifdef USE_SECOND_HEAP
-    String tmp;
-    move_special(tmp, std::move(event));
-
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.emplace_back(std::move(event));
-    #endif // ifdef USE_SECOND_HEAP
-  }
+  add(event, deduplicate);
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const String& eventValue)
@@ -56,14 +70,14 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const S
   if (Settings.UseRules) {
     if (eventValue.isEmpty()) {
       addMove(strformat(
-        F("%s#%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
+        F("%s#%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
         varName.c_str()));
     } else {
       addMove(strformat(
-        F("%s#%s=%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
-        varName.c_str(), 
+        F("%s#%s=%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
+        varName.c_str(),
         eventValue.c_str()));
     }
   }
@@ -92,24 +106,248 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *var
 
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  if (_count == 0) {
     return false;
   }
-  event = std::move(_eventQueue.front());
-  _eventQueue.pop_front();
+  EventQueueRecord& record = _records[_head];
+  const String    & name   = _names[record._nameId]._name;
+
+  String tmp;
+
+  switch (record._valueType) {
+    case EventQueueRecord::ValueType::None:
+      tmp = name;
+      break;
+    case EventQueueRecord::ValueType::Int:
+      tmp.reserve(name.length() + 1 + record._nrIntValues * 6);
+      tmp  = name;
+      tmp += '=';
+
+      for (uint8_t i = 0; i < record._nrIntValues; ++i) {
+        if (i != 0) {
+          tmp += ',';
+        }
+        tmp += record._intValues[i];
+      }
+      break;
+    case EventQueueRecord::ValueType::Text:
+      reserve_special(tmp, name.length() + 1 + record._textValue.length());
+      tmp  = name;
+      tmp += '=';
+      tmp += record._textValue;
+      break;
+  }
+  event = std::move(tmp);
+
+  --_dedupeCount[record._hash & (EVENT_QUEUE_DEDUPLICATE_SIZE - 1)];
+  releaseRecord(record);
+  _head = (_head + 1) % _records.size();
+  --_count;
+
+  if (_count == 0) {
+    _dropping = false;
+  }
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  _records.clear();
+  _names.clear();
+  _nameIndex.clear();
+  memset(_dedupeCount, 0, sizeof(_dedupeCount));
+  _head     = 0;
+  _count    = 0;
+  _dropping = false;
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return _count == 0;
+}
+
+bool EventQueueStruct::encode(const String& event, EventQueueRecord& record)
+{
+  const int    pos        = event.indexOf('=');
+  const size_t nameLength = (pos < 0) ? event.length() : pos;
+
+  if (!internName(event, nameLength, record._nameId)) {
+    return false;
+  }
+  record._hash = calc_FNV1a_ci(event.c_str(), event.length());
+
+  if (pos < 0) {
+    record._valueType = EventQueueRecord::ValueType::None;
+  } else if (parseIntValues(event.c_str() + pos + 1, record)) {
+    record._valueType = EventQueueRecord::ValueType::Int;
+  } else {
+    record._valueType = EventQueueRecord::ValueType::Text;
+    move_special(record._textValue, event.substring(pos + 1));
+  }
+  return true;
+}
+
+bool EventQueueStruct::isDuplicate(const EventQueueRecord& record) const
+{
+  if (_dedupeCount[record._hash & (EVENT_QUEUE_DEDUPLICATE_SIZE - 1)] == 0) {
+    return false;
+  }
+
+  for (size_t i = 0; i < _count; ++i) {
+    const EventQueueRecord& queued = _records[(_head + i) % _records.size()];
+
+    if ((queued._hash == record._hash) &&
+        (queued._nameId == record._nameId) &&
+        (queued._valueType == record._valueType)) {
+      switch (record._valueType) {
+        case EventQueueRecord::ValueType::None:
+          return true;
+        case EventQueueRecord::ValueType::Int:
+
+          if ((queued._nrIntValues == record._nrIntValues) &&
+              (memcmp(queued._intValues, record._intValues, record._nrIntValues * sizeof(int32_t)) == 0)) {
+            return true;
+          }
+          break;
+        case EventQueueRecord::ValueType::Text:
+
+          if (queued._textValue.equals(record._textValue)) {
+            return true;
+          }
+          break;
+      }
+    }
+  }
+  return false;
+}
+
+bool EventQueueStruct::internName(const String& event, size_t length, uint16_t& nameId)
+{
+  const char    *name = event.c_str();
+  const uint32_t hash = calc_FNV1a_ci(name, length);
+
+  auto matches = [&](const EventName& entry) {
+                   return entry._hash == hash &&
+                          entry._name.length() == length &&
+                          strncmp(entry._name.c_str(), name, length) == 0;
+                 };
+
+  auto it = _nameIndex.find(hash);
+
+  if ((it != _nameIndex.end()) && matches(_names[it->second])) {
+    nameId = it->second;
+    ++_names[nameId]._refCount;
+    return true;
+  }
+
+  if (it != _nameIndex.end()) {
+    // Hash collision, these names are not in the index
+    for (size_t i = 0; i < _names.size(); ++i) {
+      if (matches(_names[i])) {
+        nameId = i;
+        ++_names[nameId]._refCount;
+        return true;
+      }
+    }
+  }
+
+  // New name, keep unused names as long as possible as they are likely to be used again.
+  if (_names.size() < _records.size()) {
+    nameId = _names.size();
+    _names.emplace_back();
+  } else {
+    size_t i = 0;
+
+    while (i < _names.size() && _names[i]._refCount != 0) {
+      ++i;
+    }
+
+    if (i >= _names.size()) {
+      return false;
+    }
+    nameId = i;
+
+    auto old = _nameIndex.find(_names[nameId]._hash);
+
+    if ((old != _nameIndex.end()) && (old->second == nameId)) {
+      _nameIndex.erase(old);
+    }
+  }
+  EventName& entry = _names[nameId];
+
+  move_special(entry._name, event.substring(0, length));
+  entry._hash     = hash;
+  entry._refCount = 1;
+
+  // Does not replace an existing entry in case of a hash collision
+  _nameIndex.emplace(hash, nameId);
+  return true;
+}
+
+void EventQueueStruct::releaseName(uint16_t nameId)
+{
+  if ((nameId < _names.size()) && (_names[nameId]._refCount != 0)) {
+    --_names[nameId]._refCount;
+  }
+}
+
+void EventQueueStruct::releaseRecord(EventQueueRecord& record)
+{
+  releaseName(record._nameId);
+
+  if (record._valueType == EventQueueRecord::ValueType::Text) {
+    record._textValue = String();
+  }
+  record._valueType = EventQueueRecord::ValueType::None;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+bool EventQueueStruct::parseIntValues(const char *values, EventQueueRecord& record)
+{
+  // Only accept values which will be converted back to exactly the same text.
+  uint8_t nrValues = 0;
+
+  while (nrValues < EVENT_QUEUE_NR_INT_VALUES) {
+    const bool negative = (*values == '-');
+
+    if (negative) {
+      ++values;
+    }
+
+    if (!isdigit(*values) ||
+        ((*values == '0') && (negative || isdigit(values[1])))) {
+      // No leading zeroes or "-0"
+      return false;
+    }
+    int64_t value    = 0;
+    uint8_t nrDigits = 0;
+
+    while (isdigit(*values)) {
+      if (++nrDigits > 10) {
+        return false;
+      }
+      value = value * 10 + (*values - '0');
+      ++values;
+    }
+
+    if (negative) {
+      value = -value;
+    }
+
+    if ((value < INT32_MIN) || (value > INT32_MAX)) {
+      return false;
+    }
+    record._intValues[nrValues] = value;
+    ++nrValues;
+
+    if (*values == '\0') {
+      record._nrIntValues = nrValues;
+      return true;
+    }
+
+    if (*values != ',') {
+      return false;
+    }
+    ++values;
+  }
+  return false;
 }
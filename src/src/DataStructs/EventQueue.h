@@ -2,11 +2,54 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
+#include <map>
+#include <vector>
 
 
 #include "../Globals/Plugins.h"
 
+// Max. number of events in the queue, new events are dropped when the queue is full.
+#ifndef EVENT_QUEUE_SIZE
+# ifdef ESP8266
+#  define EVENT_QUEUE_SIZE          32
+# else // ifdef ESP8266
+#  define EVENT_QUEUE_SIZE          64
+# endif // ifdef ESP8266
+#endif // ifndef EVENT_QUEUE_SIZE
+
+// Max. number of event values which can be stored as int, without allocating a String
+#define EVENT_QUEUE_NR_INT_VALUES   4
+
+// Size of the counting filter used to check for duplicates, must be a power of 2
+#define EVENT_QUEUE_DEDUPLICATE_SIZE 128
+
+
+/*********************************************************************************************\
+* EventQueueStruct
+* Fixed capacity ring buffer of events.
+*
+* An event like "Taskname#Valuename=1,2" is stored as:
+* - ID of the interned event name ("Taskname#Valuename")
+* - Up to EVENT_QUEUE_NR_INT_VALUES integer values, or the event values as text
+*   when not all values are plain integers.
+*
+* Event names are kept in a table, so repeated events with the same name
+* do not allocate memory for the name.
+\*********************************************************************************************/
+struct EventQueueRecord {
+  enum class ValueType : uint8_t {
+    None,   // Event without '='
+    Int,    // All values stored in _intValues
+    Text    // Everything after the '=' stored in _textValue
+  };
+
+  String    _textValue;
+  int32_t   _intValues[EVENT_QUEUE_NR_INT_VALUES]{};
+  uint32_t  _hash        = 0; // Hash of the complete event
+  uint16_t  _nameId      = 0;
+  uint8_t   _nrIntValues = 0;
+  ValueType _valueType   = ValueType::None;
+};
 
 struct EventQueueStruct {
   EventQueueStruct() = default;
@@ -32,15 +75,59 @@ struct EventQueueStruct {
 
   bool        isEmpty() const;
 
-  std::size_t size() {
-    return _eventQueue.size();
+  std::size_t size() const {
+    return _count;
+  }
+
+  // Max. number of events in the queue since boot
+  std::size_t getHighWatermark() const {
+    return _highWatermark;
+  }
+
+  // Number of events dropped since boot because the queue was full
+  uint32_t    getDropCount() const {
+    return _dropCount;
   }
 
 private:
 
-  bool isDuplicate(const String& event);
+  struct EventName {
+    String   _name;
+    uint32_t _hash     = 0;
+    uint16_t _refCount = 0;
+  };
+
+  // Split the event and store it in the record.
+  // Return false when the event name cannot be stored.
+  bool     encode(const String    & event,
+                  EventQueueRecord& record);
+
+  bool     isDuplicate(const EventQueueRecord& record) const;
+
+  // Find or add the first 'length' characters of the event in the name table.
+  bool     internName(const String& event,
+                      size_t        length,
+                      uint16_t    & nameId);
+
+  void     releaseName(uint16_t nameId);
+
+  void     releaseRecord(EventQueueRecord& record);
+
+  static bool parseIntValues(const char       *values,
+                             EventQueueRecord& record);
+
+  std::vector<EventQueueRecord> _records;
+  std::vector<EventName>        _names;
+  std::map<uint32_t, uint16_t>  _nameIndex;
+
+  // Counting filter on the event hash, non zero means there may be a duplicate in the queue.
+  uint8_t     _dedupeCount[EVENT_QUEUE_DEDUPLICATE_SIZE]{};
 
-  std::list<String>_eventQueue;
+  std::size_t _head          = 0;
+  std::size_t _count         = 0;
+  std::size_t _highWatermark = 0;
+  uint32_t    _dropCount     = 0;
+  bool        _dropping      = false;
 };
 
 
@@ -5,10 +5,11 @@
 #include "../DataStructs/PluginStats_Config.h"
 
 #include "../Helpers/Misc.h"
+#include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_Plugin.h"
 
-#define EXTRA_TASK_SETTINGS_VERSION 1
+#define EXTRA_TASK_SETTINGS_VERSION 2
 
 
 ExtraTaskSettingsStruct::ExtraTaskSettingsStruct()
@@ -59,6 +60,16 @@ void ExtraTaskSettingsStruct::validate() {
         VariousBits[i]          = 0u;
       }
     }
+
+    if (version < 2) {
+      // Send on change settings were added
+      for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+        setDeadband(i, 0.0f, 0.0f);
+      }
+      SendOnChange           = 0;
+      dummy2                 = 0;
+      SendOnChangeMaxSilence = 0;
+    }
     version = EXTRA_TASK_SETTINGS_VERSION;
   }
 }
@@ -88,6 +99,7 @@ void ExtraTaskSettingsStruct::clearUnusedValueNames(uint8_t usedVars) {
     setIgnoreRangeCheck(i);
     TaskDeviceErrorValue[i] = NAN;
     VariousBits[i]          = 0;
+    setDeadband(i, 0.0f, 0.0f);
   }
 }
 
@@ -249,6 +261,27 @@ void ExtraTaskSettingsStruct::setPluginStatsConfig(taskVarIndex_t taskVarIndex,
 
 #endif // if FEATURE_PLUGIN_STATS
 
+float ExtraTaskSettingsStruct::getDeadbandAbsolute(taskVarIndex_t taskVarIndex) const
+{
+  if (!validTaskVarIndex(taskVarIndex)) { return 0.0f; }
+  return TaskDeviceDeadbandAbs[taskVarIndex];
+}
+
+float ExtraTaskSettingsStruct::getDeadbandRelative(taskVarIndex_t taskVarIndex) const
+{
+  if (!validTaskVarIndex(taskVarIndex)) { return 0.0f; }
+  return TaskDeviceDeadbandRel[taskVarIndex];
+}
+
+void ExtraTaskSettingsStruct::setDeadband(taskVarIndex_t taskVarIndex, float absolute, float relative)
+{
+  if (validTaskVarIndex(taskVarIndex)) {
+    // Negative or invalid values are not useful as deadband
+    TaskDeviceDeadbandAbs[taskVarIndex] = (isValidFloat(absolute) && (absolute > 0.0f)) ? absolute : 0.0f;
+    TaskDeviceDeadbandRel[taskVarIndex] = (isValidFloat(relative) && (relative > 0.0f)) ? relative : 0.0f;
+  }
+}
+
 bool ExtraTaskSettingsStruct::isDefaultTaskVarName(taskVarIndex_t taskVarIndex) const
 {
   if (!validTaskVarIndex(taskVarIndex)) { return false; }
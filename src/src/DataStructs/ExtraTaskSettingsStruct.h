@@ -68,6 +68,14 @@ struct ExtraTaskSettingsStruct
 
 #endif // if FEATURE_PLUGIN_STATS
 
+  // Send on change: Only send to controllers when a task value changed more than its deadband
+  // Deadband is absolute or relative (percentage of the last sent value), 0 = any change.
+  float         getDeadbandAbsolute(taskVarIndex_t taskVarIndex) const;
+  float         getDeadbandRelative(taskVarIndex_t taskVarIndex) const;
+  void          setDeadband(taskVarIndex_t taskVarIndex,
+                            float          absolute,
+                            float          relative);
+
   bool          isDefaultTaskVarName(taskVarIndex_t taskVarIndex) const;
   void          isDefaultTaskVarName(taskVarIndex_t taskVarIndex,
                                      bool           isDefault);
@@ -91,6 +99,11 @@ struct ExtraTaskSettingsStruct
   float       TaskDeviceMaxValue[VARS_PER_TASK];
   float       TaskDeviceErrorValue[VARS_PER_TASK];
   uint32_t    VariousBits[VARS_PER_TASK];
+  float       TaskDeviceDeadbandAbs[VARS_PER_TASK];
+  float       TaskDeviceDeadbandRel[VARS_PER_TASK];
+  uint8_t     SendOnChange;           // Only send to controllers when a value changed more than its deadband
+  uint8_t     dummy2;
+  uint16_t    SendOnChangeMaxSilence; // Max. time in sec. between sending to controllers when 'SendOnChange' is set, 0 = no limit
 };
 
 
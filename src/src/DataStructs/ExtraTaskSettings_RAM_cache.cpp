@@ -0,0 +1,61 @@
+#include "../DataStructs/ExtraTaskSettings_RAM_cache.h"
+
+#include <iterator>
+
+bool ExtraTaskSettings_RAM_cache::get(taskIndex_t TaskIndex, ExtraTaskSettingsStruct& settings)
+{
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->TaskIndex == TaskIndex) {
+      if (it != _entries.begin()) {
+        _entries.splice(_entries.begin(), _entries, it);
+      }
+      settings = _entries.front().settings;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ExtraTaskSettings_RAM_cache::set(taskIndex_t TaskIndex, const ExtraTaskSettingsStruct& settings)
+{
+  if ((EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE == 0) || !validTaskIndex(TaskIndex)) {
+    return;
+  }
+  auto it = _entries.begin();
+
+  while (it != _entries.end() && it->TaskIndex != TaskIndex) {
+    ++it;
+  }
+
+  if ((it == _entries.end()) && (_entries.size() >= EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE)) {
+    // Reuse the least recently used entry
+    it = std::prev(_entries.end());
+  }
+
+  if (it != _entries.end()) {
+    _entries.splice(_entries.begin(), _entries, it);
+  } else {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    _entries.emplace_front();
+  }
+  _entries.front().TaskIndex = TaskIndex;
+  _entries.front().settings  = settings;
+}
+
+void ExtraTaskSettings_RAM_cache::erase(taskIndex_t TaskIndex)
+{
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->TaskIndex == TaskIndex) {
+      _entries.erase(it);
+      return;
+    }
+  }
+}
+
+void ExtraTaskSettings_RAM_cache::clear()
+{
+  _entries.clear();
+}
@@ -0,0 +1,64 @@
+#ifndef DATASTRUCTS_EXTRATASKSETTINGS_RAM_CACHE_H
+#define DATASTRUCTS_EXTRATASKSETTINGS_RAM_CACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/ExtraTaskSettingsStruct.h"
+#include "../DataTypes/TaskIndex.h"
+
+#include <list>
+
+// Max. nr of tasks for which the ExtraTaskSettings are kept in RAM.
+// Set to 0 to disable.
+#ifndef EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE
+  #ifdef ESP32
+    #define EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE 8
+  #else
+    #ifdef USE_SECOND_HEAP
+      #define EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE 4
+    #else
+      #define EXTRA_TASK_SETTINGS_RAM_CACHE_SIZE 2
+    #endif
+  #endif
+#endif
+
+/*********************************************************************************************\
+* ExtraTaskSettings_RAM_cache
+* Copy of the ExtraTaskSettings of the most recently used tasks, as stored in the file system.
+* Switching between tasks then does not need to read the settings from flash.
+*
+* The copy is updated whenever the settings are saved, so it never differs from what is stored.
+* When the cache is full, the least recently used entry is removed.
+\*********************************************************************************************/
+class ExtraTaskSettings_RAM_cache {
+public:
+
+  // Copy the stored settings of the task to settings.
+  // Return false when not present.
+  bool   get(taskIndex_t              TaskIndex,
+             ExtraTaskSettingsStruct& settings);
+
+  // Keep a copy of the settings of the task, as they are stored.
+  void   set(taskIndex_t                    TaskIndex,
+             const ExtraTaskSettingsStruct& settings);
+
+  void   erase(taskIndex_t TaskIndex);
+
+  void   clear();
+
+  size_t size() const {
+    return _entries.size();
+  }
+
+private:
+
+  struct Entry {
+    taskIndex_t             TaskIndex = INVALID_TASK_INDEX;
+    ExtraTaskSettingsStruct settings;
+  };
+
+  // Most recently used first
+  std::list<Entry> _entries;
+};
+
+#endif // ifndef DATASTRUCTS_EXTRATASKSETTINGS_RAM_CACHE_H
@@ -1,71 +1,164 @@
 #include "../DataStructs/LogStruct.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/StringConverter.h"
 
-void LogStruct::add_end() {
-  if (isFull()) {
-    read_idx = nextIndex(read_idx);
-  }
-  write_idx = nextIndex(write_idx);
-  is_full   = (write_idx == read_idx);
+static_assert(LOG_STRUCT_ARENA_SIZE < 0xFFFF, "Positions in the log arena are stored as uint16_t");
+static_assert(LOG_STRUCT_ARENA_SIZE >= (LOG_STRUCT_ENTRY_HEADER_SIZE + LOG_STRUCT_MESSAGE_SIZE), "Log arena too small");
+
+LogStruct::~LogStruct() {
+  release();
 }
 
 void LogStruct::add(const uint8_t loglevel, const String& line) {
-  if (Message[write_idx].add(loglevel, line)) {
-    add_end();
+  if (line.isEmpty() || !allocate()) {
+    return;
   }
-}
+  const uint8_t  length = std::min(line.length(), static_cast<unsigned int>(LOG_STRUCT_MESSAGE_SIZE - 1));
+  const uint16_t size   = LOG_STRUCT_ENTRY_HEADER_SIZE + length;
+
+  reserve(size);
 
-void LogStruct::add(const uint8_t loglevel, String&& line) {
-  if (Message[write_idx].add(loglevel, std::move(line))) {
-    add_end();
+  const uint32_t timestamp = millis();
+  uint8_t       *entry     = _arena + _writePos;
+
+  entry[0] = length;
+  entry[1] = loglevel;
+  memcpy(entry + 2,                            &timestamp,    sizeof(timestamp));
+  memcpy(entry + LOG_STRUCT_ENTRY_HEADER_SIZE, line.c_str(), length);
+
+  if (_count == 0) {
+    _oldestPos = _writePos;
   }
+  _writePos += size;
+  ++_count;
+  ++_nextSequence;
+  lastAddTimeStamp = timestamp;
 }
 
-bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel) {
+bool LogStruct::getNext(LogReader_t  & reader,
+                        bool         & logLinesAvailable,
+                        unsigned long& timestamp,
+                        char          *message,
+                        uint8_t      & length,
+                        uint8_t      & loglevel) {
   lastReadTimeStamp = millis();
   logLinesAvailable = false;
 
-  if (isEmpty()) {
-    return false;
+  if ((static_cast<int32_t>(reader.sequence - _firstSequence) < 0) ||
+      (static_cast<int32_t>(_nextSequence - reader.sequence) < 0)) {
+    // Entries were overwritten before being read, continue at the oldest
+    reader.sequence = _firstSequence;
+    reader.pos      = _oldestPos;
   }
-  timestamp = Message[read_idx]._timestamp;
-  message   = std::move(Message[read_idx]._message);
-  loglevel  = Message[read_idx]._loglevel;
-  clearOldest();
 
-  if (!isEmpty()) {
-    logLinesAvailable = true;
+  while (reader.sequence != _nextSequence) {
+    const uint16_t pos = getPos(reader.sequence, reader.pos);
+
+    reader.pos = nextPos(pos);
+    ++reader.sequence;
+
+    if (!isExpired(pos)) {
+      length            = _arena[pos];
+      loglevel          = _arena[pos + 1];
+      timestamp         = getTimestamp(pos);
+      // Copy, as the entry may be overwritten by the next call to add()
+      memcpy(message, _arena + pos + LOG_STRUCT_ENTRY_HEADER_SIZE, length);
+      logLinesAvailable = reader.sequence != _nextSequence;
+      return true;
+    }
   }
-  return true;
+  return false;
 }
 
-
 bool LogStruct::logActiveRead() {
-  clearExpiredEntries();
-  return timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
+  const bool active = timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
+
+  if (!active && (_arena != nullptr) && (timePassedSince(lastAddTimeStamp) >= LOG_BUFFER_EXPIRE)) {
+    // Nobody is reading and all entries are expired
+    release();
+  }
+  return active;
+}
+
+bool LogStruct::allocate() {
+  if (_arena == nullptr) {
+    _arena = static_cast<uint8_t *>(special_calloc(1, LOG_STRUCT_ARENA_SIZE));
+  }
+  return _arena != nullptr;
+}
+
+void LogStruct::release() {
+  // Keep _writePos, so read positions of readers which read all entries remain valid.
+  _count         = 0;
+  _firstSequence = _nextSequence;
+  _oldestPos     = _writePos;
+
+  if (_arena != nullptr) {
+    free(_arena);
+    _arena = nullptr;
+  }
 }
 
-void LogStruct::clearExpiredEntries() {
-  unsigned int maxLoops = LOG_STRUCT_MESSAGE_LINES;
+void LogStruct::reserve(uint16_t size) {
+  while (true) {
+    if (_count == 0) {
+      if ((_writePos + size) > LOG_STRUCT_ARENA_SIZE) {
+        wrap();
+      }
+      _oldestPos = _writePos;
+      return;
+    }
 
-  while (maxLoops > 0) {
-    --maxLoops;
+    if (_oldestPos < _writePos) {
+      // Free space from _writePos till the end and from the start till _oldestPos
+      if ((_writePos + size) <= LOG_STRUCT_ARENA_SIZE) {
+        return;
+      }
 
-    if (isEmpty() || // Nothing left
-        !Message[read_idx].isExpired())
-    {
+      // Does not fit at the end, continue at the start
+      wrap();
+    } else if ((_writePos + size) <= _oldestPos) {
+      // Free space from _writePos till _oldestPos
       return;
+    } else {
+      clearOldest();
     }
-    clearOldest();
   }
 }
 
+void LogStruct::wrap() {
+  _writePos     = 0;
+  _wrapSequence = _nextSequence;
+}
+
 void LogStruct::clearOldest() {
-  if (!isEmpty()) {
-    is_full = false;
-    Message[read_idx].clear();
-    read_idx = nextIndex(read_idx);
+  if (_count == 0) {
+    return;
   }
+  --_count;
+  ++_firstSequence;
+  _oldestPos = (_count == 0) ? _writePos : getPos(_firstSequence, nextPos(_oldestPos));
+}
+
+uint16_t LogStruct::nextPos(uint16_t pos) const {
+  return pos + LOG_STRUCT_ENTRY_HEADER_SIZE + _arena[pos];
+}
+
+uint16_t LogStruct::getPos(uint32_t sequence, uint16_t pos) const {
+  // An entry which did not fit at the end of the arena was added at the start.
+  // This can only be the entry after the last wrap, as all entries before an earlier wrap are already overwritten.
+  return (sequence == _wrapSequence) ? 0 : pos;
+}
+
+uint32_t LogStruct::getTimestamp(uint16_t pos) const {
+  uint32_t timestamp;
+
+  memcpy(&timestamp, _arena + pos + 2, sizeof(timestamp));
+  return timestamp;
+}
+
+bool LogStruct::isExpired(uint16_t pos) const {
+  return timePassedSince(getTimestamp(pos)) >= LOG_BUFFER_EXPIRE;
 }
@@ -4,72 +4,110 @@
 
 #include "../../ESPEasy_common.h"
 
-#include "../DataStructs/LogEntry.h"
-
 /*********************************************************************************************\
  * LogStruct
+ * Log lines are kept in a single buffer (arena) used as a ring buffer.
+ * Each entry is stored as: length, loglevel, timestamp, message (without 0-termination)
+ * An entry which does not fit at the end continues at the start of the buffer.
+ * When the buffer is full, the oldest entries are overwritten.
+ * The buffer is only allocated while logs are being read.
+ *
+ * Each reader keeps its own LogReader_t cursor.
 \*********************************************************************************************/
 #ifdef ESP32
-  #define LOG_STRUCT_MESSAGE_LINES 60
+  #define LOG_STRUCT_ARENA_SIZE 8192
 #else
   #ifdef USE_SECOND_HEAP
-    #define LOG_STRUCT_MESSAGE_LINES 60
+    #define LOG_STRUCT_ARENA_SIZE 4096
   #else
     #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
-      #define LOG_STRUCT_MESSAGE_LINES 10
+      #define LOG_STRUCT_ARENA_SIZE 1280
     #else
-      #define LOG_STRUCT_MESSAGE_LINES 15
+      #define LOG_STRUCT_ARENA_SIZE 2048
     #endif
   #endif
 #endif
 
+// Max. length of a log message, including 0-termination. Longer messages are truncated.
+#define LOG_STRUCT_MESSAGE_SIZE 128
+
+// Length (1 byte), loglevel (1 byte), timestamp (4 bytes)
+#define LOG_STRUCT_ENTRY_HEADER_SIZE 6
+
 #ifdef ESP32
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 30000
+  #define LOG_BUFFER_EXPIRE              30000  // Time after which a buffered log item is considered expired.
 #else
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 5000
+  #define LOG_BUFFER_EXPIRE              5000   // Time after which a buffered log item is considered expired.
 #endif
 
 
+// Read position of a log reader
+struct LogReader_t {
+  uint32_t sequence{}; // Sequence nr of the next entry to read
+  uint16_t pos{};      // Position of that entry in the arena, only valid when the entry is still present
+};
+
 struct LogStruct {
-    
-    void add(const uint8_t loglevel, const String& line);
-    void add(const uint8_t loglevel, String&& line);
 
-    // Read the next item and append it to the given string.
-    // Returns whether new lines are available.
-//    bool get(String& output, const String& lineEnd);
+    ~LogStruct();
+
+    void add(const uint8_t loglevel, const String& line);
 
+    // Read the next item.
+    // The message is copied into message, which must be able to hold LOG_STRUCT_MESSAGE_SIZE chars.
+    // The copy is not 0-terminated.
+    // Entries which are expired or already overwritten are skipped.
     // Returns whether a line was retrieved.
-    bool getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel);
+    bool getNext(LogReader_t  & reader,
+                 bool         & logLinesAvailable,
+                 unsigned long& timestamp,
+                 char          *message,
+                 uint8_t      & length,
+                 uint8_t      & loglevel);
 
     bool isEmpty() const {
-      return !is_full && (write_idx == read_idx);
+      return _count == 0;
     }
 
-    bool isFull() const { return is_full; }
-
     bool logActiveRead();
 
   private:
 
-    void add_end();
+    bool allocate();
+
+    void release();
 
-    void clearExpiredEntries();
+    // Make room for an entry of size bytes at _writePos
+    void reserve(uint16_t size);
 
     void clearOldest();
 
-    static int nextIndex(int idx) {
-//      return ((++idx) == LOG_STRUCT_MESSAGE_LINES) ? 0 : idx;
-      return (idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-    }
+    // Position of the entry following the entry at pos
+    uint16_t nextPos(uint16_t pos) const;
+
+    // Continue adding at the start of the arena
+    void wrap();
+
+    // Position of the entry with given sequence nr, following the entry ending at pos
+    uint16_t getPos(uint32_t sequence, uint16_t pos) const;
+
+    uint32_t getTimestamp(uint16_t pos) const;
+
+    bool isExpired(uint16_t pos) const;
 
-    LogEntry_t Message[LOG_STRUCT_MESSAGE_LINES];
-    int write_idx = 0;
-    int read_idx = 0;
+    uint8_t *_arena = nullptr;
+    uint32_t _firstSequence = 0; // Sequence nr of the oldest entry
+    uint32_t _nextSequence = 0;  // Sequence nr of the next entry to add
+    uint32_t _wrapSequence = 0;  // Sequence nr of the first entry added at the start of the arena
+    uint16_t _writePos = 0;
+    uint16_t _oldestPos = 0;
+    uint16_t _count = 0;
     unsigned long lastReadTimeStamp = 0;
-    bool is_full = false;
+    unsigned long lastAddTimeStamp = 0;
 };
 
 
 
-#endif // DATASTRUCTS_LOGSTRUCT_H
\ No newline at end of file
+#endif // DATASTRUCTS_LOGSTRUCT_H
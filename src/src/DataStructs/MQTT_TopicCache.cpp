@@ -0,0 +1,111 @@
+#include "../DataStructs/MQTT_TopicCache.h"
+
+#if FEATURE_MQTT
+
+# include "../Globals/Plugins_other.h"
+# include "../Helpers/Misc.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/SystemVariables.h"
+
+static_assert(VARS_PER_TASK <= 8, "MQTT_TopicCache uses uint8_t bitmaps per task value");
+
+String MQTT_TopicCache::getTopic(const String& pubname, struct EventStruct *event, uint8_t taskValueIndex)
+{
+  if ((event == nullptr) || !validTaskIndex(event->TaskIndex) || (taskValueIndex >= VARS_PER_TASK)) {
+    String topic(pubname);
+    parseSingleControllerVariable(topic, event, taskValueIndex, false);
+    parseControllerVariables(topic, event, false);
+    return topic;
+  }
+
+  TopicTemplates& templates = _topics[makeKey(event->ControllerIndex, event->TaskIndex)];
+
+  if ((templates.idx != event->idx) || !templates.pubname.equals(pubname)) {
+    // Publish template or IDX changed, all topics must be made again
+    templates.pubname  = pubname;
+    templates.idx      = event->idx;
+    templates.compiled = 0;
+    templates.dynamic  = 0;
+
+    for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+      templates.topics[i] = String();
+    }
+  }
+
+  const uint8_t mask = 1 << taskValueIndex;
+
+  if ((templates.compiled & mask) == 0) {
+    templates.topics[taskValueIndex] = pubname;
+
+    if (!compile(templates.topics[taskValueIndex], event, taskValueIndex)) {
+      templates.dynamic |= mask;
+    }
+    templates.compiled |= mask;
+  }
+
+  if ((templates.dynamic & mask) == 0) {
+    return templates.topics[taskValueIndex];
+  }
+  String topic(templates.topics[taskValueIndex]);
+
+  parseControllerVariables(topic, event, false);
+  return topic;
+}
+
+void MQTT_TopicCache::clear()
+{
+  _topics.clear();
+}
+
+void MQTT_TopicCache::clear(taskIndex_t TaskIndex)
+{
+  for (auto it = _topics.begin(); it != _topics.end();) {
+    if ((it->first & 0xFF) == TaskIndex) {
+      it = _topics.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool MQTT_TopicCache::compile(String& topic, struct EventStruct *event, uint8_t taskValueIndex)
+{
+  parseSingleControllerVariable(topic, event, taskValueIndex, false);
+
+  if (topic.indexOf('%') != -1) {
+    if ((topic.indexOf(F("%val")) != -1) || (topic.indexOf(F("%vname")) != -1)) {
+      // Must be replaced before %tskname%, thus leave all other event variables for parseControllerVariables()
+      return false;
+    }
+    repl(F("%id%"),      String(event->idx),                  topic, false);
+    repl(F("%tskname%"), getTaskDeviceName(event->TaskIndex), topic, false);
+
+    const SystemVariables::Enum staticSysVars[] = {
+      SystemVariables::SYSNAME,
+      SystemVariables::UNIT_sysvar,
+      # if FEATURE_ZEROFILLED_UNITNUMBER
+      SystemVariables::UNIT_0_sysvar,
+      # endif // if FEATURE_ZEROFILLED_UNITNUMBER
+    };
+
+    for (const SystemVariables::Enum sysVar : staticSysVars) {
+      repl(SystemVariables::toString(sysVar), SystemVariables::getSystemVariable(sysVar), topic, false);
+    }
+  }
+
+  if (parseTemplate_CallBack_ptr != nullptr) {
+    return false;
+  }
+
+  // Characters which start a part to be parsed by parseTemplate()
+  const char *parseChars = "%[{&\\";
+
+  for (const char *c = parseChars; *c != '\0'; ++c) {
+    if (topic.indexOf(*c) != -1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif // if FEATURE_MQTT
@@ -0,0 +1,64 @@
+#ifndef DATASTRUCTS_MQTT_TOPICCACHE_H
+#define DATASTRUCTS_MQTT_TOPICCACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include "../DataStructs/ESPEasy_EventStruct.h"
+# include "../DataTypes/ControllerIndex.h"
+# include "../DataTypes/TaskIndex.h"
+
+# include <map>
+
+/*********************************************************************************************\
+* MQTT_TopicCache
+* Publish topics per controller, task and task value.
+*
+* The parts of a publish topic which do not change between messages are replaced once:
+* %valname%, %tskname%, %id%, %sysname%, %unit% and %unit_0%.
+* When nothing else is left to replace, the topic is used as-is for every message.
+* Otherwise only the remaining parts are parsed for each message.
+*
+* The cache must be cleared when task or controller settings change.
+\*********************************************************************************************/
+class MQTT_TopicCache {
+public:
+
+  // Return the topic for the task value, same as parsing pubname
+  // using parseSingleControllerVariable() and parseControllerVariables().
+  String getTopic(const String      & pubname,
+                  struct EventStruct *event,
+                  uint8_t             taskValueIndex);
+
+  void   clear();
+
+  void   clear(taskIndex_t TaskIndex);
+
+private:
+
+  struct TopicTemplates {
+    String  pubname;               // Publish template the topics were made from
+    String  topics[VARS_PER_TASK]; // Topic or partially parsed topic
+    int     idx{};                 // event->idx used to make the topics
+    uint8_t compiled{};            // Bitmap of topics already made
+    uint8_t dynamic{};             // Bitmap of topics which still need parsing on each use
+  };
+
+  // Replace all parts which do not change between messages.
+  // Return false when the result still needs to be parsed.
+  static bool compile(String            & topic,
+                      struct EventStruct *event,
+                      uint8_t             taskValueIndex);
+
+  static uint16_t makeKey(controllerIndex_t ControllerIndex,
+                          taskIndex_t       TaskIndex) {
+    return (static_cast<uint16_t>(ControllerIndex) << 8) | TaskIndex;
+  }
+
+  std::map<uint16_t, TopicTemplates> _topics;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // ifndef DATASTRUCTS_MQTT_TOPICCACHE_H
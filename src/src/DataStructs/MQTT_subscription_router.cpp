@@ -0,0 +1,228 @@
+#include "../DataStructs/MQTT_subscription_router.h"
+
+#if FEATURE_MQTT
+
+# include "../Globals/Plugins.h"
+
+# include <ctype.h>
+# include <string.h>
+
+static_assert(TASKS_MAX <= 64, "MQTT_taskMask_t must have a bit per task");
+
+static bool isWildcard(const String& level, char wildcard)
+{
+  return (level.length() == 1) && (level[0] == wildcard);
+}
+
+void MQTT_subscription_router::subscribe(taskIndex_t TaskIndex, const String& topicFilter)
+{
+  if (!validTaskIndex(TaskIndex)) {
+    return;
+  }
+  const char *begin = topicFilter.c_str();
+  const char *end   = begin + topicFilter.length();
+
+  trimTopic(begin, end);
+
+  if (begin == end) {
+    return;
+  }
+
+  if (_nodes.empty()) {
+    _nodes.emplace_back();
+  }
+  uint16_t node = 0;
+
+  while (true) {
+    const char *levelEnd = begin;
+
+    while (levelEnd != end && *levelEnd != '/') {
+      ++levelEnd;
+    }
+    const size_t length = levelEnd - begin;
+    uint16_t     child  = findChild(node, begin, length);
+
+    if (child == NO_NODE) {
+      child = addChild(node, begin, length);
+
+      if (child == NO_NODE) {
+        return;
+      }
+    }
+    node = child;
+
+    if (levelEnd == end) {
+      break;
+    }
+    begin = levelEnd + 1;
+  }
+  _nodes[node].tasks |= static_cast<MQTT_taskMask_t>(1) << TaskIndex;
+}
+
+void MQTT_subscription_router::unsubscribe(taskIndex_t TaskIndex)
+{
+  if (!validTaskIndex(TaskIndex) || _nodes.empty()) {
+    return;
+  }
+  const MQTT_taskMask_t mask = ~(static_cast<MQTT_taskMask_t>(1) << TaskIndex);
+  bool hasTasks              = false;
+
+  for (Node& node : _nodes) {
+    node.tasks &= mask;
+
+    if (node.tasks != 0) {
+      hasTasks = true;
+    }
+  }
+
+  if (!hasTasks) {
+    clear();
+    return;
+  }
+
+  // Remove the levels no longer used by any subscription
+  std::vector<Node> nodes;
+
+  copyUsed(0, nodes);
+  _nodes.swap(nodes);
+}
+
+void MQTT_subscription_router::clear()
+{
+  _nodes.clear();
+}
+
+MQTT_taskMask_t MQTT_subscription_router::getTasks(const char *topic) const
+{
+  MQTT_taskMask_t tasks = 0;
+
+  if (_nodes.empty() || (topic == nullptr)) {
+    return tasks;
+  }
+  const char *begin = topic;
+  const char *end   = begin + strlen(topic);
+
+  trimTopic(begin, end);
+
+  if (begin != end) {
+    match(0, begin, end, tasks);
+  }
+  return tasks;
+}
+
+uint16_t MQTT_subscription_router::findChild(uint16_t parent, const char *level, size_t length) const
+{
+  for (uint16_t child = _nodes[parent].firstChild; child != NO_NODE; child = _nodes[child].nextSibling) {
+    const String& childLevel = _nodes[child].level;
+
+    if ((childLevel.length() == length) && (memcmp(childLevel.c_str(), level, length) == 0)) {
+      return child;
+    }
+  }
+  return NO_NODE;
+}
+
+uint16_t MQTT_subscription_router::addChild(uint16_t parent, const char *level, size_t length)
+{
+  if (_nodes.size() >= NO_NODE) {
+    return NO_NODE;
+  }
+  const uint16_t child = _nodes.size();
+
+  _nodes.emplace_back();
+  _nodes[child].level.concat(level, length);
+  _nodes[child].nextSibling = _nodes[parent].firstChild;
+  _nodes[parent].firstChild = child;
+  return child;
+}
+
+void MQTT_subscription_router::match(uint16_t         node,
+                                     const char      *topic,
+                                     const char      *end,
+                                     MQTT_taskMask_t& tasks) const
+{
+  if (topic == nullptr) {
+    // All levels of the topic are matched, only "#" may follow
+    tasks |= _nodes[node].tasks;
+
+    for (uint16_t child = _nodes[node].firstChild; child != NO_NODE; child = _nodes[child].nextSibling) {
+      if (isWildcard(_nodes[child].level, '#')) {
+        tasks |= _nodes[child].tasks;
+      }
+    }
+    return;
+  }
+
+  const char *levelEnd = topic;
+
+  while (levelEnd != end && *levelEnd != '/') {
+    ++levelEnd;
+  }
+  const size_t length = levelEnd - topic;
+  const char  *next   = (levelEnd == end) ? nullptr : levelEnd + 1;
+
+  for (uint16_t child = _nodes[node].firstChild; child != NO_NODE; child = _nodes[child].nextSibling) {
+    const String& childLevel = _nodes[child].level;
+
+    if (isWildcard(childLevel, '#')) {
+      // Matches all remaining levels
+      tasks |= _nodes[child].tasks;
+    } else if (isWildcard(childLevel, '+') ||
+               ((childLevel.length() == length) && (memcmp(childLevel.c_str(), topic, length) == 0))) {
+      match(child, next, end, tasks);
+    }
+  }
+}
+
+uint16_t MQTT_subscription_router::copyUsed(uint16_t node, std::vector<Node>& dest) const
+{
+  // Add parent before its children
+  const uint16_t index = dest.size();
+
+  dest.emplace_back();
+  dest[index].level = _nodes[node].level;
+  dest[index].tasks = _nodes[node].tasks;
+
+  uint16_t lastChild = NO_NODE;
+
+  for (uint16_t child = _nodes[node].firstChild; child != NO_NODE; child = _nodes[child].nextSibling) {
+    const uint16_t copy = copyUsed(child, dest);
+
+    if (copy != NO_NODE) {
+      if (lastChild == NO_NODE) {
+        dest[index].firstChild = copy;
+      } else {
+        dest[lastChild].nextSibling = copy;
+      }
+      lastChild = copy;
+    }
+  }
+
+  if ((index != 0) && (dest[index].tasks == 0) && (dest[index].firstChild == NO_NODE)) {
+    // No children were added, so this is still the last node
+    dest.pop_back();
+    return NO_NODE;
+  }
+  return index;
+}
+
+void MQTT_subscription_router::trimTopic(const char *& begin, const char *& end)
+{
+  while (begin != end && isspace(*begin)) {
+    ++begin;
+  }
+
+  while (end != begin && isspace(*(end - 1))) {
+    --end;
+  }
+
+  if ((begin != end) && (*begin == '/')) {
+    ++begin;
+  }
+
+  if ((end != begin) && (*(end - 1) == '/')) {
+    --end;
+  }
+}
+
+#endif // if FEATURE_MQTT
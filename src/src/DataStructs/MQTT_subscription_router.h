@@ -0,0 +1,83 @@
+#ifndef DATASTRUCTS_MQTT_SUBSCRIPTION_ROUTER_H
+#define DATASTRUCTS_MQTT_SUBSCRIPTION_ROUTER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <vector>
+
+// Bitmap of tasks, bit N set for task index N
+typedef uint64_t MQTT_taskMask_t;
+
+/*********************************************************************************************\
+* MQTT_subscription_router
+* Topic trie of the MQTT subscriptions per task, with support for '+' and '#' wildcards.
+* Used to only deliver an incoming message to the tasks with a matching subscription.
+*
+* Topics and subscriptions are matched like MQTTCheckSubscription_037() does:
+* Leading and trailing spaces are ignored, as is a single leading and trailing '/'.
+* A "#" level also matches its parent level, e.g. "a/#" matches "a".
+* Thus a task may still need to check the topic itself.
+\*********************************************************************************************/
+class MQTT_subscription_router {
+public:
+
+  // Add subscription for the task.
+  void            subscribe(taskIndex_t   TaskIndex,
+                            const String& topicFilter);
+
+  // Remove all subscriptions of the task.
+  void            unsubscribe(taskIndex_t TaskIndex);
+
+  void            clear();
+
+  // Tasks with a subscription matching the topic.
+  MQTT_taskMask_t getTasks(const char *topic) const;
+
+  size_t          getNrNodes() const {
+    return _nodes.size();
+  }
+
+private:
+
+  struct Node {
+    String          level;                         // Topic level, or "+" / "#" wildcard
+    uint16_t        firstChild  = NO_NODE;
+    uint16_t        nextSibling = NO_NODE;
+    MQTT_taskMask_t tasks       = 0;               // Tasks with a subscription ending at this level
+  };
+
+  static constexpr uint16_t NO_NODE = 0xFFFF;
+
+  uint16_t findChild(uint16_t    parent,
+                     const char *level,
+                     size_t      length) const;
+
+  uint16_t addChild(uint16_t    parent,
+                    const char *level,
+                    size_t      length);
+
+  void     match(uint16_t         node,
+                 const char      *topic,
+                 const char      *end,
+                 MQTT_taskMask_t& tasks) const;
+
+  // Copy node and its children to dest, skipping levels without subscriptions.
+  // Return index of the copy in dest, or NO_NODE when not copied.
+  uint16_t copyUsed(uint16_t           node,
+                    std::vector<Node>& dest) const;
+
+  // Set begin and end to the part of the topic to match.
+  static void trimTopic(const char *& begin,
+                        const char *& end);
+
+  // _nodes[0] is the root node, only present when there are subscriptions.
+  std::vector<Node> _nodes;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // ifndef DATASTRUCTS_MQTT_SUBSCRIPTION_ROUTER_H
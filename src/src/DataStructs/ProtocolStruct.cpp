@@ -8,4 +8,5 @@ ProtocolStruct::ProtocolStruct() :
   #if FEATURE_MQTT_TLS
   , usesTLS(false)
   #endif
+  , usesHTTP(false)
     {}
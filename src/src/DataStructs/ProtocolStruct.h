@@ -21,6 +21,10 @@ struct ProtocolStruct
   }
 
   uint16_t defaultPort{};
+
+  // Max. number of queued elements the controller can send in a single message.
+  // Only used when the controller sets a batch function on its delay queue, 0 = no support for batches.
+  uint8_t  maxBatchSize{};
   struct {
     uint16_t usesMQTT             : 1;
     uint16_t usesAccount          : 1;
@@ -42,6 +46,7 @@ struct ProtocolStruct
 #if FEATURE_MQTT_TLS
   bool     usesTLS              : 1; // May offer TLS related settings and options
 #endif
+  bool     usesHTTP             : 1; // Sends its messages using send_via_http(), may offer HTTP keep-alive
 
 //  uint8_t Number{};
 };
@@ -144,7 +144,7 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
 
     if (fname.isEmpty()) { return; }
 
-    fp = tryOpenFile(fname, "r");
+    fp.open(fname);
   }
 
   if (fp) {
@@ -273,7 +273,18 @@ bool RTC_cache_handler_struct::flush() {
         fp.close();
       }
 
-      int bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      // Store the samples in the compact block format
+      std::vector<uint8_t> block;
+
+      if (!ESPEasyControllerCache_file::encodeBlock(&RTC_cache_data[0], RTC_cache.writePos, block)) {
+        // No complete sample in the buffer, nothing useful to store.
+        initRTCcache_data();
+        clearRTCcacheData();
+        saveRTCcache();
+        return false;
+      }
+
+      const size_t bytesWritten = fw.write(&block[0], block.size());
 
       delay(0);
       fw.flush();
@@ -282,7 +293,7 @@ bool RTC_cache_handler_struct::flush() {
         #endif // ifdef RTC_STRUCT_DEBUG
 
 
-      if ((bytesWritten < RTC_cache.writePos) /*|| (fw.size() == filesize)*/) {
+      if ((bytesWritten < block.size()) /*|| (fw.size() == filesize)*/) {
           #ifdef RTC_STRUCT_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -619,6 +630,13 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
       }
 
       String fname = createCacheFilename(RTC_cache.writeFileNr);
+
+      if (!ESPEasyControllerCache_file::canAppendBlock(fname)) {
+        // File with the old format or an incomplete block at the end, e.g. due to a failed write.
+        // Continue in a new file.
+        ++RTC_cache.writeFileNr;
+        fname = createCacheFilename(RTC_cache.writeFileNr);
+      }
       fw = tryOpenFile(fname, "a+");
 
       if (!fw) {
@@ -7,6 +7,7 @@
 
 #if FEATURE_RTC_CACHE_STORAGE
 
+#include "../DataStructs/ESPEasyControllerCache_file.h"
 #include "../DataStructs/RTCCacheStruct.h"
 
 #include <FS.h>
@@ -110,7 +111,7 @@ private:
 #endif // ifdef ESP8266
   fs::File fw;  // File handler Write
   fs::File fr;  // File handler Read
-  fs::File fp;  // File handler Peek
+  ESPEasyControllerCache_file fp;  // File handler Peek
   size_t   _peekfilenr  = 0;
   size_t   _peekreadpos = 0;
 
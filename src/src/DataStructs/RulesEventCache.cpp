@@ -1,6 +1,7 @@
 #include "../DataStructs/RulesEventCache.h"
 
 #include "../DataStructs/TimingStats.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/RulesMatcher.h"
 #include "../Helpers/StringConverter.h"
 
@@ -24,6 +25,8 @@ RulesEventCache_element::RulesEventCache_element(
 void RulesEventCache::clear()
 {
   _eventCache.clear();
+  _dispatchIndex.clear();
+  _unindexed.clear();
   _initialized = false;
 }
 
@@ -42,6 +45,15 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
     HeapSelectDram ephemeral;
     # endif // ifdef USE_SECOND_HEAP
 
+    const uint16_t index = _eventCache.size();
+    uint32_t key{};
+
+    if (getEventNameKey(event, true, key)) {
+      _dispatchIndex[key].push_back(index);
+    } else {
+      _unindexed.push_back(index);
+    }
+
     _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
@@ -50,49 +62,92 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
 
 RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
-
   // FIXME TD-er: Disable optimize as it has some side effects.
   // For example, matching a specific event first and then a more generic one is perfectly normal to do.
-  // But this optimization will then put the generic one in front as it will be matched more often.
+  // But reordering based on match count will then put the generic one in front as it will be matched more often.
   // Thus it will never match the more specific one anymore.
+  // The dispatch index keeps the order of the rules, so no reordering is needed.
+
+  static const std::vector<uint16_t> empty;
+  const std::vector<uint16_t> *candidates = &empty;
+
+  uint32_t key{};
+
+  if (getEventNameKey(event, false, key)) {
+    auto it = _dispatchIndex.find(key);
+
+    if (it != _dispatchIndex.end()) {
+      candidates = &(it->second);
+    }
+  }
+
+  // Merge both ordered lists to keep first-match semantics
+  auto it_indexed   = candidates->begin();
+  auto it_unindexed = _unindexed.begin();
+
+  while (it_indexed != candidates->end() || it_unindexed != _unindexed.end()) {
+    uint16_t index;
+
+    if ((it_unindexed == _unindexed.end()) ||
+        ((it_indexed != candidates->end()) && (*it_indexed < *it_unindexed))) {
+      index = *it_indexed;
+      ++it_indexed;
+    } else {
+      index = *it_unindexed;
+      ++it_unindexed;
+    }
+
+    if (matchAt(event, index)) {
+      return _eventCache.begin() + index;
+    }
+  }
+  return _eventCache.end();
+}
+
+bool RulesEventCache::getEventNameKey(const String& str, bool isRule, uint32_t& key)
+{
+  const char  *c   = str.c_str();
+  const size_t len = str.length();
+  size_t start     = 0;
+
+  while (start < len && c[start] == ' ') {
+    ++start;
+  }
+
+  if (isRule && (c[start] == '!') && (str.indexOf('#') == -1)) {
+    // Literal string event without '#' is matched on its prefix
+    return false;
+  }
 
+  size_t end = start;
 
-  for (; it != _eventCache.end(); ++it)
-  {
-    START_TIMER
-    const bool match = ruleMatch(event, it->_event);
-    STOP_TIMER(RULES_MATCH);
-
-    if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
+  for (; end < len; ++end) {
+    const char ch = c[end];
+
+    if ((ch == '=') || (ch == '#') || (ch == '.') ||
+        (ch == '<') || (ch == '>') || ((ch == '!') && (end != start))) {
+      break;
     }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
-      }
+
+    if (isRule &&
+        ((ch == '*') || (ch == '[') || (ch == '%') || (ch == '{'))) {
+      // Wildcard or not yet parsed variable in the event name
+      return false;
     }
-    */
   }
-  return it;
+
+  while (end > start && c[end - 1] == ' ') {
+    --end;
+  }
+
+  key = calc_FNV1a_ci(c + start, end - start);
+  return true;
+}
+
+bool RulesEventCache::matchAt(const String& event, size_t index) const
+{
+  START_TIMER
+  const bool match = ruleMatch(event, _eventCache[index]._event);
+  STOP_TIMER(RULES_MATCH);
+  return match;
 }
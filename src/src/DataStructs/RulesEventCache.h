@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
 struct RulesEventCache_element {
@@ -37,15 +38,38 @@ public:
                const String& filename,
                size_t        pos);
 
+  // Find the first rule matching the event, in order of appearance in the rules files.
   RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
 
+  RulesEventCache_vector::const_iterator begin() const {
+    return _eventCache.begin();
+  }
+
   RulesEventCache_vector::const_iterator end() const {
     return _eventCache.end();
   }
 
 private:
 
+  // Compute a case insensitive hash of the event name prefix.
+  // This is the part before the first '=', '#', '.' or compare operator.
+  // Return false when the rule cannot be indexed as its prefix is not a literal string.
+  // For example when it contains a wildcard or a variable which is only known when matching.
+  static bool getEventNameKey(const String& str,
+                              bool          isRule,
+                              uint32_t    & key);
+
+  bool        matchAt(const String& event,
+                      size_t        index) const;
+
   RulesEventCache_vector _eventCache;
+
+  // Dispatch index, event name key -> ordered list of indices in _eventCache
+  std::map<uint32_t, std::vector<uint16_t> > _dispatchIndex;
+
+  // Ordered list of indices in _eventCache which must be checked for every event
+  std::vector<uint16_t> _unindexed;
+
   bool _initialized = false;
 };
 
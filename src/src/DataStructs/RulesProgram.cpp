@@ -0,0 +1,239 @@
+#include "../DataStructs/RulesProgram.h"
+
+#if FEATURE_RULES_COMPILED
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/RulesMatcher.h"
+# include "../Helpers/StringConverter.h"
+
+void RulesProgram::clear()
+{
+  _instructions.clear();
+  _text.clear();
+  _blockStart.clear();
+  _ifStack.clear();
+  _openBlock = 0;
+  _inBlock   = false;
+  ++_generation;
+}
+
+void RulesProgram::addLine(const String& line, bool isOnLine)
+{
+  if (isOnLine) {
+    if (_inBlock) {
+      addLog(LOG_LEVEL_ERROR, concat(F("Rules : Missing 'endon' before: "), line));
+      closeBlock();
+    }
+
+    String event, action;
+    getEventFromRulesLine(line, event, action);
+
+    _openBlock = emit(RulesOpcode::On, event, 0);
+    _inBlock   = true;
+    _blockStart.push_back(_openBlock);
+
+    if (!action.isEmpty()) {
+      // Single "on ... do action" line, no block
+      addLine(action, false);
+      closeBlock();
+    }
+    return;
+  }
+
+  if (!_inBlock || line.isEmpty()) {
+    return;
+  }
+
+  if (line.equalsIgnoreCase(F("endon"))) {
+    closeBlock();
+    return;
+  }
+
+  if (line.substring(0, 3).equalsIgnoreCase(F("if ")) ||
+      line.substring(0, 7).equalsIgnoreCase(F("elseif "))) {
+    const bool isElseIf = line[0] == 'e' || line[0] == 'E';
+    String     check    = line.substring(isElseIf ? 7 : 3);
+    check.trim();
+    uint8_t flags = getTextFlags(check);
+
+    if (!(flags & RulesInstruction::NeedsTemplate)) {
+      // Condition will not change at runtime, so already convert to what conditionMatchExtended expects.
+      check.toLowerCase();
+    }
+
+    if (!isElseIf) {
+      if (_ifStack.size() >= RULES_IF_MAX_NESTING_LEVEL) {
+        flags |= RulesInstruction::NestingExceeded;
+      }
+      _ifStack.push_back(emit(RulesOpcode::If, check, flags));
+      return;
+    }
+
+    if (_ifStack.empty()) {
+      addLog(LOG_LEVEL_ERROR, F("Rules : 'elseif' without 'if'"));
+      return;
+    }
+    uint16_t last = _ifStack.back();
+
+    while (_instructions[last]._next != 0) {
+      last = _instructions[last]._next;
+    }
+
+    if (_instructions[last]._opcode == RulesOpcode::Else) {
+      addLog(LOG_LEVEL_ERROR, F("Rules : 'elseif' after 'else'"));
+      return;
+    }
+    const uint16_t pc = emit(RulesOpcode::ElseIf, check, flags);
+    _instructions[last]._next = pc;
+    return;
+  }
+
+  if (line.equalsIgnoreCase(F("else"))) {
+    if (_ifStack.empty()) {
+      addLog(LOG_LEVEL_ERROR, F("Rules : 'else' without 'if'"));
+      return;
+    }
+    uint16_t last = _ifStack.back();
+
+    while (_instructions[last]._next != 0) {
+      last = _instructions[last]._next;
+    }
+    const uint16_t pc = emit(RulesOpcode::Else, EMPTY_STRING, 0);
+    _instructions[last]._next = pc;
+    return;
+  }
+
+  if (line.equalsIgnoreCase(F("endif"))) {
+    if (_ifStack.empty()) {
+      addLog(LOG_LEVEL_ERROR, F("Rules : 'endif' without 'if'"));
+      return;
+    }
+    closeIfBlock(emit(RulesOpcode::EndIf, EMPTY_STRING, 0));
+    return;
+  }
+
+  if (line.startsWith(F("%event"))) {
+    // Same as in parseCompleteNonCommentLine(), only allow restricted commands
+    addLog(LOG_LEVEL_ERROR, concat(F("Rules : Prefix command with 'restrict': "), line));
+    emit(RulesOpcode::Command, line, getTextFlags(line) | RulesInstruction::Restricted);
+    return;
+  }
+
+  if (equals(parseString(line, 1), F("restrict"))) {
+    const String action = parseStringToEndKeepCase(line, 2);
+    emit(RulesOpcode::Command, action, getTextFlags(action) | RulesInstruction::Restricted);
+    return;
+  }
+  emit(RulesOpcode::Command, line, getTextFlags(line));
+}
+
+void RulesProgram::endFile()
+{
+  if (_inBlock) {
+    closeBlock();
+  }
+}
+
+bool RulesProgram::getBlockStart(size_t blockIndex, uint16_t& pc) const
+{
+  if (blockIndex >= _blockStart.size()) {
+    return false;
+  }
+  pc = _blockStart[blockIndex];
+  return true;
+}
+
+size_t RulesProgram::getMemorySize() const
+{
+  return
+    _instructions.capacity() * sizeof(RulesInstruction) +
+    _text.capacity() +
+    _blockStart.capacity() * sizeof(uint16_t);
+}
+
+uint16_t RulesProgram::emit(RulesOpcode opcode, const String& text, uint8_t flags)
+{
+  const uint16_t pc = _instructions.size();
+
+  _instructions.emplace_back(opcode, _text.size());
+  _instructions.back()._flags = flags;
+
+  const char *c = text.c_str();
+
+  _text.insert(_text.end(), c, c + text.length() + 1); // Include 0-terminator
+  return pc;
+}
+
+void RulesProgram::closeIfBlock(uint16_t pc)
+{
+  uint16_t branch = _ifStack.back();
+
+  _ifStack.pop_back();
+
+  // Let all branches point to the end of the if-block.
+  // The last branch also continues at the end when its condition is not met.
+  while (true) {
+    _instructions[branch]._end = pc;
+
+    if (_instructions[branch]._next == 0) {
+      _instructions[branch]._next = pc;
+      return;
+    }
+    branch = _instructions[branch]._next;
+  }
+}
+
+void RulesProgram::closeBlock()
+{
+  const uint16_t pc = emit(RulesOpcode::EndOn, EMPTY_STRING, 0);
+
+  while (!_ifStack.empty()) {
+    // Missing 'endif' is implied by 'endon'
+    closeIfBlock(pc);
+  }
+  _instructions[_openBlock]._end = pc;
+  _inBlock                       = false;
+}
+
+uint8_t RulesProgram::getTextFlags(const String& text)
+{
+  uint8_t flags = 0;
+
+  if (text.indexOf(F("%event")) == -1) {
+    if (hasTemplateMarker(text)) {
+      flags |= RulesInstruction::NeedsTemplate;
+    }
+    return flags;
+  }
+  flags |= RulesInstruction::HasEventValue;
+
+  // Check for other markers, ignoring the %event...% variables
+  String stripped(text);
+  int    pos = stripped.indexOf(F("%event"));
+
+  while (pos != -1) {
+    const int percent_pos = stripped.indexOf('%', pos + 1);
+
+    if (percent_pos == -1) {
+      // Syntax error, leave it to parseTemplate()
+      flags |= RulesInstruction::NeedsTemplate;
+      return flags;
+    }
+    stripped.remove(pos, percent_pos - pos + 1);
+    pos = stripped.indexOf(F("%event"));
+  }
+
+  if (hasTemplateMarker(stripped)) {
+    flags |= RulesInstruction::NeedsTemplate;
+  }
+  return flags;
+}
+
+bool RulesProgram::hasTemplateMarker(const String& text)
+{
+  return (text.indexOf('%') != -1) ||
+         (text.indexOf('[') != -1) ||
+         (text.indexOf('{') != -1);
+}
+
+#endif // if FEATURE_RULES_COMPILED
@@ -0,0 +1,123 @@
+#ifndef DATASTRUCTS_RULESPROGRAM_H
+#define DATASTRUCTS_RULESPROGRAM_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RULES_COMPILED
+
+# include <vector>
+
+/*********************************************************************************************\
+* RulesProgram
+* Compiled representation of the rules files.
+*
+* Each "on ... do" block is compiled once into a flat list of instructions.
+* Flow control (if/elseif/else/endif) is resolved into jump targets at compile time,
+* so skipped branches are never visited and no line needs to be re-read, trimmed,
+* lower-cased or checked for keywords when processing an event.
+* Lines which do not contain any %...%, [...] or {...} markers are executed
+* straight from the text pool without any String copy.
+* Lines with only %event...% variables skip parseTemplate(), unless the event values add markers.
+\*********************************************************************************************/
+
+enum class RulesOpcode : uint8_t {
+  On,      // Start of a block, 'end' points to the matching EndOn
+  EndOn,
+  If,      // 'next' points to the next ElseIf/Else/EndIf on the same level, 'end' to the EndIf
+  ElseIf,  // Same as If
+  Else,    // 'end' points to the matching EndIf
+  EndIf,
+  Command
+};
+
+struct RulesInstruction {
+  enum Flags : uint8_t {
+    HasEventValue   = 1 << 0, // Line contains "%event", call substitute_eventvalue()
+    NeedsTemplate   = 1 << 1, // Line contains '%', '[' or '{' other than %event...%, call parseTemplate()
+    Restricted      = 1 << 2, // Execute command as restricted
+    NestingExceeded = 1 << 3  // If-nesting level exceeded, whole if-block is skipped
+  };
+
+  RulesInstruction(RulesOpcode opcode, uint32_t textOffset)
+    : _opcode(opcode), _textOffset(textOffset) {}
+
+  bool hasFlag(Flags flag) const {
+    return (_flags & flag) != 0;
+  }
+
+  RulesOpcode _opcode;
+  uint8_t     _flags = 0;
+  uint16_t    _next  = 0;
+  uint16_t    _end   = 0;
+  uint32_t    _textOffset;
+};
+
+class RulesProgram {
+public:
+
+  RulesProgram() = default;
+
+  void     clear();
+
+  // Compile a single (already trimmed and comment stripped) rules line.
+  // isOnLine must be set when the line was accepted as "on ... do" line by the RulesEventCache
+  // to keep the block index aligned with the event cache index.
+  void     addLine(const String& line,
+                   bool          isOnLine);
+
+  // Close any open block at the end of a rules file.
+  void     endFile();
+
+  // Resolve the instruction index of the On instruction for the N-th block.
+  bool     getBlockStart(size_t    blockIndex,
+                         uint16_t& pc) const;
+
+  size_t   size() const {
+    return _instructions.size();
+  }
+
+  const RulesInstruction& operator[](uint16_t pc) const {
+    return _instructions[pc];
+  }
+
+  // Zero terminated text belonging to the instruction.
+  const char* getText(const RulesInstruction& instruction) const {
+    return &_text[instruction._textOffset];
+  }
+
+  // Line contains '%', '[' or '{' and thus needs parseTemplate()
+  static bool hasTemplateMarker(const String& text);
+
+  // Incremented every time the program is cleared, to detect changes while running.
+  uint32_t generation() const {
+    return _generation;
+  }
+
+  size_t   getMemorySize() const;
+
+private:
+
+  uint16_t emit(RulesOpcode   opcode,
+                const String& text,
+                uint8_t       flags);
+
+  void     closeIfBlock(uint16_t pc);
+
+  void     closeBlock();
+
+  static uint8_t getTextFlags(const String& text);
+
+  std::vector<RulesInstruction> _instructions;
+  std::vector<char>             _text;
+  std::vector<uint16_t>         _blockStart;
+
+  // Index of the last branch instruction (If/ElseIf/Else) per open if-level
+  std::vector<uint16_t> _ifStack;
+  uint16_t              _openBlock  = 0;
+  bool                  _inBlock    = false;
+  uint32_t              _generation = 0;
+};
+
+#endif // if FEATURE_RULES_COMPILED
+
+#endif // ifndef DATASTRUCTS_RULESPROGRAM_H
@@ -0,0 +1,148 @@
+#include "../DataStructs/TaskNameIndex.h"
+
+#include "../../_Plugin_Helper.h"
+#include "../Globals/Cache.h"
+#include "../Globals/Plugins.h"
+#include "../Globals/Settings.h"
+
+#include <algorithm>
+#include <ctype.h>
+
+bool TaskNameIndex::Entry::operator<(const Entry& other) const
+{
+  if (hashHigh != other.hashHigh) { return hashHigh < other.hashHigh; }
+
+  if (hashLow != other.hashLow) { return hashLow < other.hashLow; }
+
+  if (taskIndex != other.taskIndex) { return taskIndex < other.taskIndex; }
+  return valueNr < other.valueNr;
+}
+
+TaskNameIndex::TaskNameIndex()
+{
+  clear();
+}
+
+taskIndex_t TaskNameIndex::findTask(const String& taskName, bool allowDisabled)
+{
+  if (taskName.isEmpty()) {
+    return INVALID_TASK_INDEX;
+  }
+  update();
+
+  const Entry key = makeKey(taskName, 0, 0);
+
+  for (auto it = std::lower_bound(_entries.begin(), _entries.end(), key);
+       it != _entries.end() && sameHash(*it, key);
+       ++it) {
+    if ((it->valueNr == VARS_PER_TASK) &&
+        (it->length == key.length) &&
+        (allowDisabled || Settings.TaskDeviceEnabled[it->taskIndex])) {
+      return it->taskIndex;
+    }
+  }
+  return INVALID_TASK_INDEX;
+}
+
+uint8_t TaskNameIndex::findValue(const String& valueName, taskIndex_t taskIndex)
+{
+  if (valueName.isEmpty() || !validTaskIndex(taskIndex)) {
+    return VARS_PER_TASK;
+  }
+  update();
+
+  const Entry key = makeKey(valueName, taskIndex, 0);
+
+  for (auto it = std::lower_bound(_entries.begin(), _entries.end(), key);
+       it != _entries.end() && sameHash(*it, key) && it->taskIndex == taskIndex;
+       ++it) {
+    if ((it->valueNr < VARS_PER_TASK) && (it->length == key.length)) {
+      return it->valueNr;
+    }
+  }
+  return VARS_PER_TASK;
+}
+
+void TaskNameIndex::invalidate(taskIndex_t taskIndex)
+{
+  if (validTaskIndex(taskIndex)) {
+    _invalidated[taskIndex] = true;
+    _anyInvalidated         = true;
+  }
+}
+
+void TaskNameIndex::clear()
+{
+  _entries.clear();
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    _invalidated[taskIndex] = true;
+  }
+  _anyInvalidated = true;
+}
+
+TaskNameIndex::Entry TaskNameIndex::makeKey(const String& name, taskIndex_t taskIndex, uint8_t valueNr)
+{
+  // 64-bit FNV-1a of the lower case name
+  uint64_t hash = 14695981039346656037ull;
+
+  for (size_t i = 0; i < name.length(); ++i) {
+    hash ^= static_cast<uint8_t>(tolower(static_cast<unsigned char>(name[i])));
+    hash *= 1099511628211ull;
+  }
+  const uint8_t length = name.length() > 255 ? 255 : static_cast<uint8_t>(name.length());
+
+  return { static_cast<uint32_t>(hash >> 32), static_cast<uint32_t>(hash), taskIndex, valueNr, length };
+}
+
+void TaskNameIndex::update()
+{
+  if (!_anyInvalidated) {
+    return;
+  }
+  _anyInvalidated = false;
+
+  _entries.erase(
+    std::remove_if(_entries.begin(), _entries.end(),
+                   [this](const Entry& entry) {
+      return _invalidated[entry.taskIndex];
+    }),
+    _entries.end());
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (_invalidated[taskIndex]) {
+      addTask(taskIndex);
+
+      // Loading the task settings to get the names may invalidate the task again.
+      _invalidated[taskIndex] = false;
+    }
+  }
+  std::sort(_entries.begin(), _entries.end());
+}
+
+void TaskNameIndex::addTask(taskIndex_t taskIndex)
+{
+  if (!validDeviceIndex(getDeviceIndex_from_TaskIndex(taskIndex))) {
+    // No plugin assigned, so no names to look for.
+    return;
+  }
+  addEntry(Cache.getTaskDeviceName(taskIndex), taskIndex, VARS_PER_TASK);
+
+  const uint8_t valueCount = getValueCountForTask(taskIndex);
+
+  for (uint8_t valueNr = 0; valueNr < valueCount && valueNr < VARS_PER_TASK; ++valueNr) {
+    addEntry(Cache.getTaskDeviceValueName(taskIndex, valueNr), taskIndex, valueNr);
+  }
+}
+
+void TaskNameIndex::addEntry(const String& name, taskIndex_t taskIndex, uint8_t valueNr)
+{
+  if (name.isEmpty() || (name.length() > 255)) {
+    return;
+  }
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  _entries.push_back(makeKey(name, taskIndex, valueNr));
+}
@@ -0,0 +1,81 @@
+#ifndef DATASTRUCTS_TASKNAMEINDEX_H
+#define DATASTRUCTS_TASKNAMEINDEX_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+#include <vector>
+
+/*********************************************************************************************\
+* TaskNameIndex
+* Index of the task names and task value names, to find a task or task value by name.
+* Names are stored as 64-bit hash of the lower case name, sorted in a flat array.
+* A name matches when hash, length and task index match, collisions are negligible.
+* Thus a lookup allocates no memory and never loads any task settings.
+*
+* Entries of a task are updated on the next lookup after the task is invalidated.
+\*********************************************************************************************/
+class TaskNameIndex {
+public:
+
+  TaskNameIndex();
+
+  // Find the first task with given name, case insensitive.
+  // Return INVALID_TASK_INDEX when not found.
+  taskIndex_t findTask(const String& taskName,
+                       bool          allowDisabled);
+
+  // Find the first task value of the task with given name, case insensitive.
+  // Return VARS_PER_TASK when not found.
+  uint8_t     findValue(const String& valueName,
+                        taskIndex_t   taskIndex);
+
+  // Names of the task may have changed
+  void        invalidate(taskIndex_t taskIndex);
+
+  void        clear();
+
+  size_t      size() const {
+    return _entries.size();
+  }
+
+private:
+
+  struct Entry {
+    uint32_t    hashHigh;
+    uint32_t    hashLow;
+    taskIndex_t taskIndex;
+    uint8_t     valueNr; // VARS_PER_TASK for the task name
+    uint8_t     length;
+
+    bool operator<(const Entry& other) const;
+  };
+
+  // Entry with the 64-bit hash of the name
+  static Entry    makeKey(const String& name,
+                          taskIndex_t   taskIndex,
+                          uint8_t       valueNr);
+
+  static bool     sameHash(const Entry& a,
+                           const Entry& b) {
+    return a.hashHigh == b.hashHigh && a.hashLow == b.hashLow;
+  }
+
+  // Update the entries of the invalidated tasks
+  void            update();
+
+  void            addTask(taskIndex_t taskIndex);
+
+  void            addEntry(const String& name,
+                           taskIndex_t   taskIndex,
+                           uint8_t       valueNr);
+
+  // Sorted by hash, taskIndex, valueNr
+  std::vector<Entry> _entries;
+
+  bool _invalidated[TASKS_MAX]{};
+  bool _anyInvalidated = true;
+};
+
+#endif // ifndef DATASTRUCTS_TASKNAMEINDEX_H
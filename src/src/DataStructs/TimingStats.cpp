@@ -10,6 +10,10 @@
 std::map<int, TimingStats> pluginStats;
 std::map<int, TimingStats> controllerStats;
 std::map<TimingStatsElements, TimingStats> miscStats;
+# if FEATURE_EXTENDED_METRICS
+std::map<int, TimingHistogram> pluginHistograms;
+std::map<int, TimingHistogram> controllerHistograms;
+# endif // if FEATURE_EXTENDED_METRICS
 unsigned long timingstats_last_reset(0);
 
 
@@ -58,6 +62,56 @@ bool TimingStats::thresholdExceeded(const uint64_t& threshold) const {
   return _maxVal > threshold;
 }
 
+# if FEATURE_EXTENDED_METRICS
+
+void TimingHistogram::add(int64_t time) {
+  if (time < 0) { time = 0; }
+  ++_count;
+  _sum += time;
+
+  for (uint8_t bucket = 0; bucket < TIMING_HISTOGRAM_NR_BUCKETS; ++bucket) {
+    if (time <= static_cast<int64_t>(getBucketBound(bucket))) {
+      ++_buckets[bucket];
+      return;
+    }
+  }
+}
+
+uint32_t TimingHistogram::getBucketBound(uint8_t bucket) {
+  constexpr uint32_t bounds[TIMING_HISTOGRAM_NR_BUCKETS] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000 };
+
+  if (bucket >= TIMING_HISTOGRAM_NR_BUCKETS) { return 0xFFFFFFFF; }
+  return bounds[bucket];
+}
+
+const __FlashStringHelper * TimingHistogram::getBucketLabel(uint8_t bucket) {
+  switch (bucket) {
+    case 0: return F("0.0001");
+    case 1: return F("0.0005");
+    case 2: return F("0.001");
+    case 3: return F("0.005");
+    case 4: return F("0.01");
+    case 5: return F("0.05");
+    case 6: return F("0.1");
+    case 7: return F("0.5");
+    case 8: return F("1");
+  }
+  return F("+Inf");
+}
+
+uint32_t TimingHistogram::getCumulativeCount(uint8_t bucket) const {
+  if (bucket >= TIMING_HISTOGRAM_NR_BUCKETS) { return _count; }
+  uint32_t res = 0;
+
+  for (uint8_t i = 0; i <= bucket; ++i) {
+    res += _buckets[i];
+  }
+  return res;
+}
+
+# endif // if FEATURE_EXTENDED_METRICS
+
 /********************************************************************************************\
    Functions used for displaying timing stats
  \*********************************************************************************************/
@@ -237,6 +291,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::WIFI_ISCONNECTED_STATS:     return F("WiFi.isConnected()");
     case TimingStatsElements::WIFI_NOTCONNECTED_STATS:    return F("WiFi.isConnected() (fail)");
     case TimingStatsElements::LOAD_TASK_SETTINGS:         return F("LoadTaskSettings()");
+    case TimingStatsElements::LOAD_TASK_SETTINGS_C:       return F("LoadTaskSettings() (cached)");
     case TimingStatsElements::SAVE_TASK_SETTINGS:         return F("SaveTaskSettings()");
     case TimingStatsElements::LOAD_CONTROLLER_SETTINGS:   return F("LoadControllerSettings()");
     #ifdef ESP32
@@ -250,6 +305,8 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::RULES_PARSE_LINE:           return F("parseCompleteNonCommentLine()");
     case TimingStatsElements::RULES_PROCESS_MATCHED:      return F("processMatchedRule()");
     case TimingStatsElements::RULES_MATCH:                return F("rulesMatch()");
+    case TimingStatsElements::RULES_COMPILE:              return F("rulesCompile()");
+    case TimingStatsElements::RULES_RUN_PROGRAM:          return F("rulesProcessingProgram()");
     case TimingStatsElements::GRAT_ARP_STATS:             return F("sendGratuitousARP()");
     case TimingStatsElements::SAVE_TO_RTC:                return F("saveToRTC()");
     case TimingStatsElements::BACKGROUND_TASKS:           return F("backgroundtasks()");
@@ -323,12 +380,26 @@ String getMiscStatsName(TimingStatsElements stat) {
 
 void stopTimerTask(deviceIndex_t T, int F, uint64_t statisticsTimerStart)
 {
-  if (mustLogFunction(F)) { pluginStats[static_cast<int>(T.value) * 256 + (F)].add(usecPassedSince(statisticsTimerStart)); }
+  if (mustLogFunction(F)) {
+    const int64_t duration = usecPassedSince(statisticsTimerStart);
+    const int     key      = static_cast<int>(T.value) * 256 + (F);
+    pluginStats[key].add(duration);
+    # if FEATURE_EXTENDED_METRICS
+    pluginHistograms[key].add(duration);
+    # endif // if FEATURE_EXTENDED_METRICS
+  }
 }
 
 void stopTimerController(protocolIndex_t T, CPlugin::Function F, uint64_t statisticsTimerStart)
 {
-  if (mustLogCFunction(F)) { controllerStats[static_cast<int>(T) * 256 + static_cast<int>(F)].add(usecPassedSince(statisticsTimerStart)); }
+  if (mustLogCFunction(F)) {
+    const int64_t duration = usecPassedSince(statisticsTimerStart);
+    const int     key      = static_cast<int>(T) * 256 + static_cast<int>(F);
+    controllerStats[key].add(duration);
+    # if FEATURE_EXTENDED_METRICS
+    controllerHistograms[key].add(duration);
+    # endif // if FEATURE_EXTENDED_METRICS
+  }
 }
 
 void stopTimer(TimingStatsElements L, uint64_t statisticsTimerStart)
@@ -79,6 +79,8 @@ enum class TimingStatsElements {
   RULES_PROCESSING,
   RULES_PROCESS_MATCHED,
   RULES_PARSE_LINE,
+  RULES_COMPILE,
+  RULES_RUN_PROGRAM,
   COMMAND_EXEC_INTERNAL,
   COMMAND_DECODE_INTERNAL,
   CONSOLE_LOOP,
@@ -87,6 +89,7 @@ enum class TimingStatsElements {
   // Related to file access
   LOADFILE_STATS,
   LOAD_TASK_SETTINGS,
+  LOAD_TASK_SETTINGS_C,
   LOAD_CUSTOM_TASK_STATS,
   LOAD_CONTROLLER_SETTINGS,
   #ifdef ESP32
@@ -160,6 +163,45 @@ private:
   uint64_t _minVal;
 };
 
+# if FEATURE_EXTENDED_METRICS
+
+// Number of buckets of TimingHistogram, excluding the "+Inf" bucket
+#  define TIMING_HISTOGRAM_NR_BUCKETS  9
+
+// Histogram of durations, exported on the /metrics page.
+// Unlike TimingStats, it is never reset, so the counts can be used as Prometheus counters.
+class TimingHistogram {
+public:
+
+  void     add(int64_t time);
+
+  // Upper bound of the bucket in usec
+  static uint32_t                   getBucketBound(uint8_t bucket);
+
+  // Upper bound of the bucket in seconds, as used for the Prometheus "le" label
+  static const __FlashStringHelper* getBucketLabel(uint8_t bucket);
+
+  // Number of durations less than or equal to the upper bound of the bucket
+  uint32_t getCumulativeCount(uint8_t bucket) const;
+
+  uint32_t getCount() const {
+    return _count;
+  }
+
+  // Sum of all durations in usec
+  uint64_t getSum() const {
+    return _sum;
+  }
+
+private:
+
+  uint32_t _buckets[TIMING_HISTOGRAM_NR_BUCKETS] = {};
+  uint32_t _count                                = 0;
+  uint64_t _sum                                  = 0;
+};
+
+# endif // if FEATURE_EXTENDED_METRICS
+
 
 const __FlashStringHelper* getPluginFunctionName(int function);
 bool                       mustLogFunction(int function);
@@ -181,6 +223,10 @@ void                       addMiscTimerStat(TimingStatsElements L,
 extern std::map<int, TimingStats> pluginStats;
 extern std::map<int, TimingStats> controllerStats;
 extern std::map<TimingStatsElements, TimingStats> miscStats;
+# if FEATURE_EXTENDED_METRICS
+extern std::map<int, TimingHistogram> pluginHistograms;
+extern std::map<int, TimingHistogram> controllerHistograms;
+# endif // if FEATURE_EXTENDED_METRICS
 extern unsigned long timingstats_last_reset;
 
 # define START_TIMER const uint64_t statisticsTimerStart(getMicros64());
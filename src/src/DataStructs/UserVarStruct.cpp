@@ -8,6 +8,7 @@
 #include "../Globals/RulesCalculate.h"
 #include "../Helpers/_Plugin_SensorTypeHelper.h"
 #include "../Helpers/CRC_functions.h"
+#include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
@@ -17,12 +18,16 @@ void UserVarStruct::clear()
 {
   for (size_t i = 0; i < TASKS_MAX; ++i) {
     _rawData[i].clear();
+    markChanged(i);
   }
   _computed.clear();
 #ifndef LIMIT_BUILD_SIZE
   _preprocessedFormula.clear();
 #endif // ifndef LIMIT_BUILD_SIZE
   _prevValue.clear();
+#if FEATURE_TASKVALUE_DEADBAND
+  _lastSent.clear();
+#endif // if FEATURE_TASKVALUE_DEADBAND
 }
 
 float UserVarStruct::operator[](unsigned int index) const
@@ -58,6 +63,7 @@ unsigned long UserVarStruct::getSensorTypeLong(taskIndex_t taskIndex, bool raw)
 void UserVarStruct::setSensorTypeLong(taskIndex_t taskIndex, unsigned long value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, 0)) {
       const ESPEASY_RULES_FLOAT_TYPE tmp = value;
       applyFormulaAndSet(taskIndex, 0, tmp, Sensor_VType::SENSOR_TYPE_ULONG);
@@ -86,6 +92,7 @@ void UserVarStruct::setInt32(taskIndex_t    taskIndex,
                              int32_t        value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, varNr)) {
       const ESPEASY_RULES_FLOAT_TYPE tmp = value;
       applyFormulaAndSet(taskIndex, varNr, tmp, Sensor_VType::SENSOR_TYPE_INT32_QUAD);
@@ -114,6 +121,7 @@ uint32_t UserVarStruct::getUint32(taskIndex_t taskIndex, taskVarIndex_t varNr, b
 void UserVarStruct::setUint32(taskIndex_t taskIndex, taskVarIndex_t varNr, uint32_t value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     // setUInt32 is used to read taskvalues back from RTC
     // If FEATURE_EXTENDED_TASK_VALUE_TYPES is not enabled, this function will never be used for anything else
 #if FEATURE_EXTENDED_TASK_VALUE_TYPES
@@ -148,6 +156,7 @@ void UserVarStruct::setInt64(taskIndex_t    taskIndex,
                              int64_t        value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, varNr)) {
       const ESPEASY_RULES_FLOAT_TYPE tmp = value;
 
@@ -178,6 +187,7 @@ void UserVarStruct::setUint64(taskIndex_t    taskIndex,
                               uint64_t       value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, varNr)) {
       const ESPEASY_RULES_FLOAT_TYPE tmp = value;
 
@@ -210,6 +220,7 @@ void UserVarStruct::setFloat(taskIndex_t    taskIndex,
                              float          value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, varNr)) {
       const ESPEASY_RULES_FLOAT_TYPE tmp = value;
       applyFormulaAndSet(taskIndex, varNr, tmp, Sensor_VType::SENSOR_TYPE_QUAD);
@@ -237,6 +248,7 @@ void UserVarStruct::setDouble(taskIndex_t    taskIndex,
                               double         value)
 {
   if (validTaskIndex(taskIndex)) {
+    markChanged(taskIndex);
     if (Cache.hasFormula(taskIndex, varNr)) {
       applyFormulaAndSet(taskIndex, varNr, value, Sensor_VType::SENSOR_TYPE_DOUBLE_DUAL);
     } else {
@@ -279,6 +291,7 @@ String UserVarStruct::getAsString(taskIndex_t taskIndex, taskVarIndex_t varNr, S
 
 void UserVarStruct::set(taskIndex_t taskIndex, taskVarIndex_t varNr, const ESPEASY_RULES_FLOAT_TYPE& value, Sensor_VType sensorType)
 {
+  markChanged(taskIndex);
   applyFormulaAndSet(taskIndex, varNr, value, sensorType);
 }
 
@@ -295,6 +308,14 @@ bool UserVarStruct::isValid(taskIndex_t    taskIndex,
   return false;
 }
 
+const uint8_t * UserVarStruct::get(size_t& sizeInBytes) const
+{
+  constexpr size_t size_rawData = TASKS_MAX * sizeof(TaskValues_Data_t);
+
+  sizeInBytes = size_rawData;
+  return reinterpret_cast<const uint8_t *>(&_rawData[0]);
+}
+
 uint8_t * UserVarStruct::get(size_t& sizeInBytes)
 {
   constexpr size_t size_rawData = TASKS_MAX * sizeof(TaskValues_Data_t);
@@ -329,11 +350,24 @@ uint32_t UserVarStruct::compute_CRC32() const
 
 void UserVarStruct::clear_computed(taskIndex_t taskIndex)
 {
+  // Task settings changed
+  markChanged(taskIndex);
+
   auto it = _computed.find(taskIndex);
 
   if (it != _computed.end()) {
     _computed.erase(it);
   }
+#if FEATURE_TASKVALUE_DEADBAND
+  {
+    // Task (settings) changed, so the next read should be sent
+    auto it_sent = _lastSent.find(taskIndex);
+
+    if (it_sent != _lastSent.end()) {
+      _lastSent.erase(it_sent);
+    }
+  }
+#endif // if FEATURE_TASKVALUE_DEADBAND
 
   for (taskVarIndex_t varNr = 0; validTaskVarIndex(varNr); ++varNr) {
     const uint16_t key = makeWord(taskIndex, varNr);
@@ -356,6 +390,21 @@ void UserVarStruct::clear_computed(taskIndex_t taskIndex)
   }
 }
 
+uint32_t UserVarStruct::getChangeSequence(taskIndex_t taskIndex) const
+{
+  if (validTaskIndex(taskIndex)) {
+    return _taskChangeSequence[taskIndex];
+  }
+  return 0;
+}
+
+void UserVarStruct::markChanged(taskIndex_t taskIndex)
+{
+  if (validTaskIndex(taskIndex)) {
+    _taskChangeSequence[taskIndex] = ++_changeSequence;
+  }
+}
+
 void UserVarStruct::markPluginRead(taskIndex_t taskIndex)
 {
   struct EventStruct TempEvent(taskIndex);
@@ -367,6 +416,70 @@ void UserVarStruct::markPluginRead(taskIndex_t taskIndex)
   }
 }
 
+#if FEATURE_TASKVALUE_DEADBAND
+
+// Value must be sent when the change exceeds either the absolute or the relative deadband.
+// Without deadband set, any change must be sent.
+static bool exceedsDeadband(const ESPEASY_RULES_FLOAT_TYPE& value,
+                            const ESPEASY_RULES_FLOAT_TYPE& lastSent,
+                            float                           absolute,
+                            float                           relative)
+{
+  if (isnan(value) || isnan(lastSent)) {
+    return isnan(value) != isnan(lastSent);
+  }
+  const ESPEASY_RULES_FLOAT_TYPE diff = fabs(value - lastSent);
+
+  if ((absolute <= 0.0f) && (relative <= 0.0f)) {
+    return diff > 0;
+  }
+
+  if ((absolute > 0.0f) && (diff >= absolute)) {
+    return true;
+  }
+  // Strict compare, as the relative deadband is 0 when the last sent value is 0
+  return (relative > 0.0f) && (diff > (fabs(lastSent) * relative / 100.0f));
+}
+
+bool UserVarStruct::checkSendOnChange(taskIndex_t taskIndex, Sensor_VType sensorType)
+{
+  if (!validTaskIndex(taskIndex) ||
+      (sensorType == Sensor_VType::SENSOR_TYPE_STRING) ||
+      !Cache.sendOnChange(taskIndex)) {
+    return true;
+  }
+  const uint8_t valueCount = getValueCountFromSensorType(sensorType);
+
+  auto it       = _lastSent.find(taskIndex);
+  bool mustSend = it == _lastSent.end();
+
+  if (!mustSend) {
+    const uint16_t maxSilence = Cache.getSendOnChangeMaxSilence(taskIndex);
+
+    mustSend = (maxSilence != 0) && (timePassedSince(it->second.lastSent) >= (maxSilence * 1000l));
+  }
+
+  for (taskVarIndex_t varNr = 0; varNr < valueCount && !mustSend; ++varNr) {
+    mustSend = exceedsDeadband(
+      getAsDouble(taskIndex, varNr, sensorType),
+      it->second.values[varNr],
+      Cache.getDeadbandAbsolute(taskIndex, varNr),
+      Cache.getDeadbandRelative(taskIndex, varNr));
+  }
+
+  if (mustSend) {
+    TaskValues_LastSent& lastSent = _lastSent[taskIndex];
+
+    for (taskVarIndex_t varNr = 0; varNr < valueCount; ++varNr) {
+      lastSent.values[varNr] = getAsDouble(taskIndex, varNr, sensorType);
+    }
+    lastSent.lastSent = millis();
+  }
+  return mustSend;
+}
+
+#endif // if FEATURE_TASKVALUE_DEADBAND
+
 const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
   taskIndex_t    taskIndex,
   taskVarIndex_t varNr,
@@ -125,6 +125,8 @@ struct UserVarStruct {
                Sensor_VType   sensorType,
                bool           raw = false) const;
 
+  // Non-const accessors: Caller must call markChanged() for the tasks it writes to.
+  const uint8_t          * get(size_t& sizeInBytes) const;
   uint8_t                * get(size_t& sizeInBytes);
 
   const TaskValues_Data_t* getRawTaskValues_Data(taskIndex_t taskIndex) const;
@@ -136,6 +138,27 @@ struct UserVarStruct {
 
   void                     markPluginRead(taskIndex_t taskIndex);
 
+  // Change sequence nr, incremented each time a task value is set or task settings are changed.
+  // Starts at 0 after boot.
+  uint32_t getChangeSequence() const {
+    return _changeSequence;
+  }
+
+  // Change sequence nr of the last change of the task, 0 when not changed since boot.
+  uint32_t getChangeSequence(taskIndex_t taskIndex) const;
+
+  void     markChanged(taskIndex_t taskIndex);
+
+#if FEATURE_TASKVALUE_DEADBAND
+
+  // Send on change: Check whether any task value changed more than its deadband since the values
+  // were last sent to the controllers, or the max. silence time of the task has passed.
+  // When returning true, the current values are kept as last sent values.
+  // Always returns true for tasks without 'send on change' enabled.
+  bool checkSendOnChange(taskIndex_t  taskIndex,
+                         Sensor_VType sensorType);
+#endif // if FEATURE_TASKVALUE_DEADBAND
+
 private:
 
   const TaskValues_Data_t* getRawOrComputed(taskIndex_t    taskIndex,
@@ -173,6 +196,19 @@ private:
   mutable std::map<uint16_t, String>_preprocessedFormula;
 #endif // ifndef LIMIT_BUILD_SIZE
   mutable std::map<uint16_t, String>_prevValue;
+
+  uint32_t _taskChangeSequence[TASKS_MAX]{};
+  uint32_t _changeSequence{};
+
+#if FEATURE_TASKVALUE_DEADBAND
+  struct TaskValues_LastSent {
+    ESPEASY_RULES_FLOAT_TYPE values[VARS_PER_TASK]{};
+    uint32_t                 lastSent{};
+  };
+
+  // Only present for tasks with 'send on change' enabled, after values were sent
+  std::map<taskIndex_t, TaskValues_LastSent>_lastSent;
+#endif // if FEATURE_TASKVALUE_DEADBAND
 };
 
 #endif // ifndef DATASTRUCTS_USERVARSTRUCT_H
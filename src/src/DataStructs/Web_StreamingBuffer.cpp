@@ -20,9 +20,18 @@
 #define CHUNKED_BUFFER_SIZE         1200
 #endif
 
+// Flash strings and Strings of at least this length are sent directly
+// instead of being copied into the buffer first.
+#if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
+#define DIRECT_SEND_MIN_LENGTH      0 // Not supported, chunked transfer encoding is done by ourselves
+#else
+#define DIRECT_SEND_MIN_LENGTH      (CHUNKED_BUFFER_SIZE / 2)
+#endif
+
 Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false),
   initialRam(0), beforeTXRam(0), duringTXRam(0), finalRam(0), maxCoreUsage(0),
-  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0)
+  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0),
+  copiedBytes(0), directBytes(0)
 {
   // Make sure this is allocated on the DRAM since access to primary heap is faster
   # ifdef USE_SECOND_HEAP
@@ -104,6 +113,30 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 
   checkFull();
 
+  #if DIRECT_SEND_MIN_LENGTH > 0
+  {
+    // Only look for the end of the string as far as needed to decide whether it is worth sending directly.
+    size_t directLength = length;
+
+    if (length < 0) {
+      directLength = 0;
+
+      while (directLength < DIRECT_SEND_MIN_LENGTH && pgm_read_byte(str + directLength) != 0) {
+        ++directLength;
+      }
+    }
+
+    if (directLength >= DIRECT_SEND_MIN_LENGTH) {
+      if (length < 0) {
+        directLength += strlen_P(str + directLength);
+      }
+      flush();
+      sendContentDirect(str, directLength);
+      return *this;
+    }
+  }
+  #endif // if DIRECT_SEND_MIN_LENGTH > 0
+
   int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
   if (flush_step < 1) { flush_step = 0; }
 
@@ -150,6 +183,14 @@ Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
     return *this;
   }
 
+  #if DIRECT_SEND_MIN_LENGTH > 0
+  if (length >= DIRECT_SEND_MIN_LENGTH) {
+    flush();
+    sendContentDirect(a);
+    return *this;
+  }
+  #endif // if DIRECT_SEND_MIN_LENGTH > 0
+
   unsigned int pos = 0;
   while (pos < length) {
     if (flush_step <= 0) {
@@ -219,6 +260,8 @@ void Web_StreamingBuffer::startStream(bool allowOriginAll,
   initialRam   = ESP.getFreeHeap();
   beforeTXRam  = initialRam;
   sentBytes    = 0;
+  copiedBytes  = 0;
+  directBytes  = 0;
   buf.clear();
   buf.reserve(CHUNKED_BUFFER_SIZE);
   web_server.client().setNoDelay(true);
@@ -287,6 +330,15 @@ void Web_StreamingBuffer::endStream() {
         }
 #endif // ifndef BUILD_NO_DEBUG
 */
+#ifndef BUILD_NO_DEBUG
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
+      addLogMove(LOG_LEVEL_DEBUG_DEV, strformat(
+        F("Webpage sent: %u bytes, copied: %u direct: %u"),
+        sentBytes,
+        copiedBytes,
+        directBytes));
+    }
+#endif // ifndef BUILD_NO_DEBUG
 
   } else {
     if (loglevelActiveFor(LOG_LEVEL_ERROR))
@@ -356,7 +408,37 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
   }
 #endif // if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
 
-  sentBytes += length;
+  sentBytes   += length;
+  copiedBytes += length;
+  delay(1);
+}
+
+void Web_StreamingBuffer::sendContentDirect(PGM_P data, size_t length) {
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif
+
+  delay(0); // Try to prevent WDT reboots
+
+  // Data is read from flash while writing to the client
+  web_server.sendContent_P(data, length);
+
+  sentBytes   += length;
+  directBytes += length;
+  delay(1);
+}
+
+void Web_StreamingBuffer::sendContentDirect(const String& data) {
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif
+
+  delay(0); // Try to prevent WDT reboots
+
+  web_server.sendContent(data);
+
+  sentBytes   += data.length();
+  directBytes += data.length();
   delay(1);
 }
 
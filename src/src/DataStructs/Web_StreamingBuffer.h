@@ -26,6 +26,8 @@ public:
   unsigned int sentBytes;
   uint32_t flashStringCalls;
   uint32_t flashStringData;
+  uint32_t copiedBytes;  // Bytes sent via the buffer in the current response
+  uint32_t directBytes;  // Bytes sent directly from flash or String without copy in the current response
 
 private:
 
@@ -94,6 +96,11 @@ public:
 private: 
 
   void sendContentBlocking(String& data);
+
+  // Send data without copying it to the buffer, buffer must be flushed first.
+  void sendContentDirect(PGM_P  data,
+                         size_t length);
+  void sendContentDirect(const String& data);
   void sendHeaderBlocking(bool          allowOriginAll,
                           const String& content_type,
                           const String& origin,
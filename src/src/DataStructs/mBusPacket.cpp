@@ -6,6 +6,10 @@
 #define FRAME_FORMAT_A_FIRST_BLOCK_LENGTH 10
 #define FRAME_FORMAT_A_OTHER_BLOCK_LENGTH 16
 
+// Max. size of a decoded frame, including checksums.
+// Frame A of 256 bytes has 17 blocks, each with 2 bytes CRC.
+#define MBUS_FRAME_MAX_SIZE 290
+
 
 mBusPacket_header_t::mBusPacket_header_t()
 {
@@ -151,23 +155,35 @@ bool mBusPacket_t::parse(const String& payload)
   if (payload[0] != 'b') { return false; }
 
   _checksum = 0;
-  mBusPacket_data payloadWithoutChecksums;
 
-  if (payload[1] == 'Y') {
-    // Start with "bY"
-    payloadWithoutChecksums = removeChecksumsFrameB(payload, _checksum);
-  } else {
-    payloadWithoutChecksums = removeChecksumsFrameA(payload, _checksum);
+  int pos_semicolon = payload.indexOf(';');
+
+  if (pos_semicolon == -1) { pos_semicolon = payload.length(); }
+
+  // Start with "bY" for frame B, else "b"
+  const bool   frameB   = payload[1] == 'Y';
+  const size_t hexStart = frameB ? 2 : 1;
+
+  // Decoded frame, zero filled so a truncated message reads as 0.
+  uint8_t frame[MBUS_FRAME_MAX_SIZE]{};
+
+  if (pos_semicolon > static_cast<int>(hexStart)) {
+    decodeHex(payload.c_str() + hexStart, pos_semicolon - hexStart, frame, sizeof(frame));
   }
 
-  if (payloadWithoutChecksums.size() < 10) { return false; }
+  const size_t frameSize = frameB
+    ? removeChecksumsFrameB(frame, payload.length(), _checksum)
+    : removeChecksumsFrameA(frame, payload.length(), _checksum);
 
-  int pos_semicolon = payload.indexOf(';');
+  if (frameSize < 10) { return false; }
 
-  if (pos_semicolon == -1) { pos_semicolon = payload.length(); }
+  _lqi_rssi = 0;
 
-  _lqi_rssi = hexToUL(payload, pos_semicolon - 4, 4);
-  return parseHeaders(payloadWithoutChecksums);
+  for (int i = pos_semicolon - 4; i >= 0 && i < pos_semicolon; ++i) {
+    _lqi_rssi <<= 4;
+    _lqi_rssi  |= hexToNibble(payload[i]);
+  }
+  return parseHeaders(frame, frameSize);
 }
 
 int16_t mBusPacket_t::decode_LQI_RSSI(uint16_t lqi_rssi, uint8_t& LQI)
@@ -187,9 +203,9 @@ bool mBusPacket_t::matchSerial(uint32_t serialNr) const
   return _deviceId1.matchSerial(serialNr) || _deviceId2.matchSerial(serialNr);
 }
 
-bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
+bool mBusPacket_t::parseHeaders(const uint8_t *payloadWithoutChecksums, size_t size)
 {
-  const int payloadSize = payloadWithoutChecksums.size();
+  const int payloadSize = size;
 
   _deviceId1.clear();
   _deviceId2.clear();
@@ -303,11 +319,26 @@ String mBusPacket_t::toString() const
   return res;
 }
 
-uint8_t mBusPacket_t::hexToByte(const String& str, size_t index)
+uint8_t mBusPacket_t::hexToNibble(char c)
 {
-  // Need to have at least 2 HEX nibbles
-  if ((index + 1) >= str.length()) { return 0; }
-  return hexToUL(str, index, 2);
+  if ((c >= '0') && (c <= '9')) { return c - '0'; }
+
+  if ((c >= 'A') && (c <= 'F')) { return c - 'A' + 10; }
+
+  if ((c >= 'a') && (c <= 'f')) { return c - 'a' + 10; }
+  return 0;
+}
+
+size_t mBusPacket_t::decodeHex(const char *hex, size_t length, uint8_t *data, size_t maxSize)
+{
+  size_t size = length / 2;
+
+  if (size > maxSize) { size = maxSize; }
+
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = (hexToNibble(hex[2 * i]) << 4) | hexToNibble(hex[2 * i + 1]);
+  }
+  return size;
 }
 
 /**
@@ -318,47 +349,41 @@ uint8_t mBusPacket_t::hexToByte(const String& str, size_t index)
  * ...
  * (last block can be < 16 bytes)
  */
-mBusPacket_data mBusPacket_t::removeChecksumsFrameA(const String& payload, uint32_t& checksum)
+size_t mBusPacket_t::removeChecksumsFrameA(uint8_t *frame, size_t payloadLength, uint32_t& checksum)
 {
-  mBusPacket_data result;
-  const int payloadLength = payload.length();
-
-  if (payloadLength < 4) { return result; }
+  if (payloadLength < 4) { return 0; }
 
-  int sourceIndex = 1; // Starts with "b"
-  int targetIndex = 0;
+  size_t sourceIndex = 0;
+  size_t targetIndex = 0;
 
   // 1st byte contains length of data (excuding 1st byte and excluding CRC)
-  const int expectedMessageSize = hexToByte(payload, sourceIndex) + 1;
+  const size_t expectedMessageSize = frame[0] + 1;
 
   if (payloadLength < (2 * expectedMessageSize)) {
     // Not an exact check, but close enough to fail early on packets which are seriously too short.
-    return result;
+    return 0;
   }
 
-  result.reserve(expectedMessageSize);
-
   while (targetIndex < expectedMessageSize) {
-    // end index is start index + block size + 2 byte checksums
-    int blockSize = (sourceIndex == 1) ? FRAME_FORMAT_A_FIRST_BLOCK_LENGTH : FRAME_FORMAT_A_OTHER_BLOCK_LENGTH;
+    size_t blockSize = (sourceIndex == 0) ? FRAME_FORMAT_A_FIRST_BLOCK_LENGTH : FRAME_FORMAT_A_OTHER_BLOCK_LENGTH;
 
     if ((targetIndex + blockSize) > expectedMessageSize) { // last block
       blockSize = expectedMessageSize - targetIndex;
     }
 
-    // FIXME: handle truncated source messages
-    for (int i = 0; i < blockSize; ++i) {
-      result.push_back(hexToByte(payload, sourceIndex));
-      sourceIndex += 2; // 2 hex chars
+    // Target is never beyond source, so the CRC following the block is not overwritten.
+    if (targetIndex != sourceIndex) {
+      memmove(frame + targetIndex, frame + sourceIndex, blockSize);
     }
+    sourceIndex += blockSize;
 
     // [2 bytes CRC]
     checksum   <<= 8;
-    checksum    ^= hexToUL(payload, sourceIndex, 4);
-    sourceIndex += 4; // Skip 2 bytes CRC => 4 hex chars
+    checksum    ^= makeWord(frame[sourceIndex], frame[sourceIndex + 1]);
+    sourceIndex += 2;
     targetIndex += blockSize;
   }
-  return result;
+  return targetIndex;
 }
 
 /**
@@ -368,20 +393,15 @@ mBusPacket_data mBusPacket_t::removeChecksumsFrameA(const String& payload, uint3
  * (if message length <=126 bytes, only the 1st block exists)
  * (last block can be < 125 bytes)
  */
-mBusPacket_data mBusPacket_t::removeChecksumsFrameB(const String& payload, uint32_t& checksum)
+size_t mBusPacket_t::removeChecksumsFrameB(uint8_t *frame, size_t payloadLength, uint32_t& checksum)
 {
-  mBusPacket_data result;
-  const int payloadLength = payload.length();
-
-  if (payloadLength < 4) { return result; }
-
-  int sourceIndex = 2; // Starts with "bY"
+  if (payloadLength < 4) { return 0; }
 
   // 1st byte contains length of data (excuding 1st byte BUT INCLUDING CRC)
-  int expectedMessageSize = hexToByte(payload, sourceIndex) + 1;
+  int expectedMessageSize = frame[0] + 1;
 
-  if (payloadLength < (2 * expectedMessageSize)) {
-    return result;
+  if (payloadLength < static_cast<size_t>(2 * expectedMessageSize)) {
+    return 0;
   }
 
   expectedMessageSize -= 2;   // CRC of 1st block
@@ -390,39 +410,38 @@ mBusPacket_data mBusPacket_t::removeChecksumsFrameB(const String& payload, uint3
     expectedMessageSize -= 2; // CRC of 2nd block
   }
 
-  result.reserve(expectedMessageSize);
+  if (expectedMessageSize <= 0) { return 0; }
 
   // FIXME: handle truncated source messages
 
-  const int block1Size = expectedMessageSize < 126 ? expectedMessageSize : 126;
-
-  for (int i = 0; i < block1Size; ++i) {
-    result.push_back(hexToByte(payload, sourceIndex));
-    sourceIndex += 2; // 2 hex chars
-  }
+  // 1st block is already in place
+  const size_t block1Size = expectedMessageSize < 126 ? expectedMessageSize : 126;
+  size_t sourceIndex      = block1Size;
+  size_t size             = block1Size;
 
   // [2 bytes CRC]
   checksum   <<= 8;
-  checksum    ^= hexToUL(payload, sourceIndex, 4);
-  sourceIndex += 4; // Skip 2 bytes CRC => 4 hex chars
+  checksum    ^= makeWord(frame[sourceIndex], frame[sourceIndex + 1]);
+  sourceIndex += 2; // Skip 2 bytes CRC
 
   if (expectedMessageSize > 126) {
     int block2Size = expectedMessageSize - 127;
 
     if (block2Size > 124) { block2Size = 124; }
 
-    for (int i = 0; i < block2Size; ++i) {
-      result.push_back(hexToByte(payload, sourceIndex));
-      sourceIndex += 2; // 2 hex chars
+    if (block2Size > 0) {
+      memmove(frame + size, frame + sourceIndex, block2Size);
+      size        += block2Size;
+      sourceIndex += block2Size;
     }
 
     // [2 bytes CRC]
     checksum <<= 8;
-    checksum  ^= hexToUL(payload, sourceIndex, 4);
+    checksum  ^= makeWord(frame[sourceIndex], frame[sourceIndex + 1]);
   }
 
   // remove the checksums and the 1st byte from the actual message length, so that the meaning of this byte is the same as in Frame A
-  result[0] = static_cast<uint8_t>((expectedMessageSize - 1) & 0xff);
+  frame[0] = static_cast<uint8_t>((expectedMessageSize - 1) & 0xff);
 
-  return result;
+  return size;
 }
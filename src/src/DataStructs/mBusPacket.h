@@ -16,9 +16,6 @@
 // 0 is a valid serial and 0xFFFFFFFF seems to be reserved
 #define mBus_packet_wildcard_serial  0xFFFFFFFE
 
-
-typedef std::vector<uint8_t> mBusPacket_data;
-
 struct mBusPacket_header_t {
   mBusPacket_header_t();
 
@@ -81,15 +78,26 @@ private:
 
   static uint32_t deviceID_to_map_key(uint64_t id1, uint64_t id2);
 
-  static uint8_t         hexToByte(const String& str,
-                                   size_t        index);
-
-  static mBusPacket_data removeChecksumsFrameA(const String& payload,
-                                               uint32_t    & checksum);
-  static mBusPacket_data removeChecksumsFrameB(const String& payload,
-                                               uint32_t    & checksum);
-
-  bool                   parseHeaders(const mBusPacket_data& payloadWithoutChecksums);
+  static uint8_t hexToNibble(char c);
+
+  // Decode the HEX string into data.
+  // Return the nr of bytes decoded.
+  static size_t  decodeHex(const char *hex,
+                           size_t      length,
+                           uint8_t    *data,
+                           size_t      maxSize);
+
+  // Remove the checksums from the decoded frame, in place.
+  // Return the size of the frame without checksums.
+  static size_t removeChecksumsFrameA(uint8_t  *frame,
+                                      size_t    payloadLength,
+                                      uint32_t& checksum);
+  static size_t removeChecksumsFrameB(uint8_t  *frame,
+                                      size_t    payloadLength,
+                                      uint32_t& checksum);
+
+  bool          parseHeaders(const uint8_t *payloadWithoutChecksums,
+                             size_t         size);
 
 public:
 
@@ -40,7 +40,7 @@ constexpr pluginID_t PLUGIN_ID_MQTT_IMPORT(37);
 // ********************************************************************************
 // Interface for Sending to Controllers
 // ********************************************************************************
-void sendData(struct EventStruct *event, bool sendEvents)
+void sendData(struct EventStruct *event, bool sendEvents, bool sendToControllers)
 {
   START_TIMER;
   #ifndef BUILD_NO_RAM_TRACKER
@@ -58,7 +58,7 @@ void sendData(struct EventStruct *event, bool sendEvents)
 
   //  LoadTaskSettings(event->TaskIndex); // could have changed during background tasks.
 
-  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; x++)
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX && sendToControllers; x++)
   {
     if (Settings.ControllerEnabled[x] &&
         Settings.TaskDeviceSendData[x][event->TaskIndex] &&
@@ -137,20 +137,20 @@ void incoming_mqtt_callback(char *c_topic, uint8_t *b_payload, unsigned int leng
     CPlugin::Function::CPLUGIN_PROTOCOL_RECV,
     c_topic, b_payload, length);
 
+#ifdef USES_P037
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_ID_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
 
   if (validDeviceIndex(DeviceIndex)) {
-    //  Here we loop over all tasks and call each 037 plugin with function PLUGIN_MQTT_IMPORT
-    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
-    {
-      if (Settings.TaskDeviceEnabled[taskIndex] && (Settings.getPluginID_for_task(taskIndex) == PLUGIN_ID_MQTT_IMPORT))
-      {
-        Scheduler.schedule_mqtt_plugin_import_event_timer(
-          DeviceIndex, taskIndex, PLUGIN_MQTT_IMPORT,
-          c_topic, b_payload, length);
-      }
+    // Only the 037 tasks subscribed to this topic get PLUGIN_MQTT_IMPORT, all sharing a single copy of the message
+    const MQTT_taskMask_t tasks = P037_MQTT_router.getTasks(c_topic);
+
+    if (tasks != 0) {
+      Scheduler.schedule_mqtt_plugin_import_event_timer(
+        DeviceIndex, tasks, PLUGIN_MQTT_IMPORT,
+        c_topic, b_payload, length);
     }
   }
+#endif // ifdef USES_P037
 }
 
 /*********************************************************************************************\
@@ -827,9 +827,9 @@ bool MQTTpublish(controllerIndex_t controller_idx,
     return false;
   }
   const bool success =
-    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex, topic,
-                                                                                                           payload, retained,
-                                                                                                           callbackTask)));
+    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (MQTTDelayHandler->elementPool) MQTT_queue_element(controller_idx, taskIndex, topic,
+                                                                                                                            payload, retained,
+                                                                                                                            callbackTask)));
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -850,10 +850,10 @@ bool MQTTpublish(controllerIndex_t controller_idx,
   }
 
   const bool success =
-    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex,
-                                                                                                           std::move(topic),
-                                                                                                           std::move(payload), retained,
-                                                                                                           callbackTask)));
+    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (MQTTDelayHandler->elementPool) MQTT_queue_element(controller_idx, taskIndex,
+                                                                                                                            std::move(topic),
+                                                                                                                            std::move(payload), retained,
+                                                                                                                            callbackTask)));
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -997,7 +997,22 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
     String dummy;
 
     if (PluginCall(PLUGIN_READ, &TempEvent, dummy)) {
+      #if FEATURE_TASKVALUE_DEADBAND
+
+      // Rules events are always processed, controllers only get values which changed enough
+      const bool sendToControllers = UserVar.checkSendOnChange(TempEvent.TaskIndex, TempEvent.getSensorType());
+      # ifndef BUILD_NO_DEBUG
+
+      if (!sendToControllers && loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+        addLogMove(LOG_LEVEL_DEBUG, concat(
+                     F("Send on change: Values within deadband, not sent to controllers: "),
+                     getTaskDeviceName(TempEvent.TaskIndex)));
+      }
+      # endif // ifndef BUILD_NO_DEBUG
+      sendData(&TempEvent, true, sendToControllers);
+      #else // if FEATURE_TASKVALUE_DEADBAND
       sendData(&TempEvent);
+      #endif // if FEATURE_TASKVALUE_DEADBAND
     }
   }
 }
@@ -9,7 +9,9 @@
 // ********************************************************************************
 // Interface for Sending to Controllers
 // ********************************************************************************
-void sendData(struct EventStruct *event, bool sendEvents = true);
+void sendData(struct EventStruct *event,
+              bool                sendEvents        = true,
+              bool                sendToControllers = true);
 
 bool validUserVar(struct EventStruct *event);
 
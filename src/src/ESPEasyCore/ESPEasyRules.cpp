@@ -106,12 +106,19 @@ void rulesProcessing(const String& event) {
     bool eventHandled = false;
 
     if (Settings.EnableRulesCaching()) {
+      #if FEATURE_RULES_COMPILED
+      uint16_t pc = 0;
+      if (Cache.rulesHelper.findMatchingBlock(event, pc)) {
+        eventHandled = rulesProcessingProgram(event, pc);
+      }
+      #else // if FEATURE_RULES_COMPILED
       String filename;
       size_t pos = 0;
       if (Cache.rulesHelper.findMatchingRule(event, filename, pos)) {
         const bool startOnMatched = true; // We already matched the event
         eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
       }
+      #endif // if FEATURE_RULES_COMPILED
     } else {
       for (uint8_t x = 0; x < RULESETS_MAX && !eventHandled; x++) {
         eventHandled = rulesProcessingFile(getRulesFileName(x), event);
@@ -235,6 +242,188 @@ bool rulesProcessingFile(const String& fileName,
   return eventHandled; // && nestingLevel == 0;
 }
 
+#if FEATURE_RULES_COMPILED
+
+/********************************************************************************************\
+   Rules processing of a compiled "on ... do" block
+ \*********************************************************************************************/
+// Return true when the line was changed
+bool rulesProgramSubstitute(const RulesInstruction& instruction,
+                            String                & line,
+                            const String          & event)
+{
+  const bool hasCallBacks = (substitute_eventvalue_CallBack_ptr != nullptr) ||
+                            (parseTemplate_CallBack_ptr != nullptr);
+
+  if (instruction.hasFlag(RulesInstruction::HasEventValue) || hasCallBacks) {
+    substitute_eventvalue(line, event);
+
+    if (instruction.hasFlag(RulesInstruction::NeedsTemplate) ||
+        hasCallBacks ||
+        RulesProgram::hasTemplateMarker(line)) {
+      line = parseTemplate(line);
+    }
+    return true;
+  }
+
+  if (instruction.hasFlag(RulesInstruction::NeedsTemplate)) {
+    line = parseTemplate(line);
+    return true;
+  }
+  return false;
+}
+
+bool rulesProgramConditionMatch(const RulesProgram    & program,
+                                const RulesInstruction& instruction,
+                                const String          & event,
+                                uint8_t                 ifLevel)
+{
+  String check(program.getText(instruction));
+
+  if (rulesProgramSubstitute(instruction, check, event)) {
+    check.toLowerCase();
+    check.trim();
+  }
+  const bool result = conditionMatchExtended(check);
+
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(
+                 F("Lev.%d: [%s %s]=%s"),
+                 ifLevel,
+                 instruction._opcode == RulesOpcode::If ? "if" : "elseif",
+                 check.c_str(),
+                 FsP(boolToString(result))));
+  }
+#else // ifndef BUILD_NO_DEBUG
+  (void)ifLevel; // To avoid compiler warning
+#endif // ifndef BUILD_NO_DEBUG
+  return result;
+}
+
+void rulesProgramExecuteCommand(const RulesProgram    & program,
+                                const RulesInstruction& instruction,
+                                const String          & event)
+{
+  const EventValueSource::Enum source = instruction.hasFlag(RulesInstruction::Restricted)
+    ? EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED
+    : EventValueSource::Enum::VALUE_SOURCE_RULES;
+
+  if (!instruction.hasFlag(RulesInstruction::NeedsTemplate) &&
+      !instruction.hasFlag(RulesInstruction::HasEventValue) &&
+      (substitute_eventvalue_CallBack_ptr == nullptr) &&
+      (parseTemplate_CallBack_ptr == nullptr)) {
+    // Static command, no need to make a copy first.
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLogMove(LOG_LEVEL_INFO, concat(
+                   source == EventValueSource::Enum::VALUE_SOURCE_RULES ? F("ACT  : ") : F("ACT  : (restricted) "),
+                   program.getText(instruction)));
+    }
+    ExecuteCommand_all({ source, program.getText(instruction) });
+    return;
+  }
+
+  String action(program.getText(instruction));
+
+  rulesProgramSubstitute(instruction, action, event);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLog(LOG_LEVEL_INFO, concat(
+             source == EventValueSource::Enum::VALUE_SOURCE_RULES ? F("ACT  : ") : F("ACT  : (restricted) "),
+             action));
+  }
+  ExecuteCommand_all({ source, std::move(action) });
+}
+
+bool rulesProcessingProgram(const String& event, uint16_t pc)
+{
+  static uint8_t nestingLevel = 0;
+
+  if (nestingLevel >= RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    return false;
+  }
+  ++nestingLevel;
+  START_TIMER
+
+  // Executing a command may trigger a reload of the rules.
+  // Keep track of the program generation to stop processing when it has changed.
+  const RulesProgram& program = Cache.rulesHelper.getProgram();
+  const uint32_t generation   = program.generation();
+  uint8_t ifLevel             = 0;
+  bool    done                = false;
+
+  ++pc; // Skip the On instruction, event already matched
+
+  while (!done && pc < program.size() && generation == program.generation()) {
+    const RulesInstruction& instruction = program[pc];
+
+    switch (instruction._opcode) {
+      case RulesOpcode::On:
+      case RulesOpcode::EndOn:
+        done = true;
+        break;
+      case RulesOpcode::If:
+
+        if (instruction.hasFlag(RulesInstruction::NestingExceeded)) {
+          addLog(LOG_LEVEL_ERROR, strformat(F("Lev.%d: Error: IF Nesting level exceeded!"), ifLevel));
+          pc = instruction._end + 1;
+          break;
+        }
+        ++ifLevel;
+
+        // Try all branches until a matching condition or 'else' is found
+        while (true) {
+          const RulesInstruction& branch = program[pc];
+
+          if ((branch._opcode == RulesOpcode::Else) ||
+              (((branch._opcode == RulesOpcode::If) || (branch._opcode == RulesOpcode::ElseIf)) &&
+               rulesProgramConditionMatch(program, branch, event, ifLevel))) {
+            ++pc;
+            break;
+          }
+
+          if ((branch._opcode != RulesOpcode::If) && (branch._opcode != RulesOpcode::ElseIf)) {
+            // Reached EndIf or EndOn
+            if (branch._opcode == RulesOpcode::EndIf) {
+              --ifLevel;
+              ++pc;
+            }
+            break;
+          }
+          pc = branch._next;
+        }
+        break;
+      case RulesOpcode::ElseIf:
+      case RulesOpcode::Else:
+        // Reached the end of the executed branch, continue after the matching EndIf
+        pc = instruction._end;
+
+        if (program[pc]._opcode == RulesOpcode::EndIf) {
+          --ifLevel;
+          ++pc;
+        }
+        break;
+      case RulesOpcode::EndIf:
+
+        if (ifLevel > 0) { --ifLevel; }
+        ++pc;
+        break;
+      case RulesOpcode::Command:
+        rulesProgramExecuteCommand(program, instruction, event);
+        delay(0);
+        ++pc;
+        break;
+    }
+  }
+  STOP_TIMER(RULES_RUN_PROGRAM);
+  --nestingLevel;
+  backgroundtasks();
+  return true;
+}
+
+#endif // if FEATURE_RULES_COMPILED
 
 /********************************************************************************************\
    Parse string commands
@@ -38,6 +38,16 @@ bool rulesProcessingFile(const String& fileName,
                          size_t pos = 0,
                          bool   startOnMatched = false);
 
+#if FEATURE_RULES_COMPILED
+
+/********************************************************************************************\
+   Rules processing of a compiled "on ... do" block
+   @param pc  Index of the On instruction of the matched block.
+   Return true when event was handled.
+ \*********************************************************************************************/
+bool rulesProcessingProgram(const String& event,
+                            uint16_t      pc);
+#endif // if FEATURE_RULES_COMPILED
 
 
 /********************************************************************************************\
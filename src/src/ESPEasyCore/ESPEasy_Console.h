@@ -34,8 +34,16 @@ public:
 
   String getPortDescription() const;
 
+  const SerialWriteBuffer_t& getWriteBuffer() const {
+    return _mainSerial._serialWriteBuffer;
+  }
+
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
   String getFallbackPortDescription() const;
+
+  const SerialWriteBuffer_t& getFallbackWriteBuffer() const {
+    return _fallbackSerial._serialWriteBuffer;
+  }
 #endif
 
 
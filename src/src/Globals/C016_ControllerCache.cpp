@@ -4,9 +4,12 @@
 
 
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ESPEasyControllerCache_index.h"
 
 ControllerCache_struct ControllerCache;
 
+ESPEasyControllerCache_index ControllerCacheIndex;
+
 void C016_flush() {
   ControllerCache.flush();
 }
@@ -24,6 +27,7 @@ bool C016_deleteOldestCacheBlock() {
 }
 
 bool C016_deleteAllCacheBlocks() {
+  ControllerCacheIndex.clear();
   return ControllerCache.deleteAllCacheBlocks();
 }
 
@@ -31,6 +35,17 @@ bool C016_getTaskSample(C016_binary_element& element) {
   return ControllerCache.peek((uint8_t *)&element, sizeof(element));
 }
 
+bool C016_seekTaskSample(uint32_t startTime, taskIndex_t taskIndex) {
+  int fileNr  = 0;
+  int readPos = 0;
+
+  if (!ControllerCacheIndex.find(startTime, taskIndex, fileNr, readPos)) {
+    return false;
+  }
+  ControllerCache.setPeekFilePos(fileNr, readPos);
+  return true;
+}
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
@@ -28,6 +28,12 @@ bool   C016_deleteAllCacheBlocks();
 
 bool   C016_getTaskSample(C016_binary_element& element);
 
+// Set the peek position to the first sample with a timestamp >= startTime.
+// When taskIndex is a valid task index, only samples of that task are considered.
+// Return false (peek position unchanged) when no such sample is present in the cache files.
+bool   C016_seekTaskSample(uint32_t    startTime,
+                           taskIndex_t taskIndex = INVALID_TASK_INDEX);
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
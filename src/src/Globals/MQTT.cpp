@@ -34,4 +34,6 @@ LongTermTimer MQTTclient_next_connect_attempt;
 
 // mqtt import status
 bool P037_MQTTImport_connected = false;
+
+MQTT_subscription_router P037_MQTT_router;
 #endif // ifdef USES_P037
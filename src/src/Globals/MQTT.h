@@ -35,9 +35,13 @@ extern LongTermTimer MQTTclient_next_connect_attempt;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
+# include "../DataStructs/MQTT_subscription_router.h"
 
 // mqtt import status
 extern bool P037_MQTTImport_connected;
+
+// Subscriptions of all MQTT import tasks
+extern MQTT_subscription_router P037_MQTT_router;
 #endif // ifdef USES_P037
 
 
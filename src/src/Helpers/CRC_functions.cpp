@@ -106,3 +106,16 @@ bool calc_CRC8(uint8_t MSB, uint8_t LSB, uint8_t CRC)
   }
   return crc == CRC;
 }
+
+uint32_t calc_FNV1a_ci(const char *data, size_t length)
+{
+  uint32_t hash = 2166136261u;
+
+  if (data != nullptr) {
+    while (length--) {
+      hash ^= static_cast<uint8_t>(tolower(*data++));
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
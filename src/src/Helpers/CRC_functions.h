@@ -18,5 +18,10 @@ bool          calc_CRC8(uint8_t MSB,
                         uint8_t LSB,
                         uint8_t CRC);
 
+// FNV-1a 32 bit hash, case insensitive for ASCII characters.
+// Meant for fast lookup of names, not as checksum.
+uint32_t      calc_FNV1a_ci(const char *data,
+                            size_t      length);
+
 
 #endif // ifndef HELPERS_CRC_FUNCTIONS_H
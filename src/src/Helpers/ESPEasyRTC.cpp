@@ -164,7 +164,7 @@ bool saveUserVarToRTC()
   // ESP32   Uses a temp structure which is mapped to the RTC address range.
   #if defined(ESP32)
   for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
-    const TaskValues_Data_t* taskValues = UserVar.getRawTaskValues_Data(task);
+    const TaskValues_Data_t* taskValues = static_cast<const UserVarStruct&>(UserVar).getRawTaskValues_Data(task);
     if (taskValues != nullptr) {
       for (uint8_t varNr = 0; varNr < VARS_PER_TASK; ++varNr) {
         const size_t index = (task * VARS_PER_TASK) + varNr;
@@ -180,8 +180,8 @@ bool saveUserVarToRTC()
   #ifdef ESP8266
   // addLog(LOG_LEVEL_DEBUG, F("RTCMEM: saveUserVarToRTC"));
   size_t   size{};
-  uint8_t *buffer    = UserVar.get(size);
-  const uint32_t sum = UserVar.compute_CRC32();
+  const uint8_t *buffer = static_cast<const UserVarStruct&>(UserVar).get(size);
+  const uint32_t sum    = UserVar.compute_CRC32();
   bool  ret    = system_rtc_mem_write(RTC_BASE_USERVAR, buffer, size);
   ret &= system_rtc_mem_write(RTC_BASE_USERVAR + (size >> 2), reinterpret_cast<const uint8_t *>(&sum), 4);
   return ret;
@@ -203,6 +203,9 @@ bool readUserVarFromRTC()
       // Store in raw form, so we don't apply formula as we don't really know what type is required.
       TaskValues_Data_t* taskValues = UserVar.getRawTaskValues_Data(taskIndex);
       taskValues->setUint32(varNr, UserVar_RTC[i]);
+      if (varNr == 0) {
+        UserVar.markChanged(taskIndex);
+      }
     }
     return true;
   }
@@ -225,6 +228,9 @@ bool readUserVarFromRTC()
       # endif // ifdef RTC_STRUCT_DEBUG
     memset(buffer, 0, size);
   }
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    UserVar.markChanged(taskIndex);
+  }
   return ret;
   #endif 
 }
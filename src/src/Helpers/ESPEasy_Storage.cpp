@@ -116,6 +116,74 @@ String flashGuard()
 #define FLASH_GUARD() { String flashErr = flashGuard(); \
                         if (flashErr.length()) return flashErr; }
 
+// Settings are compared and written in blocks of this size
+#define SAVE_TO_FILE_BLOCK_SIZE  256
+
+/********************************************************************************************\
+   Statistics on saving settings files
+ \*********************************************************************************************/
+static SettingsFileWriteStats settingsFileWriteStats[static_cast<uint8_t>(SettingsType::SettingsFileEnum::FILE_UNKNOWN_type) + 1];
+
+const SettingsFileWriteStats& getSettingsFileWriteStats(SettingsType::SettingsFileEnum file_type)
+{
+  return settingsFileWriteStats[static_cast<uint8_t>(file_type)];
+}
+
+static SettingsFileWriteStats& getSettingsFileWriteStats(const char *fname)
+{
+  const String patched_fname = patch_fname(fname);
+  uint8_t i                  = 0;
+
+  for (; i < static_cast<uint8_t>(SettingsType::SettingsFileEnum::FILE_UNKNOWN_type); ++i) {
+    const String settings_fname = patch_fname(SettingsType::getSettingsFileName(static_cast<SettingsType::SettingsFileEnum>(i)));
+
+    if (settings_fname.equalsIgnoreCase(patched_fname)) {
+      break;
+    }
+  }
+  return settingsFileWriteStats[i];
+}
+
+/********************************************************************************************\
+   Keep a file open for consecutive saves to the same file
+ \*********************************************************************************************/
+static uint8_t  saveToFileBatchDepth = 0;
+static fs::File saveToFileBatchFile;
+static String   saveToFileBatchFileName;
+static bool     saveToFileBatchFlashCounted = false;
+
+SaveToFileBatch::SaveToFileBatch()
+{
+  ++saveToFileBatchDepth;
+}
+
+SaveToFileBatch::~SaveToFileBatch()
+{
+  if (saveToFileBatchDepth > 0) {
+    --saveToFileBatchDepth;
+  }
+
+  if (saveToFileBatchDepth == 0) {
+    closeSaveToFileBatch(EMPTY_STRING);
+  }
+}
+
+void closeSaveToFileBatch(const String& fname)
+{
+  if (saveToFileBatchFileName.isEmpty()) {
+    return;
+  }
+
+  if (fname.isEmpty() || saveToFileBatchFileName.equalsIgnoreCase(patch_fname(fname))) {
+    if (saveToFileBatchFile) {
+      saveToFileBatchFile.close();
+    }
+    saveToFileBatchFile = fs::File();
+    saveToFileBatchFileName.clear();
+    saveToFileBatchFlashCounted = false;
+  }
+}
+
 
 String appendLineToFile(const String& fname, const String& line) {
   return appendToFile(fname, reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
@@ -186,6 +254,9 @@ fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e
     return f;
   }
 
+  // Make sure all changes are written before the file is opened again.
+  closeSaveToFileBatch(fname);
+
   bool exists = fileExists(fname);
 
   if (!exists) {
@@ -218,6 +289,7 @@ bool fileMatchesTaskSettingsType(const String& fname) {
 
 bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination) {
   clearFileCaches();
+  closeSaveToFileBatch(fname_old);
 
   if (fileExists(fname_old) && !fileExists(fname_new)) {
     if (fileMatchesTaskSettingsType(fname_old)) {
@@ -244,6 +316,7 @@ bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestina
 bool tryDeleteFile(const String& fname, FileDestination_e destination) {
   if (fname.length() > 0)
   {
+    closeSaveToFileBatch(fname);
     #if FEATURE_RTC_CACHE_STORAGE
 
     if (isCacheFile(fname)) {
@@ -1098,6 +1171,9 @@ String SaveStringArray(SettingsType::Enum settingsType,
   std::vector<uint8_t> buffer;
   buffer.resize(bufferSize);
 
+  // Written in parts, flush to file system only once
+  SaveToFileBatch batch;
+
   String   result;
   int      writePos        = posInBlock;
   uint16_t stringCount     = 0;
@@ -1212,6 +1288,12 @@ String SaveTaskSettings(taskIndex_t TaskIndex)
                      reinterpret_cast<const uint8_t *>(&ExtraTaskSettings),
                      sizeof(struct ExtraTaskSettingsStruct));
 
+    if (err.isEmpty()) {
+      Cache.extraTaskSettings_RAM.set(TaskIndex, ExtraTaskSettings);
+    } else {
+      Cache.extraTaskSettings_RAM.erase(TaskIndex);
+    }
+
 #if !defined(PLUGIN_BUILD_MINIMAL_OTA) && !defined(ESP8266_1M)
 
     if (err.isEmpty()) {
@@ -1263,11 +1345,21 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
   checkRAM(F("LoadTaskSettings"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
-  const String result = LoadFromFile(
-    SettingsType::Enum::TaskSettings_Type,
-    TaskIndex,
-    reinterpret_cast<uint8_t *>(&ExtraTaskSettings),
-    sizeof(struct ExtraTaskSettingsStruct));
+  const bool fromRAM = Cache.extraTaskSettings_RAM.get(TaskIndex, ExtraTaskSettings);
+  String     result;
+
+  if (!fromRAM) {
+    result = LoadFromFile(
+      SettingsType::Enum::TaskSettings_Type,
+      TaskIndex,
+      reinterpret_cast<uint8_t *>(&ExtraTaskSettings),
+      sizeof(struct ExtraTaskSettingsStruct));
+
+    if (result.isEmpty()) {
+      // Keep a copy of the settings as stored, before patching.
+      Cache.extraTaskSettings_RAM.set(TaskIndex, ExtraTaskSettings);
+    }
+  }
 
   // After loading, some settings may need patching.
   ExtraTaskSettings.TaskIndex = TaskIndex; // Needed when an empty task was requested
@@ -1282,7 +1374,12 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
 
   ExtraTaskSettings.validate();
   Cache.updateExtraTaskSettingsCache_afterLoad_Save();
-  STOP_TIMER(LOAD_TASK_SETTINGS);
+
+  if (fromRAM) {
+    STOP_TIMER(LOAD_TASK_SETTINGS_C);
+  } else {
+    STOP_TIMER(LOAD_TASK_SETTINGS);
+  }
 
   return result;
 }
@@ -1699,11 +1796,13 @@ String InitFile(const String& fname, int datasize)
   fs::File f = tryOpenFile(fname, "w");
 
   if (f) {
-    for (int x = 0; x < datasize; x++)
+    uint8_t zero_values[SAVE_TO_FILE_BLOCK_SIZE] = { 0 };
+
+    for (int x = 0; x < datasize; x += SAVE_TO_FILE_BLOCK_SIZE)
     {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t zero_value = 0;
-      SPIFFS_CHECK(f.write(&zero_value, 1), fname.c_str());
+      const size_t blockSize = std::min(datasize - x, SAVE_TO_FILE_BLOCK_SIZE);
+      SPIFFS_CHECK(f.write(zero_values, blockSize) == blockSize, fname.c_str());
+      delay(0);
     }
     f.close();
   }
@@ -1765,7 +1864,6 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("SaveToFile"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
-  FLASH_GUARD();
 
   #ifndef BUILD_NO_DEBUG
 
@@ -1774,40 +1872,82 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
   }
   #endif // ifndef BUILD_NO_DEBUG
   delay(1);
-  unsigned long timer = millis() + 50;
-  fs::File f          = tryOpenFile(fname, mode);
 
-  if (f) {
-    clearAllButTaskCaches();
-    SPIFFS_CHECK(f,                          fname);
-    if (index > 0) {
-      SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
+  // In "w+" mode the file is truncated, so there is nothing to compare with.
+  const bool compareExisting = strcmp(mode, "r+") == 0;
+  const bool batched         = compareExisting && (saveToFileBatchDepth > 0);
+  fs::File   f;
+
+  if (batched && saveToFileBatchFile && saveToFileBatchFileName.equalsIgnoreCase(patch_fname(fname))) {
+    f = saveToFileBatchFile;
+  } else {
+    closeSaveToFileBatch(EMPTY_STRING);
+    f = tryOpenFile(fname, mode);
+
+    if (batched && f) {
+      saveToFileBatchFile     = f;
+      saveToFileBatchFileName = patch_fname(fname);
     }
-    const uint8_t *pointerToByteToSave = memAddress;
+  }
+
+  if (f) {
+    SettingsFileWriteStats& stats = getSettingsFileWriteStats(fname);
+    bool changed                  = false;
 
-    for (int x = 0; x < datasize; x++)
+    // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
+    // Data is copied to a buffer in RAM before writing.
+    uint8_t buffer[SAVE_TO_FILE_BLOCK_SIZE];
+
+    for (int x = 0; x < datasize; x += SAVE_TO_FILE_BLOCK_SIZE)
     {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t byteToSave = *pointerToByteToSave;
-      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
-      pointerToByteToSave++;
-
-      if (x % 256 == 0) {
-        // one page written, do some background tasks
-        timer = millis() + 50;
-        delay(0);
+      const size_t blockSize = std::min(datasize - x, SAVE_TO_FILE_BLOCK_SIZE);
+      const size_t pos       = index + x;
+
+      if (compareExisting &&
+          f.seek(pos, fs::SeekSet) &&
+          (f.read(buffer, blockSize) == blockSize) &&
+          (memcmp(buffer, memAddress + x, blockSize) == 0)) {
+        // Block did not change, no need to write it.
+        continue;
       }
 
-      if (timeOutReached(timer)) {
-        timer += 50;
-        delay(0);
+      if (!changed) {
+        // Only count as flash write when something will be written.
+        // Saves to a file kept open by SaveToFileBatch are flushed at once, so count only once.
+        if (!batched || !saveToFileBatchFlashCounted) {
+          FLASH_GUARD();
+          saveToFileBatchFlashCounted = batched;
+        }
+        clearAllButTaskCaches();
+        changed = true;
       }
+      memcpy(buffer, memAddress + x, blockSize);
+
+      if (f.position() != pos) {
+        SPIFFS_CHECK(f.seek(pos, fs::SeekSet), fname);
+      }
+      SPIFFS_CHECK(f.write(buffer, blockSize) == blockSize, fname);
+      ++stats.blocks;
+
+      // one block written, do some background tasks
+      delay(0);
+    }
+
+    if (!batched) {
+      f.close();
+    }
+
+    if (changed) {
+      ++stats.saves;
+    } else {
+      ++stats.skipped;
     }
-    f.close();
     #ifndef BUILD_NO_DEBUG
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, strformat(F("FILE : Saved %s offset: %d size: %d"), fname, index, datasize));
+      addLogMove(LOG_LEVEL_INFO, strformat(
+                   changed ? F("FILE : Saved %s offset: %d size: %d") : F("FILE : Not changed %s offset: %d size: %d"),
+                   fname, index, datasize));
     }
     #endif // ifndef BUILD_NO_DEBUG
   } else {
@@ -1858,11 +1998,13 @@ String ClearInFile(const char *fname, int index, int datasize)
   if (f) {
     SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
 
-    for (int x = 0; x < datasize; x++)
+    uint8_t zero_values[SAVE_TO_FILE_BLOCK_SIZE] = { 0 };
+
+    for (int x = 0; x < datasize; x += SAVE_TO_FILE_BLOCK_SIZE)
     {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t zero_value = 0;
-      SPIFFS_CHECK(f.write(&zero_value, 1), fname);
+      const size_t blockSize = std::min(datasize - x, SAVE_TO_FILE_BLOCK_SIZE);
+      SPIFFS_CHECK(f.write(zero_values, blockSize) == blockSize, fname);
+      delay(0);
     }
     f.close();
   } else {
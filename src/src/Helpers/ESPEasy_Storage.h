@@ -29,6 +29,35 @@ void flashCount();
 
 String flashGuard();
 
+/********************************************************************************************\
+   Statistics on saving settings files, since boot.
+ \*********************************************************************************************/
+struct SettingsFileWriteStats {
+  uint32_t saves   = 0; // Saves which changed the content of the file
+  uint32_t skipped = 0; // Saves skipped as the content did not change
+  uint32_t blocks  = 0; // Number of blocks written
+};
+
+// FILE_UNKNOWN_type is used for all other files
+const SettingsFileWriteStats& getSettingsFileWriteStats(SettingsType::SettingsFileEnum file_type);
+
+/********************************************************************************************\
+   Keep a file open for consecutive saves to the same file, so the changes
+   are flushed to the file system once when the last SaveToFileBatch goes out of scope.
+   Any other access to the file will first close it.
+ \*********************************************************************************************/
+struct SaveToFileBatch {
+  SaveToFileBatch();
+  ~SaveToFileBatch();
+
+  SaveToFileBatch(const SaveToFileBatch& other)            = delete;
+  SaveToFileBatch& operator=(const SaveToFileBatch& other) = delete;
+};
+
+// Close the file kept open by SaveToFileBatch, when it matches fname.
+// Empty fname closes any file.
+void closeSaveToFileBatch(const String& fname);
+
 String appendLineToFile(const String& fname, const String& line);
 
 String appendToFile(const String& fname, const uint8_t *data, unsigned int size);
@@ -90,7 +90,7 @@ void run_compiletime_checks() {
   #if FEATURE_NOTIFIER
   check_size<NotificationSettingsStruct,            1000u>();
   #endif // if FEATURE_NOTIFIER
-  check_size<ExtraTaskSettingsStruct,               536u>();
+  check_size<ExtraTaskSettingsStruct,               604u>();
   #if ESP_IDF_VERSION_MAJOR > 3
   // String class has increased with 4 bytes
   check_size<EventStruct,                           124u>(); // Is not stored
@@ -99,15 +99,7 @@ void run_compiletime_checks() {
   #endif
 
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  #if ESP_IDF_VERSION_MAJOR > 3
-  // String class has increased with 4 bytes
-  const unsigned int LogStructSize = ((13u + 24 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #else
-  const unsigned int LogStructSize = ((13u + 20 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #endif
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
+  check_size<LogStruct,                             32u>(); // Is not stored
   check_size<DeviceStruct,                          10u>(); // Is not stored
   #if FEATURE_MQTT_TLS
   check_size<ProtocolStruct,                        6u>();
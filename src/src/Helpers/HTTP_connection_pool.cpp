@@ -0,0 +1,260 @@
+#include "../Helpers/HTTP_connection_pool.h"
+
+#if FEATURE_HTTP_KEEPALIVE
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/CPlugins.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/Networking.h"
+# include "../Helpers/StringConverter.h"
+
+# include <memory>
+# include <new>
+
+struct HTTP_keepalive_connection {
+  WiFiClient client;
+  HTTPClient http;
+  String     host;
+  uint32_t   lastUsed{};
+  uint16_t   port{};
+  uint16_t   nrRequests{}; // Number of requests sent over the current connection
+};
+
+// Free the connection object when not used for this many msec.
+// Keep it a while after closing the connection, as on ESP8266 the HTTPClient
+// only reuses connections once it received a reply allowing it.
+# define HTTP_KEEPALIVE_FREE_TIMEOUT  60000
+
+// Only allocated when a controller uses keep-alive.
+static std::unique_ptr<HTTP_keepalive_connection> HTTP_connections[CONTROLLER_MAX];
+static HTTP_connection_stats_t HTTP_connection_stats[CONTROLLER_MAX];
+
+uint32_t HTTP_connection_stats_t::getAvgConnectDuration_ms() const
+{
+  if (connects == 0) {
+    return 0;
+  }
+  return (connectDuration_usec / connects) / 1000ull;
+}
+
+static void closeConnection(HTTP_keepalive_connection& connection)
+{
+  // Make sure http.end() does not keep the connection open
+  connection.http.setReuse(false);
+  connection.http.end();
+  connection.http.setReuse(true);
+  connection.client.stop();
+  connection.nrRequests = 0;
+}
+
+static bool isReusable(HTTP_keepalive_connection& connection, const String& host, uint16_t port)
+{
+  return connection.nrRequests != 0 &&
+         connection.port == port &&
+         connection.host.equals(host) &&
+         timePassedSince(connection.lastUsed) < HTTP_KEEPALIVE_IDLE_TIMEOUT &&
+         connection.client.connected();
+}
+
+// Errors when the server closed the connection before any part of the request was sent.
+// Once the headers are sent, the server may already have handled the request,
+// so resending it could perform a non-idempotent request (e.g. POST) twice.
+static bool isClosedConnectionError(int httpCode)
+{
+  switch (httpCode) {
+    case HTTPC_ERROR_SEND_HEADER_FAILED:
+    case HTTPC_ERROR_NOT_CONNECTED:
+      return true;
+  }
+  return false;
+}
+
+// Make the connection here, to be able to keep it open.
+// On ESP8266 the HTTPClient works on a copy of the client, which shares the connection made here.
+static void connect(HTTP_keepalive_connection& connection,
+                    HTTP_connection_stats_t  & stats,
+                    const String             & logIdentifier,
+                    const String             & host,
+                    uint16_t                   port,
+                    uint16_t                   timeout)
+{
+  closeConnection(connection);
+  connection.host = host;
+  connection.port = port;
+
+  const uint64_t statisticsTimerStart(getMicros64());
+
+  if (!connectClient(connection.client, host.c_str(), port, timeout)) {
+    // HTTPClient will try again and report the error
+    ++stats.connectFailures;
+    return;
+  }
+  ++stats.connects;
+  stats.connectDuration_usec += usecPassedSince(statisticsTimerStart);
+
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(
+                 F("HTTP : %s new connection to %s:%u, avg. connect time %u ms"),
+                 logIdentifier.c_str(),
+                 host.c_str(),
+                 port,
+                 stats.getAvgConnectDuration_ms()));
+  }
+# endif // ifndef BUILD_NO_DEBUG
+}
+
+String send_via_http_keepalive(controllerIndex_t controller_idx,
+                               const String    & logIdentifier,
+                               uint16_t          timeout,
+                               const String    & user,
+                               const String    & pass,
+                               const String    & host,
+                               uint16_t          port,
+                               const String    & uri,
+                               const String    & HttpMethod,
+                               const String    & header,
+                               const String    & postStr,
+                               int             & httpCode,
+                               bool              must_check_reply)
+{
+  if (validControllerIndex(controller_idx) && must_check_reply && !HTTP_connections[controller_idx]) {
+    HTTP_connections[controller_idx].reset(new (std::nothrow) HTTP_keepalive_connection());
+
+    if (HTTP_connections[controller_idx]) {
+      HTTP_connections[controller_idx]->http.setReuse(true);
+    }
+  }
+
+  if (!validControllerIndex(controller_idx) || !must_check_reply || !HTTP_connections[controller_idx]) {
+    // When ignoring the acknowledgement, the reply is not read and thus the connection cannot be used again.
+    closeHTTP_connection(controller_idx);
+    return send_via_http(
+      logIdentifier,
+      timeout,
+      user,
+      pass,
+      host,
+      port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      must_check_reply);
+  }
+
+  HTTP_keepalive_connection& connection = *HTTP_connections[controller_idx];
+  HTTP_connection_stats_t  & stats      = HTTP_connection_stats[controller_idx];
+
+  bool reused = isReusable(connection, host, port);
+
+  if (!reused) {
+    connect(connection, stats, logIdentifier, host, port, timeout);
+  }
+
+  String response = send_via_http(
+    logIdentifier,
+    connection.client,
+    connection.http,
+    timeout,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    HttpMethod,
+    header,
+    postStr,
+    httpCode,
+    must_check_reply);
+
+  if (reused && isClosedConnectionError(httpCode)) {
+    // Server closed the connection while it was idle, try once more on a new connection.
+    ++stats.retries;
+    reused = false;
+    connect(connection, stats, logIdentifier, host, port, timeout);
+    response = send_via_http(
+      logIdentifier,
+      connection.client,
+      connection.http,
+      timeout,
+      user,
+      pass,
+      host,
+      port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      must_check_reply);
+  }
+
+  ++stats.requests;
+
+  if (reused) {
+    ++stats.reused;
+  }
+  connection.lastUsed = millis();
+
+  if (httpCode <= 0) {
+    ++stats.errors;
+    closeConnection(connection);
+    return response;
+  }
+
+  // Keeps the connection open, unless the server replied it will close the connection
+  connection.http.end();
+  ++connection.nrRequests;
+
+  if ((connection.nrRequests >= HTTP_KEEPALIVE_MAX_REQUESTS) || !connection.client.connected()) {
+    closeConnection(connection);
+  }
+  return response;
+}
+
+void HTTP_connection_pool_loop()
+{
+  for (controllerIndex_t i = 0; i < CONTROLLER_MAX; ++i) {
+    if (HTTP_connections[i]) {
+      HTTP_keepalive_connection& connection = *HTTP_connections[i];
+      const long idleTime                   = timePassedSince(connection.lastUsed);
+
+      if (idleTime >= HTTP_KEEPALIVE_FREE_TIMEOUT) {
+        closeHTTP_connection(i);
+      } else if ((connection.nrRequests != 0) &&
+                 ((idleTime >= HTTP_KEEPALIVE_IDLE_TIMEOUT) || !connection.client.connected())) {
+        closeConnection(connection);
+      }
+    }
+  }
+}
+
+void closeHTTP_connection(controllerIndex_t controller_idx)
+{
+  if (validControllerIndex(controller_idx) && HTTP_connections[controller_idx]) {
+    closeConnection(*HTTP_connections[controller_idx]);
+    HTTP_connections[controller_idx].reset();
+  }
+}
+
+void closeAllHTTP_connections()
+{
+  for (controllerIndex_t i = 0; i < CONTROLLER_MAX; ++i) {
+    closeHTTP_connection(i);
+  }
+}
+
+const HTTP_connection_stats_t& getHTTP_connection_stats(controllerIndex_t controller_idx)
+{
+  static const HTTP_connection_stats_t empty;
+
+  if (!validControllerIndex(controller_idx)) {
+    return empty;
+  }
+  return HTTP_connection_stats[controller_idx];
+}
+
+#endif // if FEATURE_HTTP_KEEPALIVE
@@ -0,0 +1,75 @@
+#ifndef HELPERS_HTTP_CONNECTION_POOL_H
+#define HELPERS_HTTP_CONNECTION_POOL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_HTTP_KEEPALIVE
+
+# include "../DataTypes/ControllerIndex.h"
+
+// Close an idle connection after this many msec.
+// Should be shorter than the keep-alive timeout of most servers (e.g. 5 sec for Apache)
+# ifndef HTTP_KEEPALIVE_IDLE_TIMEOUT
+#  define HTTP_KEEPALIVE_IDLE_TIMEOUT   4000
+# endif // ifndef HTTP_KEEPALIVE_IDLE_TIMEOUT
+
+// Max. number of requests sent over a single connection before it is closed.
+# ifndef HTTP_KEEPALIVE_MAX_REQUESTS
+#  define HTTP_KEEPALIVE_MAX_REQUESTS   100
+# endif // ifndef HTTP_KEEPALIVE_MAX_REQUESTS
+
+
+struct HTTP_connection_stats_t {
+  uint32_t getAvgConnectDuration_ms() const;
+
+  uint32_t requests{};            // Requests sent
+  uint32_t reused{};              // Requests sent over an already open connection
+  uint32_t connects{};            // Connections made
+  uint32_t connectFailures{};     // Connections which could not be made
+  uint32_t retries{};             // Requests sent again, as the server closed the open connection
+  uint32_t errors{};              // Failed requests, the connection is closed after an error
+  uint64_t connectDuration_usec{}; // Total time spent on making connections, including DNS lookup
+};
+
+/*********************************************************************************************\
+* HTTP connection pool
+* Keep one connection per controller open for the next message, using HTTP/1.1 keep-alive.
+*
+* A connection is closed when:
+* - It was idle for HTTP_KEEPALIVE_IDLE_TIMEOUT msec
+* - HTTP_KEEPALIVE_MAX_REQUESTS requests were sent over it
+* - The server does not allow keep-alive, or closed the connection
+* - A request failed
+* - The host or port of the controller changed
+* When sending over an open connection fails because the server closed it,
+* the request is sent once more over a new connection.
+\*********************************************************************************************/
+
+// Same as send_via_http(), but keeps the connection open for the next call for the same controller.
+// Connections are only kept open when must_check_reply is set, as only then the reply is read.
+String send_via_http_keepalive(controllerIndex_t controller_idx,
+                               const String    & logIdentifier,
+                               uint16_t          timeout,
+                               const String    & user,
+                               const String    & pass,
+                               const String    & host,
+                               uint16_t          port,
+                               const String    & uri,
+                               const String    & HttpMethod,
+                               const String    & header,
+                               const String    & postStr,
+                               int             & httpCode,
+                               bool              must_check_reply);
+
+// Close connections which are idle for too long, or closed by the server.
+void                           HTTP_connection_pool_loop();
+
+void                           closeHTTP_connection(controllerIndex_t controller_idx);
+
+void                           closeAllHTTP_connections();
+
+const HTTP_connection_stats_t& getHTTP_connection_stats(controllerIndex_t controller_idx);
+
+#endif // if FEATURE_HTTP_KEEPALIVE
+
+#endif // ifndef HELPERS_HTTP_CONNECTION_POOL_H
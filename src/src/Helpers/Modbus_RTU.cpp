@@ -4,21 +4,20 @@
 
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Modbus_RTU_bus.h"
 #include "../Helpers/StringConverter.h"
 
 
 ModbusRTU_struct::~ModbusRTU_struct() {
-  if (easySerial != nullptr) {
-    delete easySerial;
-    easySerial = nullptr;
-  }
+  cancelCommand();
+  ModbusRTU_bus::release(_bus);
+  _bus = nullptr;
 }
 
 void ModbusRTU_struct::reset() {
-  if (easySerial != nullptr) {
-    delete easySerial;
-    easySerial = nullptr;
-  }
+  cancelCommand();
+  ModbusRTU_bus::release(_bus);
+  _bus = nullptr;
   detected_device_description = String();
 
   for (int i = 0; i < 8; ++i) {
@@ -31,9 +30,6 @@ void ModbusRTU_struct::reset() {
   }
   _recv_buf_used    = 0;
   _modbus_address   = MODBUS_BROADCAST_ADDRESS;
-  _reads_pass       = 0;
-  _reads_crc_failed = 0;
-  _reads_nodata     = 0;
 }
 
 bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int16_t baudrate, uint8_t address) {
@@ -45,23 +41,10 @@ bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_r
     return false;
   }
   reset();
-  {
-    # ifdef USE_SECOND_HEAP
-    HeapSelectDram ephemeral;
-    # endif // ifdef USE_SECOND_HEAP
-
-    easySerial = new (std::nothrow) ESPeasySerial(port, serial_rx, serial_tx);
-  }
-  if (easySerial == nullptr) { return false; }
-  easySerial->begin(baudrate);
+  _bus = ModbusRTU_bus::acquire(port, serial_rx, serial_tx, baudrate, dere_pin);
 
   if (!isInitialized()) { return false; }
   _modbus_address = address;
-  _dere_pin       = dere_pin;
-
-  if (_dere_pin != -1) { // set output pin mode for DE/RE pin when used (for control MAX485)
-    pinMode(_dere_pin, OUTPUT);
-  }
 
   detected_device_description = getDevice_description(_modbus_address);
 
@@ -75,13 +58,31 @@ bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_r
 }
 
 bool ModbusRTU_struct::isInitialized() const {
-  return easySerial != nullptr;
+  return _bus != nullptr;
 }
 
 void ModbusRTU_struct::getStatistics(uint32_t& pass, uint32_t& fail, uint32_t& nodata) const {
-  pass   = _reads_pass;
-  fail   = _reads_crc_failed;
-  nodata = _reads_nodata;
+  pass   = 0;
+  fail   = 0;
+  nodata = 0;
+
+  if (isInitialized()) {
+    const ModbusRTU_slave_stats stats = _bus->getSlaveStats(_modbus_address);
+    pass   = stats.pass;
+    fail   = stats.crc_failed;
+    nodata = stats.nodata;
+  }
+}
+
+void ModbusRTU_struct::getLatency(uint32_t& avg_ms, uint32_t& max_ms) const {
+  avg_ms = 0;
+  max_ms = 0;
+
+  if (isInitialized()) {
+    const ModbusRTU_slave_stats stats = _bus->getSlaveStats(_modbus_address);
+    avg_ms = stats.getAvgLatency_ms();
+    max_ms = stats.latency_max_ms;
+  }
 }
 
 void ModbusRTU_struct::setModbusTimeout(uint16_t timeout) {
@@ -418,7 +419,7 @@ void ModbusRTU_struct::logModbusException(uint8_t value) {
     return log;
    }
  */
-uint8_t ModbusRTU_struct::processCommand() {
+void ModbusRTU_struct::addCRC() {
   // CRC-calculation
   unsigned int crc =
     ModRTU_CRC(_sendframe, _sendframe_used);
@@ -430,91 +431,101 @@ uint8_t ModbusRTU_struct::processCommand() {
 
   _sendframe[_sendframe_used++] = checksumLo;
   _sendframe[_sendframe_used++] = checksumHi;
+}
 
-  int  nrRetriesLeft = 2;
-  uint8_t return_value  = 0;
+uint8_t ModbusRTU_struct::processCommand() {
+  if (!isInitialized()) {
+    _last_error = MODBUS_NODATA;
+    return _last_error;
+  }
+  addCRC();
 
-  while (nrRetriesLeft > 0) {
-    return_value = 0;
+  // Queued on the bus shared with other tasks, which also handles the retries.
+  // Sent before any queued periodic reads, but still waits for the transaction in progress.
+  const uint32_t id = _bus->submit(_sendframe, _sendframe_used, _modbus_timeout, ModbusRTU_priority::High);
 
-    // Send the uint8_t array
-    startWrite();
-    easySerial->write(_sendframe, _sendframe_used);
+  if (id == 0) {
+    _last_error = MODBUS_NODATA;
+    return _last_error;
+  }
+  uint8_t return_value = 0;
 
-    // sent all data from buffer
-    easySerial->flush();
-    startRead();
+  while (!_bus->getResult(id, return_value, _recv_buf, _recv_buf_used)) {
+    _bus->loop();
+    delay(0);
+  }
+  _last_error = return_value;
+  return return_value;
+}
 
-    // Read answer from sensor
-    _recv_buf_used = 0;
-    unsigned long timeout    = millis() + _modbus_timeout;
-    bool validPacket         = false;
-    bool invalidDueToTimeout = false;
+bool ModbusRTU_struct::submitCommand() {
+  if (!isInitialized() || isCommandPending()) {
+    return false;
+  }
+  addCRC();
+  _pendingId = _bus->submit(_sendframe, _sendframe_used, _modbus_timeout, ModbusRTU_priority::Low);
+  return isCommandPending();
+}
 
-    //  idx:    0,   1,   2,   3,   4,   5,   6,   7
-    // send: 0x02,0x03,0x00,0x00,0x00,0x01,0x39,0x84
-    // recv: 0x02,0x03,0x02,0x01,0x57,0xBC,0x2A
+bool ModbusRTU_struct::submitReadRegisters(uint8_t functionCode, short startAddress, short nrRegisters) {
+  if (isCommandPending()) {
+    return false;
+  }
+  buildFrame(_modbus_address, functionCode, startAddress, nrRegisters);
+  return submitCommand();
+}
 
-    while (!validPacket && !invalidDueToTimeout && _recv_buf_used < MODBUS_RECEIVE_BUFFER) {
-      if (timeOutReached(timeout)) {
-        invalidDueToTimeout = true;
-      }
+bool ModbusRTU_struct::submitRead_RAM_EEPROM(uint8_t command, uint8_t startAddress, uint8_t nrBytes) {
+  if (isCommandPending()) {
+    return false;
+  }
+  buildRead_RAM_EEPROM(_modbus_address, command, startAddress, nrBytes);
+  return submitCommand();
+}
 
-      while (!invalidDueToTimeout && easySerial->available() && _recv_buf_used < MODBUS_RECEIVE_BUFFER) {
-        if (timeOutReached(timeout)) {
-          invalidDueToTimeout = true;
-        }
-        _recv_buf[_recv_buf_used++] = easySerial->read();
-      }
+bool ModbusRTU_struct::getCommandResult(uint8_t& errorcode) {
+  if (!isInitialized() || !isCommandPending()) {
+    errorcode = MODBUS_NODATA;
+    return true;
+  }
 
-      if (_recv_buf_used > 2) {                                         // got length
-        if (_recv_buf_used >= (3 + _recv_buf[2] + 2)) {                 // got whole pkt
-          crc          = ModRTU_CRC(_recv_buf, _recv_buf_used);         // crc16 is 0 for whole valid pkt
-          validPacket  = (crc == 0) && (_recv_buf[0] == _sendframe[0]); // check crc and address
-          return_value = 0;                                             // reset return value
-        }
-      }
-      delay(0);
-    }
+  if (!_bus->getResult(_pendingId, errorcode, _recv_buf, _recv_buf_used)) {
+    return false;
+  }
+  _pendingId  = 0;
+  _last_error = errorcode;
+  return true;
+}
 
-    // Check for MODBUS exception
-    if (invalidDueToTimeout) {
-      ++_reads_nodata;
+void ModbusRTU_struct::cancelCommand() {
+  if (isInitialized() && isCommandPending()) {
+    _bus->cancel(_pendingId);
+  }
+  _pendingId = 0;
+}
 
-      if (_recv_buf_used == 0) {
-        return_value = MODBUS_NODATA;
-      } else {
-        return_value = MODBUS_TIMEOUT;
-      }
-    } else if (!validPacket) {
-      ++_reads_crc_failed;
-      return_value = MODBUS_BADCRC;
-    } else {
-      const uint8_t received_functionCode = _recv_buf[1];
+int ModbusRTU_struct::get_16b_register_result() const {
+  return (_recv_buf[3] << 8) | (_recv_buf[4]);
+}
 
-      if ((received_functionCode & 0x80) != 0) {
-        return_value = _recv_buf[2];
-      }
-      ++_reads_pass;
-      _reads_nodata = 0;
-    }
+uint32_t ModbusRTU_struct::get_32b_register_result() const {
+  uint32_t result = 0;
 
-    switch (return_value) {
-      case MODBUS_EXCEPTION_ACKNOWLEDGE:
-      case MODBUS_EXCEPTION_SLAVE_OR_SERVER_BUSY:
-      case MODBUS_BADCRC:
-      case MODBUS_TIMEOUT:
+  for (uint8_t i = 0; i < 4; ++i) {
+    result  = result << 8;
+    result += _recv_buf[i + 3];
+  }
+  return result;
+}
 
-        // Bad communication, makes sense to retry.
-        break;
-      default:
-        nrRetriesLeft = 0; // When not supported, does not make sense to retry.
-        break;
-    }
-    --nrRetriesLeft;
+unsigned int ModbusRTU_struct::get_RAM_EEPROM_result() const {
+  unsigned int result = 0;
+
+  for (int i = 0; i < _recv_buf[2]; ++i) {
+    // Most significant uint8_t at lower address
+    result = (result << 8) | _recv_buf[i + 3];
   }
-  _last_error = return_value;
-  return return_value;
+  return result;
 }
 
 uint32_t ModbusRTU_struct::read_32b_InputRegister(short address) {
@@ -660,7 +671,7 @@ int ModbusRTU_struct::process_16b_register(uint8_t slaveAddress, uint8_t functio
   errorcode = processCommand();
 
   if (errorcode == 0) {
-    return (_recv_buf[3] << 8) | (_recv_buf[4]);
+    return get_16b_register_result();
   }
   logModbusException(errorcode);
   return -1;
@@ -684,12 +695,7 @@ bool ModbusRTU_struct::process_32b_register(uint8_t slaveAddress, uint8_t functi
   const uint8_t process_result = processCommand();
 
   if (process_result == 0) {
-    result = 0;
-
-    for (uint8_t i = 0; i < 4; ++i) {
-      result  = result << 8;
-      result += _recv_buf[i + 3];
-    }
+    result = get_32b_register_result();
     return true;
   }
   logModbusException(process_result);
@@ -715,13 +721,7 @@ unsigned int ModbusRTU_struct::read_RAM_EEPROM(uint8_t command, uint8_t startAdd
   errorcode = processCommand();
 
   if (errorcode == 0) {
-    unsigned int result = 0;
-
-    for (int i = 0; i < _recv_buf[2]; ++i) {
-      // Most significant uint8_t at lower address
-      result = (result << 8) | _recv_buf[i + 3];
-    }
-    return result;
+    return get_RAM_EEPROM_result();
   }
   logModbusException(errorcode);
   return 0;
@@ -759,24 +759,12 @@ uint8_t ModbusRTU_struct::getLastError() const {
 }
 
 uint32_t ModbusRTU_struct::getFailedReadsSinceLastValid() const {
-  return _reads_nodata;
-}
+  uint32_t pass{};
+  uint32_t fail{};
+  uint32_t nodata{};
 
-void ModbusRTU_struct::startWrite() {
-  // transmit to device  -> DE Enable, /RE Disable (for control MAX485)
-  if ((_dere_pin == -1) || !isInitialized()) { return; }
-  digitalWrite(_dere_pin, HIGH);
-  delay(2); // Switching may take some time
-}
-
-void ModbusRTU_struct::startRead() {
-  if (!isInitialized()) { return; }
-  easySerial->flush(); // clear out tx buffer
-
-  // receive from device -> DE Disable, /RE Enable (for control MAX485)
-  if (_dere_pin != -1) {
-    digitalWrite(_dere_pin, LOW);
-  }
+  getStatistics(pass, fail, nodata);
+  return nodata;
 }
 
 #endif
\ No newline at end of file
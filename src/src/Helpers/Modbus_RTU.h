@@ -45,6 +45,7 @@
 #define MODBUS_TIMEOUT  (MODBUS_EXCEPTION_GATEWAY_TARGET + 7)
 #define MODBUS_NODATA   (MODBUS_EXCEPTION_GATEWAY_TARGET + 8)
 
+class ModbusRTU_bus;
 
 struct ModbusRTU_struct  {
   ModbusRTU_struct() = default;
@@ -72,6 +73,10 @@ struct ModbusRTU_struct  {
                      uint32_t& fail,
                      uint32_t& nodata) const;
 
+  // Time between sending a request and receiving a valid reply
+  void getLatency(uint32_t& avg_ms,
+                  uint32_t& max_ms) const;
+
   void     setModbusTimeout(uint16_t timeout);
 
   uint16_t getModbusTimeout() const;
@@ -126,8 +131,42 @@ struct ModbusRTU_struct  {
       return log;
      }
    */
+  // Blocking, waits for the reply.
+  // Only meant for one-off calls like device detection and configuration.
   uint8_t     processCommand();
 
+  // Non-blocking, queue the frame with low priority.
+  // The request is processed by the shared bus, check for the reply using getCommandResult().
+  // Return false when the request could not be queued or another request is still pending.
+  bool        submitCommand();
+
+  // Queue a request to read nrRegisters 16-bit registers, see submitCommand()
+  bool        submitReadRegisters(uint8_t functionCode,
+                                  short   startAddress,
+                                  short   nrRegisters);
+
+  // Queue a request to read from RAM or EEPROM, see submitCommand()
+  bool        submitRead_RAM_EEPROM(uint8_t command,
+                                    uint8_t startAddress,
+                                    uint8_t nrBytes);
+
+  // Return true when the submitted request is done, or no request is pending.
+  // The reply can then be parsed using the get..._result() functions.
+  bool        getCommandResult(uint8_t& errorcode);
+
+  bool        isCommandPending() const {
+    return _pendingId != 0;
+  }
+
+  void        cancelCommand();
+
+  // Parse the reply of the last processed command
+  int          get_16b_register_result() const;
+
+  uint32_t     get_32b_register_result() const;
+
+  unsigned int get_RAM_EEPROM_result() const;
+
   uint32_t read_32b_InputRegister(short address);
 
   uint32_t read_32b_HoldingRegister(short address);
@@ -201,23 +240,22 @@ struct ModbusRTU_struct  {
 
 private:
 
-  void startWrite();
-
-  void startRead();
+  // Append the CRC to the frame to send
+  void        addCRC();
 
   uint8_t     _sendframe[12]                   = { 0 };
   uint8_t     _sendframe_used                  = 0;
   uint8_t     _recv_buf[MODBUS_RECEIVE_BUFFER] = { 0 };
-  uint8_t     _recv_buf_used                   = 0;
+  uint16_t    _recv_buf_used                   = 0;
   uint8_t     _modbus_address                  = MODBUS_BROADCAST_ADDRESS;
-  int8_t   _dere_pin                        = -1;
-  uint32_t _reads_pass                      = 0;
-  uint32_t _reads_crc_failed                = 0;
-  uint32_t _reads_nodata                    = 0; // This will be reset as soon as a valid packet has been received.
   uint16_t _modbus_timeout                  = 180;
   uint8_t  _last_error                      = 0;
 
-  ESPeasySerial *easySerial = nullptr;
+  // Transaction ID of the request queued by submitCommand()
+  uint32_t _pendingId = 0;
+
+  // Shared with other tasks using the same serial port
+  ModbusRTU_bus *_bus = nullptr;
 };
 
 #endif
@@ -0,0 +1,385 @@
+#include "../Helpers/Modbus_RTU_bus.h"
+
+#if FEATURE_MODBUS
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include <vector>
+
+std::vector<ModbusRTU_bus *> ModbusRTU_buses;
+
+uint32_t ModbusRTU_slave_stats::getAvgLatency_ms() const
+{
+  if (pass == 0) { return 0; }
+  return latency_total_ms / pass;
+}
+
+ModbusRTU_bus * ModbusRTU_bus::acquire(ESPEasySerialPort port,
+                                       int16_t           serial_rx,
+                                       int16_t           serial_tx,
+                                       uint32_t          baudrate,
+                                       int8_t            dere_pin)
+{
+  for (ModbusRTU_bus *bus : ModbusRTU_buses) {
+    if ((bus->_port == port) && (bus->_serial_rx == serial_rx) && (bus->_serial_tx == serial_tx)) {
+      if (bus->_baudrate != baudrate) {
+        addLog(LOG_LEVEL_ERROR, strformat(
+                 F("Modbus: Serial port already in use at %u baud"),
+                 bus->_baudrate));
+        return nullptr;
+      }
+
+      if (bus->_dere_pin != dere_pin) {
+        addLog(LOG_LEVEL_ERROR, strformat(
+                 F("Modbus: Serial port already in use with DE/RE pin %d"),
+                 bus->_dere_pin));
+        return nullptr;
+      }
+      ++bus->_users;
+      return bus;
+    }
+  }
+
+  ESPeasySerial *easySerial = nullptr;
+  ModbusRTU_bus *bus        = nullptr;
+  {
+    # ifdef USE_SECOND_HEAP
+    HeapSelectDram ephemeral;
+    # endif // ifdef USE_SECOND_HEAP
+
+    easySerial = new (std::nothrow) ESPeasySerial(port, serial_rx, serial_tx);
+
+    if (easySerial != nullptr) {
+      easySerial->begin(baudrate);
+      bus = new (std::nothrow) ModbusRTU_bus(*easySerial, baudrate, dere_pin);
+    }
+  }
+
+  if (bus == nullptr) {
+    delete easySerial;
+    return nullptr;
+  }
+  bus->_easySerial = easySerial;
+  bus->_port       = port;
+  bus->_serial_rx  = serial_rx;
+  bus->_serial_tx  = serial_tx;
+  bus->_users      = 1;
+
+  ModbusRTU_buses.push_back(bus);
+  return bus;
+}
+
+ModbusRTU_bus::ModbusRTU_bus(Stream& stream, uint32_t baudrate, int8_t dere_pin)
+  : _stream(&stream), _baudrate(baudrate), _dere_pin(dere_pin)
+{
+  // Silent interval of 3.5 characters of 11 bits, fixed to 1750 usec above 19200 baud
+  _interFrameGap_us = 1750;
+
+  if ((baudrate > 0) && (baudrate <= 19200)) {
+    _interFrameGap_us = 38500000ul / baudrate;
+  }
+
+  if (_dere_pin != -1) { // set output pin mode for DE/RE pin when used (for control MAX485)
+    pinMode(_dere_pin, OUTPUT);
+  }
+}
+
+void ModbusRTU_bus::release(ModbusRTU_bus *bus)
+{
+  if (bus == nullptr) { return; }
+
+  if (bus->_users > 1) {
+    --bus->_users;
+    return;
+  }
+
+  for (auto it = ModbusRTU_buses.begin(); it != ModbusRTU_buses.end(); ++it) {
+    if (*it == bus) {
+      ModbusRTU_buses.erase(it);
+      break;
+    }
+  }
+  delete bus;
+}
+
+void ModbusRTU_bus::loopAll()
+{
+  for (ModbusRTU_bus *bus : ModbusRTU_buses) {
+    bus->loop();
+  }
+}
+
+ModbusRTU_bus::~ModbusRTU_bus()
+{
+  _stream = nullptr;
+
+  if (_easySerial != nullptr) {
+    delete _easySerial;
+    _easySerial = nullptr;
+  }
+}
+
+uint32_t ModbusRTU_bus::submit(const uint8_t     *frame,
+                               uint8_t            frameSize,
+                               uint16_t           timeout_ms,
+                               ModbusRTU_priority priority)
+{
+  if ((frame == nullptr) ||
+      (frameSize == 0) ||
+      (frameSize > MODBUS_MAX_REQUEST_SIZE) ||
+      (_transactions.size() >= MODBUS_BUS_MAX_QUEUE_SIZE)) {
+    return 0;
+  }
+
+  // Keep order of priority, the active transaction remains first.
+  auto it = _transactions.begin();
+
+  if (_waitingForReply && (it != _transactions.end())) {
+    ++it;
+  }
+
+  while (it != _transactions.end() && (it->done || (it->priority <= priority))) {
+    ++it;
+  }
+
+  # ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  # endif // ifdef USE_SECOND_HEAP
+
+  it = _transactions.emplace(it);
+
+  it->id         = _nextId++;
+  it->priority   = priority;
+  it->frameSize  = frameSize;
+  it->timeout_ms = timeout_ms;
+  memcpy(it->frame, frame, frameSize);
+
+  if (_nextId == 0) { _nextId = 1; }
+  return it->id;
+}
+
+bool ModbusRTU_bus::getResult(uint32_t id, uint8_t& errorcode, uint8_t *reply, uint16_t& replySize)
+{
+  for (auto it = _transactions.begin(); it != _transactions.end(); ++it) {
+    if (it->id == id) {
+      if (!it->done) {
+        return false;
+      }
+      errorcode = it->errorcode;
+      replySize = it->replySize;
+
+      if (reply != nullptr) {
+        memcpy(reply, it->reply, it->replySize);
+      }
+      _transactions.erase(it);
+      return true;
+    }
+  }
+
+  // Unknown transaction
+  errorcode = MODBUS_NODATA;
+  replySize = 0;
+  return true;
+}
+
+void ModbusRTU_bus::cancel(uint32_t id)
+{
+  for (auto it = _transactions.begin(); it != _transactions.end(); ++it) {
+    if (it->id == id) {
+      if (_waitingForReply && (it == _transactions.begin())) {
+        // Reply must still be received, so just mark it done.
+        it->attemptsLeft = 0;
+        it->id           = 0;
+      } else {
+        _transactions.erase(it);
+      }
+      return;
+    }
+  }
+}
+
+void ModbusRTU_bus::loop()
+{
+  if (_stream == nullptr) { return; }
+
+  if (_waitingForReply) {
+    Transaction& transaction = _transactions.front();
+
+    if (!receive(transaction)) {
+      return;
+    }
+    _waitingForReply = false;
+    _lastActivity    = getMicros64();
+
+    if (transaction.id == 0) {
+      // Cancelled
+      _transactions.pop_front();
+    } else if (!transaction.done) {
+      // Retry, keep it in front
+      transaction.replySize = 0;
+    } else if (_transactions.size() > 1) {
+      // Move to the back, so the next pending transaction is in front.
+      _transactions.splice(_transactions.end(), _transactions, _transactions.begin());
+    }
+  }
+
+  auto it = getNextPending();
+
+  if (it == _transactions.end()) {
+    return;
+  }
+
+  if (usecPassedSince(_lastActivity) < static_cast<int64_t>(_interFrameGap_us)) {
+    return;
+  }
+
+  if (it != _transactions.begin()) {
+    _transactions.splice(_transactions.begin(), _transactions, it);
+  }
+  send(_transactions.front());
+}
+
+ModbusRTU_slave_stats ModbusRTU_bus::getSlaveStats(uint8_t slaveAddress) const
+{
+  auto it = _slaveStats.find(slaveAddress);
+
+  if (it == _slaveStats.end()) {
+    return ModbusRTU_slave_stats();
+  }
+  return it->second;
+}
+
+std::list<ModbusRTU_bus::Transaction>::iterator ModbusRTU_bus::getNextPending()
+{
+  auto it = _transactions.begin();
+
+  while (it != _transactions.end() && it->done) {
+    ++it;
+  }
+  return it;
+}
+
+void ModbusRTU_bus::send(Transaction& transaction)
+{
+  // Discard any data received outside a transaction
+  while (_stream->available()) {
+    _stream->read();
+  }
+  transaction.replySize = 0;
+
+  setTransmitMode(true);
+  _stream->write(transaction.frame, transaction.frameSize);
+
+  // sent all data from buffer
+  _stream->flush();
+  setTransmitMode(false);
+
+  _sendTime        = millis();
+  _timeout         = _sendTime + transaction.timeout_ms;
+  _waitingForReply = true;
+}
+
+bool ModbusRTU_bus::receive(Transaction& transaction)
+{
+  //  idx:    0,   1,   2,   3,   4,   5,   6,   7
+  // send: 0x02,0x03,0x00,0x00,0x00,0x01,0x39,0x84
+  // recv: 0x02,0x03,0x02,0x01,0x57,0xBC,0x2A
+  const bool invalidDueToTimeout = timeOutReached(_timeout);
+
+  while (_stream->available() && transaction.replySize < MODBUS_RECEIVE_BUFFER) {
+    transaction.reply[transaction.replySize++] = _stream->read();
+    _lastActivity                              = getMicros64();
+  }
+
+  bool validPacket = false;
+  bool frameEnded  = false;
+
+  if (transaction.replySize > 2) { // got length
+    // An exception reply only contains the exception code
+    const uint16_t packetSize = ((transaction.reply[1] & 0x80) != 0)
+      ? 5
+      : (3 + transaction.reply[2] + 2);
+
+    if (transaction.replySize >= packetSize) {                                                       // got whole pkt
+      validPacket = (ModbusRTU_struct::ModRTU_CRC(transaction.reply, transaction.replySize) == 0) && // crc16 is 0 for whole valid pkt
+                    (transaction.reply[0] == transaction.frame[0]);                                  // check address
+
+      // Silent interval of 3.5 characters marks the end of the frame
+      frameEnded = usecPassedSince(_lastActivity) > static_cast<int64_t>(_interFrameGap_us);
+    }
+  }
+
+  if (!validPacket && !frameEnded && !invalidDueToTimeout && (transaction.replySize < MODBUS_RECEIVE_BUFFER)) {
+    // Still waiting for the reply
+    return false;
+  }
+
+  ModbusRTU_slave_stats& stats = _slaveStats[transaction.frame[0]];
+  uint8_t return_value         = 0;
+
+  if (validPacket) {
+    const uint8_t received_functionCode = transaction.reply[1];
+
+    if ((received_functionCode & 0x80) != 0) {
+      // Check for MODBUS exception
+      return_value = transaction.reply[2];
+    }
+    const uint32_t latency = timePassedSince(_sendTime);
+    ++stats.pass;
+    stats.nodata            = 0;
+    stats.latency_total_ms += latency;
+
+    if (latency > stats.latency_max_ms) {
+      stats.latency_max_ms = latency;
+    }
+  } else if (invalidDueToTimeout && !frameEnded) {
+    ++stats.nodata;
+
+    if (transaction.replySize == 0) {
+      return_value = MODBUS_NODATA;
+    } else {
+      return_value = MODBUS_TIMEOUT;
+    }
+  } else {
+    ++stats.crc_failed;
+    return_value = MODBUS_BADCRC;
+  }
+  transaction.errorcode = return_value;
+
+  if (transaction.attemptsLeft > 0) {
+    --transaction.attemptsLeft;
+  }
+
+  switch (return_value) {
+    case MODBUS_EXCEPTION_ACKNOWLEDGE:
+    case MODBUS_EXCEPTION_SLAVE_OR_SERVER_BUSY:
+    case MODBUS_BADCRC:
+    case MODBUS_TIMEOUT:
+
+      // Bad communication, makes sense to retry.
+      transaction.done = transaction.attemptsLeft == 0;
+      break;
+    default:
+      transaction.done = true; // When not supported, does not make sense to retry.
+      break;
+  }
+  return true;
+}
+
+void ModbusRTU_bus::setTransmitMode(bool transmit)
+{
+  if (_dere_pin == -1) { return; }
+
+  if (transmit) {
+    // transmit to device  -> DE Enable, /RE Disable (for control MAX485)
+    digitalWrite(_dere_pin, HIGH);
+    delay(2); // Switching may take some time
+  } else {
+    // receive from device -> DE Disable, /RE Enable (for control MAX485)
+    digitalWrite(_dere_pin, LOW);
+  }
+}
+
+#endif // if FEATURE_MODBUS
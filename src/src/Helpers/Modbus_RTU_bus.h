@@ -0,0 +1,150 @@
+#ifndef HELPERS_MODBUS_RTU_BUS_H
+#define HELPERS_MODBUS_RTU_BUS_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MODBUS
+
+# include "../Helpers/Modbus_RTU.h"
+
+# include <ESPeasySerial.h>
+
+# include <list>
+# include <map>
+
+// Max. number of transactions queued per bus
+# ifndef MODBUS_BUS_MAX_QUEUE_SIZE
+#  define MODBUS_BUS_MAX_QUEUE_SIZE  16
+# endif // ifndef MODBUS_BUS_MAX_QUEUE_SIZE
+
+// Max. size of a request frame, including CRC
+# define MODBUS_MAX_REQUEST_SIZE     12
+
+
+enum class ModbusRTU_priority : uint8_t {
+  High,  // e.g. a caller waiting for the reply
+  Normal,
+  Low    // e.g. periodic reads
+};
+
+struct ModbusRTU_slave_stats {
+  uint32_t getAvgLatency_ms() const;
+
+  uint32_t pass{};          // Valid replies, including exceptions
+  uint32_t crc_failed{};    // Invalid replies
+  uint32_t nodata{};        // Timeouts since last valid reply
+  uint32_t latency_total_ms{};
+  uint16_t latency_max_ms{};
+};
+
+/*********************************************************************************************\
+* ModbusRTU_bus
+* Shared by all tasks using Modbus RTU on the same serial port, so requests of several tasks
+* do not collide on the bus.
+*
+* Transactions are queued in order of priority and processed one at a time from loop(),
+* without blocking while waiting for the reply.
+* Between transactions a silent interval of at least 3.5 characters is kept.
+* Statistics are kept per slave address.
+*
+* The transport is any Stream, the RS485 direction is switched via setTransmitMode().
+\*********************************************************************************************/
+class ModbusRTU_bus {
+public:
+
+  // Use an already opened stream, not shared via acquire().
+  // Caller must call loop() to process the transactions.
+  ModbusRTU_bus(Stream & stream,
+                uint32_t baudrate,
+                int8_t   dere_pin = -1);
+
+  virtual ~ModbusRTU_bus();
+
+  // Get the bus for the serial port, opened on first use.
+  // Return nullptr when the port is already in use with another baud rate or DE/RE pin.
+  static ModbusRTU_bus* acquire(ESPEasySerialPort port,
+                                int16_t           serial_rx,
+                                int16_t           serial_tx,
+                                uint32_t          baudrate,
+                                int8_t            dere_pin);
+
+  // The bus is closed when released by its last user.
+  static void release(ModbusRTU_bus *bus);
+
+  // Process the transactions of all buses.
+  static void loopAll();
+
+  // Queue the request frame, including CRC.
+  // Return the transaction ID, or 0 when not queued.
+  uint32_t submit(const uint8_t     *frame,
+                  uint8_t            frameSize,
+                  uint16_t           timeout_ms,
+                  ModbusRTU_priority priority);
+
+  // Return true when the transaction is done.
+  // The reply is then copied to reply (MODBUS_RECEIVE_BUFFER bytes) and the transaction is removed.
+  bool getResult(uint32_t  id,
+                 uint8_t & errorcode,
+                 uint8_t  *reply,
+                 uint16_t& replySize);
+
+  void cancel(uint32_t id);
+
+  // Process the transactions, without waiting for a reply.
+  void loop();
+
+  ModbusRTU_slave_stats getSlaveStats(uint8_t slaveAddress) const;
+
+protected:
+
+  // Switch the RS485 transceiver between transmit and receive.
+  // Default: DE/RE pin of a MAX485, when set.
+  virtual void setTransmitMode(bool transmit);
+
+private:
+
+  struct Transaction {
+    uint32_t           id{};
+    ModbusRTU_priority priority = ModbusRTU_priority::Normal;
+    uint8_t            frame[MODBUS_MAX_REQUEST_SIZE]{};
+    uint8_t            frameSize{};
+    uint8_t            reply[MODBUS_RECEIVE_BUFFER]{};
+    uint16_t           replySize{};
+    uint16_t           timeout_ms{};
+    uint8_t            attemptsLeft = 2;
+    uint8_t            errorcode{};
+    bool               done = false;
+  };
+
+  // First transaction not yet done
+  std::list<Transaction>::iterator getNextPending();
+
+  void                             send(Transaction& transaction);
+
+  // Return true when the active transaction is finished
+  bool                             receive(Transaction& transaction);
+
+  std::list<Transaction> _transactions;
+
+  std::map<uint8_t, ModbusRTU_slave_stats> _slaveStats;
+
+  Stream *_stream            = nullptr;
+  ESPeasySerial *_easySerial = nullptr; // Owned by the bus when opened via acquire()
+  ESPEasySerialPort _port    = ESPEasySerialPort::not_set;
+  int16_t  _serial_rx        = -1;
+  int16_t  _serial_tx        = -1;
+  uint32_t _baudrate         = 0;
+  int8_t   _dere_pin         = -1;
+  uint8_t  _users            = 0;
+
+  uint32_t _nextId           = 1;
+  uint32_t _interFrameGap_us = 0;
+  uint64_t _lastActivity     = 0;
+  unsigned long _sendTime    = 0;
+  unsigned long _timeout     = 0;
+  bool     _waitingForReply  = false;
+};
+
+#endif // if FEATURE_MODBUS
+
+#endif // ifndef HELPERS_MODBUS_RTU_BUS_H
@@ -255,6 +255,115 @@ void updateUDPport(bool force)
    Check UDP messages (ESPEasy propiertary protocol)
 \*********************************************************************************************/
 boolean runningUPDCheck = false;
+
+static UDP_message_stats_t UDP_message_stats[UDP_STATS_MESSAGE_TYPES];
+
+// Buffer to receive UDP packets, allocated on first use and kept to prevent heap fragmentation.
+// It is 1 byte larger than UDP_PACKETSIZE_MAX so we can 0-terminate it
+// in case it is some plain text string
+static std::vector<char> UDP_packetBuffer;
+
+const UDP_message_stats_t& getUDP_message_stats(uint8_t messageType)
+{
+  if (messageType >= UDP_STATS_MESSAGE_TYPES) {
+    messageType = UDP_STATS_MESSAGE_TYPES - 1;
+  }
+  return UDP_message_stats[messageType];
+}
+
+static UDP_message_stats_t& getUDP_message_stats(const char *data, int len)
+{
+  uint8_t messageType = 0;
+
+  if ((len >= 2) && (static_cast<uint8_t>(data[0]) == 255)) {
+    messageType = static_cast<uint8_t>(data[1]);
+
+    if ((messageType == 0) || (messageType >= UDP_STATS_MESSAGE_TYPES)) {
+      messageType = UDP_STATS_MESSAGE_TYPES - 1;
+    }
+  }
+  return UDP_message_stats[messageType];
+}
+
+// Return false when the packet was not processed
+static bool processUDPpacket(char *packetBuffer, int len, const IPAddress& remoteIP)
+{
+  if (static_cast<uint8_t>(packetBuffer[0]) != 255)
+  {
+    packetBuffer[len] = 0;
+    # ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLogMove(LOG_LEVEL_DEBUG,  
+        strformat(F("UDP  : %s  Command: %s"), 
+          formatIP(remoteIP, true).c_str(), 
+          wrapWithQuotesIfContainsParameterSeparatorChar(String(packetBuffer)).c_str()
+          ));
+    }
+    #endif
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_SYSTEM, packetBuffer}, true);
+    return true;
+  }
+
+  // binary data!
+  switch (packetBuffer[1])
+  {
+    case 1: // sysinfo message
+    {
+      if (len < 13) {
+        return false;
+      }
+      int copy_length = sizeof(NodeStruct);
+      // Older versions sent 80 bytes, regardless of the size of NodeStruct
+      // Make sure the extra data received is ignored as it was also not initialized
+      if (len == 80) {
+        copy_length = 56;
+      }
+
+      if (copy_length > (len - 2)) {
+        copy_length = (len - 2);
+      }
+      NodeStruct received;
+      memcpy(&received, &packetBuffer[2], copy_length);
+
+      if (!received.validate(remoteIP)) {
+        return false;
+      }
+      Nodes.addNode(received); // Create a new element when not present
+
+# ifndef BUILD_NO_DEBUG
+
+      if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+        addLogMove(LOG_LEVEL_DEBUG_MORE,  
+          strformat(F("UDP  : %s (%d) %s,%s,%d"), 
+            formatIP(remoteIP).c_str(), 
+            received.unit,
+            received.STA_MAC().toString().c_str(), 
+            formatIP(received.IP(), true).c_str(), 
+            received.unit));
+      }
+
+#endif // ifndef BUILD_NO_DEBUG
+      break;
+    }
+
+    default:
+    {
+      // Data is processed directly from the receive buffer
+      struct EventStruct TempEvent;
+      TempEvent.Data = reinterpret_cast<uint8_t *>(packetBuffer);
+      TempEvent.Par1 = remoteIP[3];
+      TempEvent.Par2 = len;
+      String dummy;
+      // TD-er: Disabled the PLUGIN_UDP_IN call as we don't have any plugin using this.
+      //PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
+      CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
+      break;
+    }
+  }
+  return true;
+}
+
 void checkUDP()
 {
   if (!NetworkConnected())
@@ -271,123 +380,47 @@ void checkUDP()
   runningUPDCheck = true;
 
   // UDP events
-  int packetSize = portUDP.parsePacket();
+  // Handle all pending packets, up to a maximum to keep other tasks running.
+  for (uint8_t i = 0; i < UDP_PACKETS_PER_CHECK; ++i) {
+    const int packetSize = portUDP.parsePacket();
 
-  if (packetSize > 0 /*&& portUDP.remotePort() == Settings.UDPPort*/)
-  {
+    if (packetSize <= 0 /*|| portUDP.remotePort() != Settings.UDPPort*/) {
+      break;
+    }
     statusLED(true);
 
-    IPAddress remoteIP = portUDP.remoteIP();
+    if (UDP_packetBuffer.empty()) {
+      UDP_packetBuffer.resize(UDP_PACKETSIZE_MAX + 1);
+    }
+    char *packetBuffer = &UDP_packetBuffer[0];
 
-    if (portUDP.remotePort() == 123)
-    {
-      // unexpected NTP reply, drop for now...
-      while (portUDP.available()) {
-        // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
-        portUDP.read();
-      }
+    const IPAddress remoteIP = portUDP.remoteIP();
 
-      runningUPDCheck = false;
-      return;
-    }
+    // unexpected NTP reply, drop for now...
+    const bool ntpReply = portUDP.remotePort() == 123;
 
     // UDP_PACKETSIZE_MAX should be as small as possible but still enough to hold all
     // data for PLUGIN_UDP_IN or CPLUGIN_UDP_IN calls
     // This node may also receive other UDP packets which may be quite large
     // and then crash due to memory allocation failures
-    if ((packetSize >= 2) && (packetSize < UDP_PACKETSIZE_MAX)) {
-      // Allocate buffer to process packet.
-      // Resize it to be 1 byte larger so we can 0-terminate it 
-      // in case it is some plain text string
-      std::vector<char> packetBuffer;
-      packetBuffer.resize(packetSize + 1);
-
-      if (packetBuffer.size() >= static_cast<size_t>(packetSize)) {
-        memset(&packetBuffer[0], 0, packetSize + 1);
-        int len = portUDP.read(&packetBuffer[0], packetSize);
-
-        if (len >= 2) {
-          if (static_cast<uint8_t>(packetBuffer[0]) != 255)
-          {
-            packetBuffer[len] = 0;
-            # ifndef BUILD_NO_DEBUG
-
-            if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-              addLogMove(LOG_LEVEL_DEBUG,  
-                strformat(F("UDP  : %s  Command: %s"), 
-                  formatIP(remoteIP, true).c_str(), 
-                  wrapWithQuotesIfContainsParameterSeparatorChar(String(&packetBuffer[0])).c_str()
-                  ));
-            }
-            #endif
-            ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_SYSTEM, &packetBuffer[0]}, true);
-          }
-          else
-          {
-            // binary data!
-            switch (packetBuffer[1])
-            {
-              case 1: // sysinfo message
-              {
-                if (len < 13) {
-                  break;
-                }
-                int copy_length = sizeof(NodeStruct);
-                // Older versions sent 80 bytes, regardless of the size of NodeStruct
-                // Make sure the extra data received is ignored as it was also not initialized
-                if (len == 80) {
-                  copy_length = 56;
-                }
-
-                if (copy_length > (len - 2)) {
-                  copy_length = (len - 2);
-                }
-                NodeStruct received;
-                memcpy(&received, &packetBuffer[2], copy_length);
-
-                if (received.validate(remoteIP)) {
-                  Nodes.addNode(received); // Create a new element when not present
-
-# ifndef BUILD_NO_DEBUG
+    // Of those only the header is read to keep track of the message type.
+    const bool oversized = packetSize >= UDP_PACKETSIZE_MAX;
+    const int  len       = portUDP.read(packetBuffer, oversized ? 2 : packetSize);
 
-                  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-                    addLogMove(LOG_LEVEL_DEBUG_MORE,  
-                      strformat(F("UDP  : %s (%d) %s,%s,%d"), 
-                        formatIP(remoteIP).c_str(), 
-                        received.unit,
-                        received.STA_MAC().toString().c_str(), 
-                        formatIP(received.IP(), true).c_str(), 
-                        received.unit));
-                  }
+    UDP_message_stats_t& stats = getUDP_message_stats(packetBuffer, len);
+    ++stats.received;
 
-#endif // ifndef BUILD_NO_DEBUG
-                }
-                break;
-              }
-
-              default:
-              {
-                struct EventStruct TempEvent;
-                TempEvent.Data = reinterpret_cast<uint8_t *>(&packetBuffer[0]);
-                TempEvent.Par1 = remoteIP[3];
-                TempEvent.Par2 = len;
-                String dummy;
-                // TD-er: Disabled the PLUGIN_UDP_IN call as we don't have any plugin using this.
-                //PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
-                CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
-                break;
-              }
-            }
-          }
-        }
-      }
+    // Flush any remaining content of the packet.
+    while (portUDP.available()) {
+      // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
+      portUDP.read(packetBuffer, UDP_PACKETSIZE_MAX);
     }
-  }
 
-  // Flush any remaining content of the packet.
-  while (portUDP.available()) {
-    // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
-    portUDP.read();
+    if (oversized) {
+      ++stats.oversized;
+    } else if (ntpReply || (len < 2) || !processUDPpacket(packetBuffer, len, remoteIP)) {
+      ++stats.dropped;
+    }
   }
   runningUPDCheck = false;
   STOP_TIMER(CHECK_UDP);
@@ -1706,6 +1739,44 @@ String send_via_http(const String& logIdentifier,
   HTTPClient http;
   http.setReuse(false);
 
+  const String response = send_via_http(
+    logIdentifier,
+    client,
+    http,
+    timeout,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    HttpMethod,
+    header,
+    postStr,
+    httpCode,
+    must_check_reply);
+
+  http.end();
+  // http.end() does not call client.stop() if it is no longer connected.
+  // However the client may still keep its internal state which may prevent 
+  // future connections to the same host until there has been a connection to another host inbetween.
+  client.stop(); 
+  return response;
+}
+
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply) {
   httpCode = http_authenticate(
     logIdentifier,
     client,
@@ -1731,11 +1802,6 @@ String send_via_http(const String& logIdentifier,
     }
 #endif
   }
-  http.end();
-  // http.end() does not call client.stop() if it is no longer connected.
-  // However the client may still keep its internal state which may prevent 
-  // future connections to the same host until there has been a connection to another host inbetween.
-  client.stop(); 
   return response;
 }
 #endif // FEATURE_HTTP_CLIENT
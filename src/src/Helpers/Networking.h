@@ -37,6 +37,21 @@ void updateUDPport(bool force);
 extern boolean runningUPDCheck;
 void checkUDP();
 
+/*********************************************************************************************\
+   Statistics of received UDP messages (ESPEasy propiertary protocol)
+   Message type 0 is used for plain text commands, other types are the binary message types.
+   All binary message types >= UDP_STATS_MESSAGE_TYPES - 1 are counted in the last element.
+\*********************************************************************************************/
+#define UDP_STATS_MESSAGE_TYPES  7
+
+struct UDP_message_stats_t {
+  uint32_t received  = 0;
+  uint32_t dropped   = 0; // Too short or otherwise not processed
+  uint32_t oversized = 0; // Larger than UDP_PACKETSIZE_MAX
+};
+
+const UDP_message_stats_t& getUDP_message_stats(uint8_t messageType);
+
 /*********************************************************************************************\
    Send event using UDP message to specific unit
 \*********************************************************************************************/
@@ -249,6 +264,23 @@ String send_via_http(const String& logIdentifier,
                      const String& postStr,
                      int         & httpCode,
                      bool          must_check_reply);
+
+// Send the request using the given client, the reply is only read when must_check_reply is set.
+// The caller has to call http.end() and decide whether to keep the connection open.
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply);
 #endif // FEATURE_HTTP_CLIENT
 
 #if FEATURE_DOWNLOAD
@@ -32,8 +32,10 @@
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/FS_Helper.h"
 #include "../Helpers/Hardware_temperature_sensor.h"
+#include "../Helpers/HTTP_connection_pool.h"
 #include "../Helpers/Memory.h"
 #include "../Helpers/Misc.h"
+#include "../Helpers/Modbus_RTU_bus.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/StringGenerator_System.h"
 #include "../Helpers/StringGenerator_WiFi.h"
@@ -64,6 +66,9 @@ void run50TimesPerSecond() {
     CPluginCall(CPlugin::Function::CPLUGIN_FIFTY_PER_SECOND, 0, dummy);
     STOP_TIMER(CPLUGIN_CALL_50PS);
   }
+  #if FEATURE_MODBUS
+  ModbusRTU_bus::loopAll();
+  #endif // if FEATURE_MODBUS
   processNextEvent();
 }
 
@@ -188,6 +193,10 @@ void runOncePerSecond()
   getInternalTemperature(); // Just read the value every second to hopefully get a valid next reading on original ESP32
   #endif // if FEATURE_INTERNAL_TEMPERATURE && defined(ESP32_CLASSIC)
 
+  #if FEATURE_HTTP_KEEPALIVE
+  HTTP_connection_pool_loop();
+  #endif // if FEATURE_HTTP_KEEPALIVE
+
   checkResetFactoryPin();
   STOP_TIMER(PLUGIN_CALL_1PS);
 }
@@ -415,7 +424,7 @@ void logTimerStatistics() {
 #ifndef BUILD_NO_DEBUG
 //  logStatistics(loglevel, true);
   if (loglevelActiveFor(loglevel)) {
-    String queueLog = F("Scheduler stats: (called/tasks/max_length/idle%) ");
+    String queueLog = F("Scheduler stats: (called/tasks/max_length/idle%/length/inserts/steps) ");
     queueLog += Scheduler.getQueueStats();
     addLogMove(loglevel, queueLog);
   }
@@ -474,6 +483,9 @@ void flushAndDisconnectAllClients() {
       updateMQTTclient_connected();
     }
 #endif //if FEATURE_MQTT
+#if FEATURE_HTTP_KEEPALIVE
+    closeAllHTTP_connections();
+#endif // if FEATURE_HTTP_KEEPALIVE
     saveToRTC();
     delay(100); // Flush anything in the network buffers.
   }
@@ -1,5 +1,6 @@
 #include "../Helpers/RulesHelper.h"
 
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/ESPEasy_Storage.h"
@@ -139,11 +140,31 @@ bool RulesHelperClass::findMatchingRule(const String& event, String& filename, s
   return true;
 }
 
+#if FEATURE_RULES_COMPILED
+bool RulesHelperClass::findMatchingBlock(const String& event, uint16_t& pc)
+{
+  if (!_eventCache.isInitialized()) {
+    init();
+  }
+  RulesEventCache_vector::const_iterator it = _eventCache.findMatchingRule(event, Settings.EnableRulesEventReorder());
+
+  if (it == _eventCache.end()) { return false; }
+
+  // Blocks are compiled in the same order as they are added to the event cache.
+  return _program.getBlockStart(it - _eventCache.begin(), pc);
+}
+
+#endif // if FEATURE_RULES_COMPILED
+
 void RulesHelperClass::init()
 {
   if (_eventCache.isInitialized()) { return; }
 
   // Read all files to populate caches.
+#if FEATURE_RULES_COMPILED
+  START_TIMER
+  _program.clear();
+#endif // if FEATURE_RULES_COMPILED
 
   for (uint8_t x = 0; x < RULESETS_MAX; x++) {
     // Read files
@@ -156,10 +177,15 @@ void RulesHelperClass::init()
       const size_t pos_start_line = pos;
       const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
 
-      if (_eventCache.addLine(
-            rulesLine,
-            filename,
-            pos_start_line)) {
+      const bool isOnLine = _eventCache.addLine(
+        rulesLine,
+        filename,
+        pos_start_line);
+#if FEATURE_RULES_COMPILED
+      _program.addLine(rulesLine, isOnLine);
+#endif // if FEATURE_RULES_COMPILED
+
+      if (isOnLine) {
 #ifndef BUILD_NO_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -174,8 +200,23 @@ void RulesHelperClass::init()
 #endif // ifndef BUILD_NO_DEBUG
       }
     }
+#if FEATURE_RULES_COMPILED
+    _program.endFile();
+#endif // if FEATURE_RULES_COMPILED
   }
   _eventCache.initialize();
+#if FEATURE_RULES_COMPILED
+  STOP_TIMER(RULES_COMPILE);
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG, strformat(
+                 F("Rules : Compiled %u instructions, %u bytes"),
+                 _program.size(),
+                 _program.getMemorySize()));
+  }
+# endif // ifndef BUILD_NO_DEBUG
+#endif // if FEATURE_RULES_COMPILED
 }
 
 void RulesHelperClass::closeAllFiles() {
@@ -188,6 +229,9 @@ void RulesHelperClass::closeAllFiles() {
     #endif // ifdef CACHE_RULES_IN_MEMORY
   }
   _eventCache.clear();
+#if FEATURE_RULES_COMPILED
+  _program.clear();
+#endif // if FEATURE_RULES_COMPILED
 }
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/RulesEventCache.h"
+#include "../DataStructs/RulesProgram.h"
 
 #include <FS.h>
 #include <map>
@@ -40,6 +41,19 @@ public:
                         String      & filename,
                         size_t      & pos);
 
+#if FEATURE_RULES_COMPILED
+
+  // Find the first compiled "on ... do" block matching the event.
+  // @param pc  Index of the On instruction in the compiled program.
+  bool findMatchingBlock(const String& event,
+                         uint16_t    & pc);
+
+  const RulesProgram& getProgram() const {
+    return _program;
+  }
+
+#endif // if FEATURE_RULES_COMPILED
+
 private:
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -76,6 +90,10 @@ private:
 
   RulesEventCache _eventCache;
 
+#if FEATURE_RULES_COMPILED
+  RulesProgram _program;
+#endif // if FEATURE_RULES_COMPILED
+
   FileHandleMap _fileHandleMap;
 };
 
@@ -88,6 +88,9 @@ CalculateReturnCode RulesCalculate_t::push(ESPEASY_RULES_FLOAT_TYPE value)
     *(++sp) = value;
     return CalculateReturnCode::OK;
   }
+#if FEATURE_RULES_CALCULATE_COMPILED
+  _compileFailed = true;
+#endif
   return CalculateReturnCode::ERROR_STACK_OVERFLOW;
 }
 
@@ -97,6 +100,10 @@ ESPEASY_RULES_FLOAT_TYPE RulesCalculate_t::pop()
     return *(sp--);
   }
   else {
+#if FEATURE_RULES_CALCULATE_COMPILED
+    // Compiled program does not check for an empty stack
+    _compileFailed = true;
+#endif
     return 0.0;
   }
 }
@@ -310,6 +317,9 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
     ret = push(apply_operator(token[0], first, second));
+#if FEATURE_RULES_CALCULATE_COMPILED
+    emit(RulesCalculateOpcode::Binary, token[0]);
+#endif
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate operator %c: 1: %.2f 2: %.2f"), token[0], first, second));
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
@@ -319,6 +329,9 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first = pop();
 
     ret = push(apply_unary_operator(token[0], first));
+#if FEATURE_RULES_CALCULATE_COMPILED
+    emit(RulesCalculateOpcode::Unary, token[0]);
+#endif
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate unary %d: 1: %.2f"), token[0], first));
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
@@ -332,6 +345,9 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
     ret = push(apply_quinary_operator(token[0], first, second, third, fourth, fifth));
+#if FEATURE_RULES_CALCULATE_COMPILED
+    emit(RulesCalculateOpcode::Quinary, token[0]);
+#endif
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate quinary %d: 1: %.2f 2: %.2f 3: %.2f 4: %.2f 5: %.2f"), token[0], first, second, third, fourth, fifth));
 
   } else {
@@ -342,6 +358,18 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     //   addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate push value: %.2f token: %s"), value, token));
     // } else {
     //   addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate unknown token: %s"), token));
+#if FEATURE_RULES_CALCULATE_COMPILED
+      if ((_compiling != nullptr) && (_compiling->_values.size() < 255)) {
+        emit(RulesCalculateOpcode::Push, _compiling->_values.size());
+        _compiling->_values.push_back(value);
+        _compiling->_literals.emplace_back(token);
+      } else {
+        _compileFailed = true;
+      }
+    } else {
+      // Unknown token results in 0, only compile valid numbers
+      _compileFailed = true;
+#endif
     }
     ret = push(value); // If it is a value, push to the stack
 
@@ -403,6 +431,56 @@ unsigned int RulesCalculate_t::op_arg_count(const char c)
 */
 
 CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
+{
+#if FEATURE_RULES_CALCULATE_COMPILED
+  uint32_t key{};
+
+  if (!getSkeletonKey(input, key)) {
+    return parseAndCalculate(input, result);
+  }
+  ++_useCounter;
+
+  auto it = _programCache.find(key);
+
+  if (it != _programCache.end()) {
+    if (runProgram(it->second, input, result)) {
+      return CalculateReturnCode::OK;
+    }
+
+    // Hash collision or a number which could not be parsed.
+    return parseAndCalculate(input, result);
+  }
+
+  RulesCalculateProgram program;
+
+  _compiling     = &program;
+  _compileFailed = false;
+  const CalculateReturnCode ret = parseAndCalculate(input, result);
+
+  _compiling = nullptr;
+
+  if (!isError(ret) && !_compileFailed && setSkeleton(program, input)) {
+    if (_programCache.size() >= RULES_CALCULATE_CACHE_SIZE) {
+      // Remove least recently used
+      auto oldest = _programCache.begin();
+
+      for (auto it_lru = _programCache.begin(); it_lru != _programCache.end(); ++it_lru) {
+        if (it_lru->second._lastUsed < oldest->second._lastUsed) {
+          oldest = it_lru;
+        }
+      }
+      _programCache.erase(oldest);
+    }
+    program._lastUsed = _useCounter;
+    _programCache.emplace(key, std::move(program));
+  }
+  return ret;
+#else // if FEATURE_RULES_CALCULATE_COMPILED
+  return parseAndCalculate(input, result);
+#endif // if FEATURE_RULES_CALCULATE_COMPILED
+}
+
+CalculateReturnCode RulesCalculate_t::parseAndCalculate(const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
 {
 
   #ifndef BUILD_NO_RAM_TRACKER
@@ -538,6 +616,9 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
             ESPEASY_RULES_FLOAT_TYPE first = pop(); // Get last value from stack
             error = push(first); // push back
             error = push(first); // Push as a result of ()
+#if FEATURE_RULES_CALCULATE_COMPILED
+            emit(RulesCalculateOpcode::Dup, 0);
+#endif
             // addLog(LOG_LEVEL_INFO, strformat(F("doCalculate pop&push 2x last value: %.2f sl: %u"), first, sl));
           } else {
             error = RPNCalculate(token);
@@ -630,6 +711,11 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     *result = 0;
     return error;
   }
+#if FEATURE_RULES_CALCULATE_COMPILED
+  if (sp < globalstack) {
+    _compileFailed = true;
+  }
+#endif
   *result = *sp;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate2"));
@@ -637,6 +723,197 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   return CalculateReturnCode::OK;
 }
 
+#if FEATURE_RULES_CALCULATE_COMPILED
+template<typename F>
+bool RulesCalculate_t::forEachToken(const char *input, F& onToken)
+{
+  // Must split the tokens exactly like parseAndCalculate() does.
+  const char *strpos = input, *strend = input + strlen(input);
+  char token[TOKEN_LENGTH]{};
+  size_t tokenLength = 0;
+  char   c{}, oc{}, pc{};
+
+  if (input[0] == '=') {
+    ++strpos;
+
+    if (strpos < strend) {
+      c = *strpos;
+    }
+  }
+
+  while (strpos < strend)
+  {
+    if (tokenLength >= (TOKEN_LENGTH - 1)) { return false; }
+    oc = c;
+    c  = *strpos;
+
+    if (c != ' ')
+    {
+      const char *pcpos = strpos + 1;
+      pc = *pcpos;
+
+      while ((pcpos < strend) && (' ' == pc)) {
+        ++pcpos;
+        pc = *pcpos;
+      }
+
+      if ((pcpos >= strend)) {
+        pc = '\0';
+      }
+
+      if (is_number(oc, c, pc)) {
+        token[tokenLength] = c;
+        ++tokenLength;
+      } else {
+        if (!(is_operator(c) || is_unary_operator(c) || is_quinary_operator(c) ||
+              (c == ':') || (c == '(') || (c == ')'))) {
+          return false;
+        }
+
+        // A '(' does not end the current number token
+        if ((c != '(') && (tokenLength != 0)) {
+          token[tokenLength] = 0;
+
+          if (!onToken(token, c)) { return false; }
+          tokenLength = 0;
+        }
+
+        if (!onToken(nullptr, c)) { return false; }
+
+        if ((c == ':') || (c == '(')) {
+          c = 0; // reset
+        }
+      }
+    }
+    ++strpos;
+  }
+
+  if (tokenLength != 0) {
+    token[tokenLength] = 0;
+    return onToken(token, 0);
+  }
+  return true;
+}
+
+bool RulesCalculate_t::getSkeletonKey(const char *input, uint32_t& key)
+{
+  // FNV-1a hash over the skeleton
+  key = 2166136261UL;
+  auto onToken = [&key](const char *token, char c) -> bool {
+                   key ^= static_cast<uint8_t>(token == nullptr ? c : '#');
+                   key *= 16777619UL;
+                   return true;
+                 };
+
+  return forEachToken(input, onToken);
+}
+
+void RulesCalculate_t::emit(RulesCalculateOpcode opcode, uint8_t arg)
+{
+  if (_compiling != nullptr) {
+    _compiling->_instructions.emplace_back(opcode, arg);
+  }
+}
+
+bool RulesCalculate_t::setSkeleton(RulesCalculateProgram& program, const char *input)
+{
+  // Only accept the program when the number tokens match the values used to compile it.
+  size_t index   = 0;
+  auto   onToken = [&program, &index](const char *token, char c) -> bool {
+                     if (token == nullptr) {
+                       program._skeleton += c;
+                       return true;
+                     }
+
+                     if ((index >= program._literals.size()) ||
+                         (strcmp(program._literals[index].c_str(), token) != 0)) {
+                       return false;
+                     }
+                     ++index;
+                     program._skeleton += '#';
+                     return true;
+                   };
+
+  return forEachToken(input, onToken) && (index == program._literals.size());
+}
+
+bool RulesCalculate_t::runProgram(RulesCalculateProgram& program, const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
+{
+  size_t index = 0;
+  size_t pos   = 0;
+  const size_t skeletonLength = program._skeleton.length();
+  const char  *skeleton       = program._skeleton.c_str();
+
+  auto onToken = [&](const char *token, char c) -> bool {
+                   if ((pos >= skeletonLength) ||
+                       (skeleton[pos++] != (token == nullptr ? c : '#'))) {
+                     return false;
+                   }
+
+                   if (token == nullptr) {
+                     return true;
+                   }
+
+                   if (index >= program._literals.size()) {
+                     return false;
+                   }
+
+                   // Only parse numbers which have changed since last run.
+                   if (strcmp(program._literals[index].c_str(), token) != 0) {
+                     ESPEASY_RULES_FLOAT_TYPE value{};
+
+                     if (is_operator(token[0]) && (token[1] == 0)) {
+                       return false;
+                     }
+
+                     if (!validDoubleFromString(token, value)) {
+                       return false;
+                     }
+                     program._values[index]   = value;
+                     program._literals[index] = token;
+                   }
+                   ++index;
+                   return true;
+                 };
+
+  if (!forEachToken(input, onToken) ||
+      (pos != skeletonLength) ||
+      (index != program._literals.size())) {
+    return false;
+  }
+  program._lastUsed = _useCounter;
+
+  // All stack checks were done while compiling, stack depth does not depend on the values.
+  sp = globalstack - 1;
+
+  for (const RulesCalculateInstruction& instruction : program._instructions) {
+    switch (instruction._opcode) {
+      case RulesCalculateOpcode::Push:
+        *(++sp) = program._values[instruction._arg];
+        break;
+      case RulesCalculateOpcode::Dup:
+        ++sp;
+        *sp = *(sp - 1);
+        break;
+      case RulesCalculateOpcode::Binary:
+        --sp;
+        *sp = apply_operator(instruction._arg, *sp, *(sp + 1));
+        break;
+      case RulesCalculateOpcode::Unary:
+        *sp = apply_unary_operator(instruction._arg, *sp);
+        break;
+      case RulesCalculateOpcode::Quinary:
+        sp -= 4;
+        *sp = apply_quinary_operator(instruction._arg, sp[0], sp[1], sp[2], sp[3], sp[4]);
+        break;
+    }
+  }
+  *result = *sp;
+  return true;
+}
+
+#endif // if FEATURE_RULES_CALCULATE_COMPILED
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
@@ -715,6 +992,10 @@ const __FlashStringHelper* toString(UnaryOperator op)
 
 String RulesCalculate_t::preProces(const String& input)
 {
+  if (input.indexOf('(') == -1) {
+    // All multi character operators are followed by a '('
+    return input;
+  }
   String preprocessed = input;
 
   const UnaryOperator operators[] = {
@@ -17,6 +17,16 @@
 #endif
 #define OPERATOR_STACK_SIZE 32
 
+#if FEATURE_RULES_CALCULATE_COMPILED
+# include <map>
+# include <vector>
+
+// Max. number of compiled expressions kept in memory
+# ifndef RULES_CALCULATE_CACHE_SIZE
+#  define RULES_CALCULATE_CACHE_SIZE 16
+# endif
+#endif // if FEATURE_RULES_CALCULATE_COMPILED
+
 enum class CalculateReturnCode : uint8_t{
   OK                           = 0u,
   ERROR_STACK_OVERFLOW         = 1u,
@@ -62,6 +72,42 @@ void   preProcessReplace(String      & input,
 bool   angleDegree(UnaryOperator op);
 const __FlashStringHelper* toString(UnaryOperator op);
 
+#if FEATURE_RULES_CALCULATE_COMPILED
+
+/********************************************************************************************\
+   Compiled expression in RPN (Reverse Polish Notation)
+   The program only depends on the 'skeleton' of the expression, which is the expression
+   with all numbers replaced by a '#'.
+   Values substituted in an expression (e.g. [bme#temp]) change the numbers, not the skeleton.
+   So the same program can be used again, only numbers which have changed need to be parsed.
+ \*********************************************************************************************/
+enum class RulesCalculateOpcode : uint8_t {
+  Push,    // Push _values[_arg]
+  Dup,     // Duplicate top of stack, result of "()"
+  Binary,  // _arg is operator: + - * / % ^
+  Unary,   // _arg is UnaryOperator
+  Quinary  // _arg is UnaryOperator::Map
+};
+
+struct RulesCalculateInstruction {
+  RulesCalculateInstruction(RulesCalculateOpcode opcode, uint8_t arg)
+    : _opcode(opcode), _arg(arg) {}
+
+  RulesCalculateOpcode _opcode;
+  uint8_t              _arg;
+};
+
+struct RulesCalculateProgram {
+  std::vector<RulesCalculateInstruction> _instructions;
+  std::vector<ESPEASY_RULES_FLOAT_TYPE>  _values;
+
+  // Text of each number, to detect a changed value without parsing it again.
+  std::vector<String> _literals;
+  String              _skeleton;
+  uint32_t            _lastUsed = 0;
+};
+#endif // if FEATURE_RULES_CALCULATE_COMPILED
+
 class RulesCalculate_t {
 private:
 
@@ -104,6 +150,39 @@ private:
 
   CalculateReturnCode RPNCalculate(char *token);
 
+  CalculateReturnCode parseAndCalculate(const char               *input,
+                                        ESPEASY_RULES_FLOAT_TYPE *result);
+
+#if FEATURE_RULES_CALCULATE_COMPILED
+
+  // Split the input into the same number tokens and operators as parseAndCalculate().
+  // onToken(token, c) is called with either a number token, or with token == nullptr and
+  // the next operator or parenthesis in c.
+  // Return false when the expression cannot be compiled, or onToken returned false.
+  template<typename F>
+  bool                forEachToken(const char *input,
+                                   F         & onToken);
+
+  bool                getSkeletonKey(const char *input,
+                                     uint32_t  & key);
+
+  // Record the instruction when compiling
+  void                emit(RulesCalculateOpcode opcode,
+                           uint8_t              arg);
+
+  bool                setSkeleton(RulesCalculateProgram& program,
+                                  const char            *input);
+
+  bool                runProgram(RulesCalculateProgram   & program,
+                                 const char               *input,
+                                 ESPEASY_RULES_FLOAT_TYPE *result);
+
+  std::map<uint32_t, RulesCalculateProgram> _programCache;
+  RulesCalculateProgram *_compiling     = nullptr;
+  bool                   _compileFailed = false;
+  uint32_t               _useCounter    = 0;
+#endif // if FEATURE_RULES_CALCULATE_COMPILED
+
   // operators
   // precedence   operators         associativity
   // 4            !                 right to left
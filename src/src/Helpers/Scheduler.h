@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/EventStructCommandWrapper.h"
+#include "../DataStructs/MQTT_subscription_router.h"
 #include "../DataStructs/SchedulerTimerID.h"
 #include "../DataStructs/SystemTimerStruct.h"
 
@@ -243,12 +244,15 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
                                         struct EventStruct&& event);
 
 #if FEATURE_MQTT
-  void schedule_mqtt_plugin_import_event_timer(deviceIndex_t  DeviceIndex,
-                                               taskIndex_t    TaskIndex,
-                                               uint8_t        Function,
-                                               const char    *c_topic,
-                                               const uint8_t *b_payload,
-                                               unsigned int   length);
+
+  // A single event is queued for all tasks set in the tasks bitmap.
+  // It is processed for one task at a time, before it is removed from the queue.
+  void schedule_mqtt_plugin_import_event_timer(deviceIndex_t   DeviceIndex,
+                                               MQTT_taskMask_t tasks,
+                                               uint8_t         Function,
+                                               const char     *c_topic,
+                                               const uint8_t  *b_payload,
+                                               unsigned int    length);
 #endif
 
 
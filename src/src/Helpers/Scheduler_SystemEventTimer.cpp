@@ -33,17 +33,31 @@ void ESPEasy_Scheduler::schedule_plugin_task_event_timer(
 }
 
 #if FEATURE_MQTT
+
+// The tasks still to process an MQTT import event are kept in Par1 (task 0 - 31) and Par2 (task 32 - 63)
+static MQTT_taskMask_t getMQTT_taskMask(const struct EventStruct& event) {
+  return (static_cast<MQTT_taskMask_t>(static_cast<uint32_t>(event.Par2)) << 32) |
+         static_cast<uint32_t>(event.Par1);
+}
+
+static void setMQTT_taskMask(struct EventStruct& event, MQTT_taskMask_t tasks) {
+  event.Par1 = static_cast<int>(static_cast<uint32_t>(tasks));
+  event.Par2 = static_cast<int>(static_cast<uint32_t>(tasks >> 32));
+}
+
 void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
-  deviceIndex_t  DeviceIndex,
-  taskIndex_t    TaskIndex,
-  uint8_t        Function,
-  const char    *c_topic,
-  const uint8_t *b_payload,
-  unsigned int   length) {
-  if (validDeviceIndex(DeviceIndex)) {
-    EventStruct  event(TaskIndex);
+  deviceIndex_t   DeviceIndex,
+  MQTT_taskMask_t tasks,
+  uint8_t         Function,
+  const char     *c_topic,
+  const uint8_t  *b_payload,
+  unsigned int    length) {
+  if (validDeviceIndex(DeviceIndex) && (tasks != 0)) {
+    EventStruct  event;
     const size_t topic_length = strlen_P(c_topic);
 
+    setMQTT_taskMask(event, tasks);
+
     if (!(reserve_special(event.String1, topic_length) &&
           reserve_special(event.String2, length))) {
       addLog(LOG_LEVEL_ERROR, F("MQTT : Out of Memory! Cannot process MQTT message"));
@@ -184,10 +198,40 @@ void ESPEasy_Scheduler::process_system_event_queue() {
   // Else the line string could be used.
   String tmpString;
 
+  // Keep the event in the queue, to process it again on the next call
+  bool keepEvent = false;
+
   switch (ptr_type) {
     case SchedulerPluginPtrType_e::TaskPlugin:
     {
-      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(Index);
+      deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(Index);
+
+#if FEATURE_MQTT
+
+      if (Function == PLUGIN_MQTT_IMPORT) {
+        // Process the shared message for the next task in the bitmap.
+        // Only a single task per call, like when each task would have its own event.
+        struct EventStruct& event = ScheduledEventQueue.front().event;
+        MQTT_taskMask_t     tasks = getMQTT_taskMask(event);
+
+        if (tasks != 0) {
+          const taskIndex_t taskIndex = __builtin_ctzll(tasks);
+          tasks    &= tasks - 1;
+          keepEvent = tasks != 0;
+          setMQTT_taskMask(event, tasks);
+          event.setTaskIndex(taskIndex);
+
+          if (!validTaskIndex(taskIndex) ||
+              !Settings.TaskDeviceEnabled[taskIndex] ||
+              (getDeviceIndex_from_TaskIndex(taskIndex) != deviceIndex)) {
+            // Task was changed after the message was received
+            deviceIndex = INVALID_DEVICE_INDEX;
+          }
+        } else {
+          deviceIndex = INVALID_DEVICE_INDEX;
+        }
+      }
+#endif // if FEATURE_MQTT
 
       if (validDeviceIndex(deviceIndex)) {
         if (((Function != PLUGIN_READ) &&
@@ -218,6 +262,8 @@ void ESPEasy_Scheduler::process_system_event_queue() {
       break;
 #endif // if FEATURE_NOTIFIER
   }
-  ScheduledEventQueue.pop_front();
+  if (!keepEvent) {
+    ScheduledEventQueue.pop_front();
+  }
   STOP_TIMER(PROCESS_SYSTEM_EVENT_QUEUE);
 }
@@ -1,134 +1,218 @@
 #include "../Helpers/SerialWriteBuffer.h"
 
+#include "../Helpers/Hardware_device_info.h"
 #include "../Helpers/Memory.h"
 
-void SerialWriteBuffer_t::add(const String& line)
+SerialWriteBuffer_t::SerialWriteBuffer_t(size_t maxSize)
 {
-  // When the buffer is too full, try to dump at least the size of what we try to add.
-  const bool mustPop = _buffer.size() > _maxSize;
-  {
-    #ifdef USE_SECOND_HEAP
+  // Largest power of 2 which fits in maxSize
+  _capacity = 1;
 
-    // Do not store in 2nd heap, std::dequeue cannot handle 2nd heap well
-    HeapSelectDram ephemeral;
-    #endif // ifdef USE_SECOND_HEAP
-    int roomLeft = getRoomLeft();
+  while ((_capacity << 1) <= maxSize) {
+    _capacity <<= 1;
+  }
+  _maxCapacity = _capacity;
+}
 
-    auto it = line.begin();
+SerialWriteBuffer_t::~SerialWriteBuffer_t()
+{
+  clear();
+}
 
-    while (roomLeft > 0 && it != line.end()) {
-      if (mustPop) {
-        _buffer.pop_front();
-      }
-      _buffer.push_back(*it);
-      --roomLeft;
-      ++it;
-    }
-  }
+void SerialWriteBuffer_t::add(const String& line)
+{
+  append(line.c_str(), line.length(), false);
 }
 
 void SerialWriteBuffer_t::add(const __FlashStringHelper *line)
 {
-  add(String(line));
+  const char *p_line = reinterpret_cast<const char *>(line);
+
+  append(p_line, strlen_P(p_line), true);
 }
 
 void SerialWriteBuffer_t::add(char c)
 {
-  #ifdef USE_SECOND_HEAP
-
-  // Do not store in 2nd heap, std::dequeue cannot handle 2nd heap well
-  HeapSelectDram ephemeral;
-  #endif // ifdef USE_SECOND_HEAP
+  append(&c, 1, false);
+}
 
-  if (_buffer.size() > _maxSize) {
-    _buffer.pop_front();
-  }
-  _buffer.push_back(c);
+void SerialWriteBuffer_t::add(const char *data, size_t length)
+{
+  append(data, length, false);
 }
 
 void SerialWriteBuffer_t::addNewline()
 {
-  add('\r');
-  add('\n');
+  append("\r\n", 2, false);
 }
 
 void SerialWriteBuffer_t::clear()
 {
-  _buffer.clear();
+  _head = 0;
+  _tail = 0;
+
+  if (_buffer != nullptr) {
+    free(_buffer);
+    _buffer = nullptr;
+  }
 }
 
 size_t SerialWriteBuffer_t::write(Stream& stream, size_t nrBytesToWrite)
 {
-  size_t bytesWritten     = 0;
-  const size_t bufferSize = _buffer.size();
+  size_t bytesWritten = 0;
+
+  while (nrBytesToWrite > 0 && size() > 0) {
+    // Largest contiguous part, up to the end of the buffer
+    const size_t pos     = _tail & (_capacity - 1);
+    size_t       toWrite = std::min(size(), _capacity - pos);
+
+    if (toWrite > nrBytesToWrite) {
+      toWrite = nrBytesToWrite;
+    }
+    const size_t written = stream.write(reinterpret_cast<const uint8_t *>(_buffer + pos), toWrite);
+
+    _tail          += written;
+    bytesWritten   += written;
+    nrBytesToWrite -= written;
+
+    if (written < toWrite) {
+      break;
+    }
+  }
+
+  if ((bytesWritten > 0) && (size() == 0)) {
+    // Free a buffer which was reduced in size, or when memory is low
+    if ((_capacity < _maxCapacity) || (getMaxFreeBlock() < 4000)) {
+      clear();
+    }
+  }
+  return bytesWritten;
+}
+
+size_t SerialWriteBuffer_t::read(Stream& stream, size_t nrBytesToRead)
+{
+  size_t bytesRead = 0;
 
-  if (bufferSize == 0) {
-    return bytesWritten;
+  if ((nrBytesToRead == 0) || !allocate()) {
+    return bytesRead;
   }
 
-  if (nrBytesToWrite > 0) {
-    if (nrBytesToWrite > bufferSize) {
-      nrBytesToWrite = bufferSize;
+  while (nrBytesToRead > 0 && size() < _capacity) {
+    // Largest contiguous free part, up to the end of the buffer
+    const size_t pos    = _head & (_capacity - 1);
+    size_t       toRead = std::min(_capacity - size(), _capacity - pos);
+
+    if (toRead > nrBytesToRead) {
+      toRead = nrBytesToRead;
     }
+    const size_t received = stream.readBytes(_buffer + pos, toRead);
 
-    while (nrBytesToWrite > 0 && !_buffer.empty()) {
-      uint8_t tmpBuffer[16]{};
+    _head         += received;
+    bytesRead     += received;
+    nrBytesToRead -= received;
 
-      size_t tmpBufferUsed = 0;
+    if (received < toRead) {
+      break;
+    }
+  }
 
-      auto it = _buffer.begin();
+  if (size() > _highWatermark) {
+    _highWatermark = size();
+  }
+  return bytesRead;
+}
 
-      bool done = false;
+void SerialWriteBuffer_t::append(const char *data, size_t length, bool isPROGMEM)
+{
+  if ((data == nullptr) || (length == 0)) {
+    return;
+  }
 
-      for (; tmpBufferUsed < sizeof(tmpBuffer) &&
-           !done &&
-           it != _buffer.end();) {
-        tmpBuffer[tmpBufferUsed] = (uint8_t)(*it);
+  if (!allocate()) {
+    _droppedBytes += length;
+    return;
+  }
 
-        if ((*it == '\n') ||
-            (tmpBufferUsed >= nrBytesToWrite)) {
-          done = true;
-        }
-        ++tmpBufferUsed;
-        ++it;
-      }
+  if (length > _capacity) {
+    // Only the last part will fit
+    _droppedBytes += length - _capacity;
+    data          += length - _capacity;
+    length         = _capacity;
+  }
+  makeRoom(length);
 
-      //      done = false;
-      const size_t written = (tmpBufferUsed == 0) ? 0 : stream.write(tmpBuffer, tmpBufferUsed);
+  while (length > 0) {
+    const size_t pos   = _head & (_capacity - 1);
+    const size_t chunk = std::min(length, _capacity - pos);
 
-      if (written < tmpBufferUsed) {
-        done = true;
-      }
+    if (isPROGMEM) {
+      memcpy_P(_buffer + pos, data, chunk);
+    } else {
+      memcpy(_buffer + pos, data, chunk);
+    }
+    _head  += chunk;
+    data   += chunk;
+    length -= chunk;
+  }
 
-      for (size_t i = 0; i < written; ++i) {
-        _buffer.pop_front();
-        --nrBytesToWrite;
-        ++bytesWritten;
+  if (size() > _highWatermark) {
+    _highWatermark = size();
+  }
+}
+
+bool SerialWriteBuffer_t::allocate()
+{
+  if (_buffer == nullptr) {
+    _head = 0;
+    _tail = 0;
+    size_t allocSize = _maxCapacity;
+
+    #ifdef ESP32
+
+    // Allocated in PSRAM, so no need to spare the heap.
+    if (!UsePSRAM())
+    #endif // ifdef ESP32
+    {
+      const unsigned long maxFreeBlock = getMaxFreeBlock();
+
+      if (maxFreeBlock < 1000) {
+        // Do not buffer when memory is very low
+        return false;
       }
 
-      if (done) {
-        return bytesWritten;
+      // Leave some free for normal use.
+      while ((allocSize > MIN_SERIALWRITEBUFFER_SIZE) && ((allocSize + 4000) > maxFreeBlock)) {
+        allocSize >>= 1;
       }
     }
+    _buffer = static_cast<char *>(special_calloc(1, allocSize));
+
+    if (_buffer != nullptr) {
+      _capacity = allocSize;
+    }
   }
-  return bytesWritten;
+  return _buffer != nullptr;
 }
 
-int SerialWriteBuffer_t::getRoomLeft() const {
-  #ifdef USE_SECOND_HEAP
+void SerialWriteBuffer_t::makeRoom(size_t length)
+{
+  const size_t roomLeft = _capacity - size();
 
-  // Do not store in 2nd heap, std::dequeue cannot handle 2nd heap well
-  HeapSelectDram ephemeral;
-  #endif // ifdef USE_SECOND_HEAP
+  if (roomLeft >= length) {
+    return;
+  }
+  const uint32_t minTail = _tail + (length - roomLeft);
+  uint32_t newTail       = minTail;
 
-  int roomLeft = getMaxFreeBlock();
+  // Drop up to the end of the line, to not output partial lines
+  while (newTail != _head && _buffer[(newTail - 1) & (_capacity - 1)] != '\n') {
+    ++newTail;
+  }
 
-  if (roomLeft < 1000) {
-    roomLeft = 0;                    // Do not append to buffer.
-  } else if (roomLeft < 4000) {
-    roomLeft = 128 - _buffer.size(); // 1 buffer.
-  } else {
-    roomLeft -= 4000;                // leave some free for normal use.
+  if (newTail == _head) {
+    // No line end found, only drop what is needed
+    newTail = minTail;
   }
-  return roomLeft;
+  _droppedBytes += newTail - _tail;
+  _tail          = newTail;
 }
@@ -3,40 +3,95 @@
 
 #include "../../ESPEasy_common.h"
 
-#include <deque>
-
+// Rounded down to a power of 2
 #ifndef MAX_SERIALWRITEBUFFER_SIZE
 # ifdef ESP8266
 #  define MAX_SERIALWRITEBUFFER_SIZE 1024
 # endif // ifdef ESP8266
 # ifdef ESP32
-#  define MAX_SERIALWRITEBUFFER_SIZE 10240
+#  define MAX_SERIALWRITEBUFFER_SIZE 8192
 # endif // ifdef ESP32
 #endif // ifndef MAX_SERIALWRITEBUFFER_SIZE
 
+// Smallest buffer to allocate when free memory is low
+#ifndef MIN_SERIALWRITEBUFFER_SIZE
+# define MIN_SERIALWRITEBUFFER_SIZE 128
+#endif // ifndef MIN_SERIALWRITEBUFFER_SIZE
+
+/*********************************************************************************************\
+* SerialWriteBuffer_t
+* Ring buffer, allocated on first use.
+* When free memory is low, a smaller buffer is allocated (or none at all)
+* and it is freed again once empty, to allow it to grow when memory is available.
+* When full, the oldest complete lines are dropped to make room.
+\*********************************************************************************************/
 class SerialWriteBuffer_t {
 public:
 
-  SerialWriteBuffer_t(size_t maxSize = MAX_SERIALWRITEBUFFER_SIZE)
-    : _maxSize(maxSize) {}
+  SerialWriteBuffer_t(size_t maxSize = MAX_SERIALWRITEBUFFER_SIZE);
+
+  SerialWriteBuffer_t(const SerialWriteBuffer_t&)            = delete;
+  SerialWriteBuffer_t& operator=(const SerialWriteBuffer_t&) = delete;
+
+  ~SerialWriteBuffer_t();
 
   void   add(const String& line);
   void   add(const __FlashStringHelper *line);
   void   add(char c);
+  void   add(const char *data,
+             size_t      length);
 
   void   addNewline();
 
+  // Clear the buffer and free its memory
   void   clear();
 
+  // Write at most nrBytesToWrite bytes, using as few calls to stream.write() as possible.
   size_t write(Stream& stream,
                size_t  nrBytesToWrite);
 
+  // Read at most nrBytesToRead bytes from stream directly into the buffer.
+  // Only reads what fits, so no data is dropped.
+  size_t read(Stream& stream,
+              size_t  nrBytesToRead);
+
+  size_t capacity() const {
+    return _capacity;
+  }
+
+  size_t size() const {
+    return _head - _tail;
+  }
+
+  uint32_t getDroppedBytes() const {
+    return _droppedBytes;
+  }
+
+  size_t getHighWatermark() const {
+    return _highWatermark;
+  }
+
 private:
 
-  int getRoomLeft() const;
+  void append(const char *data,
+              size_t      length,
+              bool        isPROGMEM);
+
+  bool allocate();
+
+  // Make room for length bytes by dropping the oldest lines
+  void makeRoom(size_t length);
+
+  char *_buffer = nullptr;
+  size_t _capacity{};
+  size_t _maxCapacity{};
+
+  // Free running positions, the position in the buffer is (pos & (_capacity - 1))
+  uint32_t _head{};
+  uint32_t _tail{};
 
-  std::deque<char>_buffer;
-  size_t _maxSize = MAX_SERIALWRITEBUFFER_SIZE;
+  uint32_t _droppedBytes{};
+  size_t   _highWatermark{};
 };
 
 #endif // ifndef HELPERS_SERIALWRITEBUFFER_H
@@ -644,80 +644,19 @@ void transformValue(
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
-taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled)
+taskIndex_t findTaskIndexByName(const String& deviceName, bool allowDisabled)
 {
-  deviceName.toLowerCase();
-  // cache this, since LoadTaskSettings does take some time.
-  auto result = Cache.taskIndexName.find(deviceName);
-
-  if (result != Cache.taskIndexName.end()) {
-    return result->second;
-  }
-
-  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
-  {
-    if (Settings.TaskDeviceEnabled[taskIndex] || allowDisabled) {
-      String taskDeviceName = getTaskDeviceName(taskIndex);
-
-      if (!taskDeviceName.isEmpty())
-      {
-        // Use entered taskDeviceName can have any case, so compare case insensitive.
-        if (deviceName.equalsIgnoreCase(taskDeviceName))
-        {
-          Cache.taskIndexName.emplace(
-            std::make_pair(
-              std::move(deviceName), 
-              taskIndex));
-          return taskIndex;
-        }
-      }
-    }
-  }
-  return INVALID_TASK_INDEX;
+  // Use the index, since LoadTaskSettings does take some time.
+  return Cache.taskNameIndex.findTask(deviceName, allowDisabled);
 }
 
 // Find the first device value index of a taskIndex.
 // Return VARS_PER_TASK if none found.
 uint8_t findDeviceValueIndexByName(const String& valueName, taskIndex_t taskIndex)
 {
-  const deviceIndex_t deviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
-
-  if (!validDeviceIndex(deviceIndex)) { return VARS_PER_TASK; }
-
-  #ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  #endif
-
-
-  // cache this, since LoadTaskSettings does take some time.
-  // We need to use a cache search key including the taskIndex,
-  // to allow several tasks to have the same value names.
-  String cache_valueName = strformat(
-    F("%s#%d"),                   // The '#' cannot exist in a value name, use it in the cache key.
-    valueName.c_str(),
-    static_cast<int>(taskIndex));
-  cache_valueName.toLowerCase();  // No need to store multiple versions of the same entry with only different case.
-  
-  auto result = Cache.taskIndexValueName.find(cache_valueName);
-
-  if (result != Cache.taskIndexValueName.end()) {
-    return result->second;
-  }
-  const uint8_t valCount = getValueCountForTask(taskIndex);
-
-  for (uint8_t valueNr = 0; valueNr < valCount; valueNr++)
-  {
-    // Check case insensitive, since the user entered value name can have any case.
-    if (valueName.equalsIgnoreCase(Cache.getTaskDeviceValueName(taskIndex, valueNr)))
-    {
-      Cache.taskIndexValueName.emplace(
-        std::make_pair(
-          std::move(cache_valueName), 
-          valueNr));
-      return valueNr;
-    }
-  }
-  return VARS_PER_TASK;
+  // Use the index, since LoadTaskSettings does take some time.
+  // Only tasks with a plugin assigned are present in the index.
+  return Cache.taskNameIndex.findValue(valueName, taskIndex);
 }
 
 // Find positions of [...#...] in the given string.
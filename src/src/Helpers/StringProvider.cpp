@@ -19,6 +19,7 @@
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/EventQueue.h"
 
 #if FEATURE_ETHERNET
 #include "../Globals/ESPEasyEthEvent.h"
@@ -83,6 +84,7 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
 
     case LabelType::FREE_MEM:               return F("Free RAM");
     case LabelType::FREE_STACK:             return F("Free Stack");
+    case LabelType::EVENT_QUEUE:            return F("Event Queue");
 #ifdef USE_SECOND_HEAP
     case LabelType::FREE_HEAP_IRAM:         return F("Free 2nd Heap");
 #endif
@@ -116,9 +118,11 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::ENABLE_RULES_CACHING:       return F("Enable Rules Cache");
     case LabelType::ENABLE_SERIAL_PORT_CONSOLE: return F("Enable Serial Port Console");
     case LabelType::CONSOLE_SERIAL_PORT:        return F("Console Serial Port");
+    case LabelType::CONSOLE_WRITE_BUFFER:       return F("Console Write Buffer");
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
     case LabelType::CONSOLE_FALLBACK_TO_SERIAL0: return F("Fallback to Serial 0");
     case LabelType::CONSOLE_FALLBACK_PORT:       return F("Console Fallback Port");
+    case LabelType::CONSOLE_FALLBACK_WRITE_BUFFER: return F("Console Fallback Write Buffer");
 #endif
 
 //    case LabelType::ENABLE_RULES_EVENT_REORDER: return F("Optimize Rules Cache Event Order"); // TD-er: Disabled for now
@@ -369,6 +373,11 @@ String getValue(LabelType::Enum label) {
 
     case LabelType::FREE_MEM:               retval = FreeMem(); break;
     case LabelType::FREE_STACK:             retval = getCurrentFreeStack(); break;
+    case LabelType::EVENT_QUEUE:
+      return strformat(F("%u (max: %u, dropped: %u)"),
+                       eventQueue.size(),
+                       eventQueue.getHighWatermark(),
+                       static_cast<unsigned int>(eventQueue.getDropCount()));
 
 #ifdef USE_SECOND_HEAP
     case LabelType::FREE_HEAP_IRAM:         retval = FreeMem2ndHeap(); break;
@@ -408,10 +417,12 @@ String getValue(LabelType::Enum label) {
     case LabelType::ENABLE_RULES_CACHING:       return jsonBool(Settings.EnableRulesCaching());
     case LabelType::ENABLE_SERIAL_PORT_CONSOLE: return jsonBool(Settings.UseSerial);
     case LabelType::CONSOLE_SERIAL_PORT:        return ESPEasy_Console.getPortDescription();
+    case LabelType::CONSOLE_WRITE_BUFFER:       return getWriteBufferStats(ESPEasy_Console.getWriteBuffer());
 
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
     case LabelType::CONSOLE_FALLBACK_TO_SERIAL0: return jsonBool(Settings.console_serial0_fallback);
     case LabelType::CONSOLE_FALLBACK_PORT:       return ESPEasy_Console.getFallbackPortDescription();
+    case LabelType::CONSOLE_FALLBACK_WRITE_BUFFER: return getWriteBufferStats(ESPEasy_Console.getFallbackWriteBuffer());
 #endif
 
 //    case LabelType::ENABLE_RULES_EVENT_REORDER: return jsonBool(Settings.EnableRulesEventReorder()); // TD-er: Disabled for now
@@ -643,6 +654,13 @@ String getValue(LabelType::Enum label) {
   return F("MissingString");
 }
 
+String getWriteBufferStats(const SerialWriteBuffer_t& buffer) {
+  return strformat(F("%u (max: %u, dropped: %u)"),
+                   static_cast<unsigned int>(buffer.size()),
+                   static_cast<unsigned int>(buffer.getHighWatermark()),
+                   static_cast<unsigned int>(buffer.getDroppedBytes()));
+}
+
 #if FEATURE_ETHERNET
 String getEthSpeed() {
   return strformat(F("%d [Mbps]"), EthLinkSpeed());
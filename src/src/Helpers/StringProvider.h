@@ -3,6 +3,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../Helpers/SerialWriteBuffer.h"
+
 struct LabelType {
   enum Enum : uint8_t {
     UNIT_NR,
@@ -33,6 +35,7 @@ struct LabelType {
 
     FREE_MEM,            // 9876
     FREE_STACK,          // 3456
+    EVENT_QUEUE,         // 0 (max: 12, dropped: 0)
 #ifdef USE_SECOND_HEAP
     FREE_HEAP_IRAM,
 #endif
@@ -65,9 +68,11 @@ struct LabelType {
     ENABLE_RULES_CACHING,
     ENABLE_SERIAL_PORT_CONSOLE,
     CONSOLE_SERIAL_PORT,
+    CONSOLE_WRITE_BUFFER,        // 0 (max: 512, dropped: 0)
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
     CONSOLE_FALLBACK_TO_SERIAL0,
     CONSOLE_FALLBACK_PORT,
+    CONSOLE_FALLBACK_WRITE_BUFFER,
 #endif
 //    ENABLE_RULES_EVENT_REORDER, // TD-er: Disabled for now
     TASKVALUESET_ALL_PLUGINS,
@@ -248,6 +253,8 @@ struct LabelType {
   };
 };
 
+// Current size, high watermark and dropped bytes of a serial write buffer
+String getWriteBufferStats(const SerialWriteBuffer_t& buffer);
 
 #if FEATURE_ETHERNET
 String getEthSpeed();
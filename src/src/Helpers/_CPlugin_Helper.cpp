@@ -22,6 +22,7 @@
 #include "../Globals/ESPEasyWiFiEvent.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/HTTP_connection_pool.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Network.h"
 #include "../Helpers/Networking.h"
@@ -243,19 +244,44 @@ String send_via_http(int                             cpluginID,
     : ControllerSettings.ClientTimeout;
 
   const uint64_t statisticsTimerStart(getMicros64());
-  const String result                    = send_via_http(
-    get_formatted_Controller_number(cpluginID),
-    timeout,
-    getControllerUser(controller_idx, ControllerSettings),
-    getControllerPass(controller_idx, ControllerSettings),
-    ControllerSettings.getHost(),
-    ControllerSettings.Port,
-    uri,
-    HttpMethod,
-    header,
-    postStr,
-    httpCode,
-    ControllerSettings.MustCheckReply);
+  String result;
+#if FEATURE_HTTP_KEEPALIVE
+
+  if (ControllerSettings.httpKeepAlive()) {
+    result = send_via_http_keepalive(
+      controller_idx,
+      get_formatted_Controller_number(cpluginID),
+      timeout,
+      getControllerUser(controller_idx, ControllerSettings),
+      getControllerPass(controller_idx, ControllerSettings),
+      ControllerSettings.getHost(),
+      ControllerSettings.Port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      ControllerSettings.MustCheckReply);
+  } else {
+    // Keep-alive may have been disabled for this controller
+    closeHTTP_connection(controller_idx);
+#endif // if FEATURE_HTTP_KEEPALIVE
+    result = send_via_http(
+      get_formatted_Controller_number(cpluginID),
+      timeout,
+      getControllerUser(controller_idx, ControllerSettings),
+      getControllerPass(controller_idx, ControllerSettings),
+      ControllerSettings.getHost(),
+      ControllerSettings.Port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      ControllerSettings.MustCheckReply);
+#if FEATURE_HTTP_KEEPALIVE
+  }
+#endif // if FEATURE_HTTP_KEEPALIVE
 
   // FIXME TD-er: Shouldn't this be: success = (httpCode >= 100) && (httpCode < 300)
   // or is reachability of the host the important factor here?
@@ -3,6 +3,7 @@
 
 #if FEATURE_MQTT
 # include "../Commands/ExecuteCommand.h"
+# include "../Globals/Cache.h"
 
 /***************************************************************************************
  * Parse MQTT topic for /cmd and /set ending to handle commands or TaskValueSet
@@ -185,11 +186,10 @@ void MQTT_execute_command(String& cmd,
   }
 }
 
-bool MQTT_protocol_send(EventStruct *event,
-                        String       pubname,
-                        bool         retainFlag) {
-  bool success                = false;
-  const bool contains_valname = pubname.indexOf(F("%valname%")) != -1;
+bool MQTT_protocol_send(EventStruct  *event,
+                        const String& pubname,
+                        bool          retainFlag) {
+  bool success = false;
 
   const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
@@ -198,12 +198,7 @@ bool MQTT_protocol_send(EventStruct *event,
     if (getTaskValueName(event->TaskIndex, x).isEmpty()) {
       continue; // we skip values with empty labels
     }
-    String tmppubname = pubname;
-
-    if (contains_valname) {
-      parseSingleControllerVariable(tmppubname, event, x, false);
-    }
-    parseControllerVariables(tmppubname, event, false);
+    String tmppubname = Cache.mqttTopics.getTopic(pubname, event, x);
     String value;
 
     if (event->sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
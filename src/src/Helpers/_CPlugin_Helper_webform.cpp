@@ -40,8 +40,12 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:             return F("Allow Expire");
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:              return F("De-duplicate");
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:    return F("Use Local System Time");
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:           return F("Max Batch Size");
 
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:              return F("Check Reply");
+#if FEATURE_HTTP_KEEPALIVE
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:          return F("HTTP Keep-Alive");
+#endif // if FEATURE_HTTP_KEEPALIVE
 
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:                return F("Controller Client ID");
 #if FEATURE_MQTT
@@ -316,6 +320,16 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       addFormCheckBox(displayName, internalName, ControllerSettings.useLocalSystemTime());
       break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:
+    {
+      int maxBatchSize = getProtocolStruct(ProtocolIndex).maxBatchSize;
+
+      if (maxBatchSize > CONTROLLER_DELAY_QUEUE_BATCH_MAX) {
+        maxBatchSize = CONTROLLER_DELAY_QUEUE_BATCH_MAX;
+      }
+      addFormNumericBox(displayName, internalName, ControllerSettings.maxBatchSize(), 1, maxBatchSize);
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:
     {
       const __FlashStringHelper *options[2] = {
@@ -325,6 +339,11 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
       addFormSelector(displayName, internalName, 2, options, nullptr, nullptr, ControllerSettings.MustCheckReply, false);
       break;
     }
+#if FEATURE_HTTP_KEEPALIVE
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:
+      addFormCheckBox(displayName, internalName, ControllerSettings.httpKeepAlive());
+      break;
+#endif // if FEATURE_HTTP_KEEPALIVE
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:
       addFormTextBox(displayName, internalName, ControllerSettings.ClientID, sizeof(ControllerSettings.ClientID) - 1);
       break;
@@ -502,9 +521,17 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       ControllerSettings.useLocalSystemTime(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:
+      ControllerSettings.maxBatchSize(getFormItemInt(internalName, ControllerSettings.maxBatchSize()));
+      break;
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:
       ControllerSettings.MustCheckReply = getFormItemInt(internalName, ControllerSettings.MustCheckReply);
       break;
+#if FEATURE_HTTP_KEEPALIVE
+    case ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE:
+      ControllerSettings.httpKeepAlive(isFormItemChecked(internalName));
+      break;
+#endif // if FEATURE_HTTP_KEEPALIVE
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:
       strncpy_webserver_arg(ControllerSettings.ClientID, internalName);
       break;
@@ -6,7 +6,11 @@
 
 #define MAX_SCHEDULER_WAIT_TIME 50 // Max delay used in the scheduler for passing idle time.
 
+// Marks an ID in _heap_pos which is not present in the heap.
+#define TIMER_HEAP_POS_NONE  (static_cast<size_t>(-1))
+
   msecTimerHandlerStruct::msecTimerHandlerStruct() : get_called(0), get_called_ret_id(0), max_queue_length(0),
+    insert_called(0), insert_steps(0),
     last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true)
   {
     last_log_start_time = millis();
@@ -32,7 +36,7 @@
   unsigned long msecTimerHandlerStruct::getNextId(unsigned long& timer) {
     ++get_called;
 
-    if (_timer_ids.empty()) {
+    if (_timer_heap.empty()) {
       recordIdle();
 
       if (eco_mode) {
@@ -40,7 +44,7 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
+    timer_id_couple item = _timer_heap.front();
     const long passed    = timePassedSince(item._timer);
 
     if (passed < 0) {
@@ -61,10 +65,10 @@
       return 0;
     }
     recordRunning();
-    unsigned long size = _timer_ids.size();
+    unsigned long size = _timer_heap.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    removeAt(0);
     timer = item._timer;
     ++get_called_ret_id;
     return item._id;
@@ -72,13 +76,13 @@
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    auto it = _heap_pos.find(id);
+
+    if ((it == _heap_pos.end()) || (it->second == TIMER_HEAP_POS_NONE)) {
+      return false;
     }
-    return false;
+    timer = _timer_heap[it->second]._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -91,8 +95,18 @@
     result           += max_queue_length;
     result           += '/';
     result           += idle_time_pct;
+    result           += '/';
+    result           += _timer_heap.size();
+    result           += '/';
+    result           += insert_called;
+    result           += '/';
+
+    // Average number of heap levels moved per insert, including re-ordering after removal
+    result           += (insert_called == 0) ? 0.0f : static_cast<float>(insert_steps) / insert_called;
     get_called        = 0;
     get_called_ret_id = 0;
+    insert_called     = 0;
+    insert_steps      = 0;
 
     // max_queue_length = 0;
     return result;
@@ -110,38 +124,121 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (item._id == 0) { return; }
+    ++insert_called;
+
+    // Order is based on timer, uniqueness is based on id.
+    auto it = _heap_pos.find(item._id);
+
+    if ((it != _heap_pos.end()) && (it->second != TIMER_HEAP_POS_NONE)) {
+      // Already present, just move it to its new position.
+      const size_t pos = it->second;
+      const bool   earlier = isEarlier(item, _timer_heap[pos]);
+      _timer_heap[pos]._timer = item._timer;
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+      if (earlier) {
+        siftUp(pos);
+      } else {
+        siftDown(pos);
+      }
+      return;
     }
 
-    unsigned long _id;
-  };
+    if (_heap_pos.size() > (2 * _timer_heap.size() + 32)) {
+      // Clean up IDs which have not been scheduled again.
+      for (auto it_pos = _heap_pos.begin(); it_pos != _heap_pos.end();) {
+        if (it_pos->second == TIMER_HEAP_POS_NONE) {
+          it_pos = _heap_pos.erase(it_pos);
+        } else {
+          ++it_pos;
+        }
+      }
+    }
+    _timer_heap.push_back(item);
+    _heap_pos[item._id] = _timer_heap.size() - 1;
+    siftUp(_timer_heap.size() - 1);
+  }
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
     if (item._id == 0) { return; }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    auto it = _heap_pos.find(item._id);
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    if ((it != _heap_pos.end()) && (it->second != TIMER_HEAP_POS_NONE)) {
+      removeAt(it->second);
     }
+  }
+
+  void msecTimerHandlerStruct::siftUp(size_t pos) {
+    const timer_id_couple item = _timer_heap[pos];
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    while (pos > 0) {
+      const size_t parent = (pos - 1) / 2;
+
+      if (!isEarlier(item, _timer_heap[parent])) {
+        break;
+      }
+      setAt(pos, _timer_heap[parent]);
+      pos = parent;
+      ++insert_steps;
+    }
+    setAt(pos, item);
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::siftDown(size_t pos) {
+    const timer_id_couple item = _timer_heap[pos];
+    const size_t size          = _timer_heap.size();
+
+    while (true) {
+      size_t child = 2 * pos + 1;
+
+      if (child >= size) {
+        break;
+      }
+
+      if (((child + 1) < size) && isEarlier(_timer_heap[child + 1], _timer_heap[child])) {
+        ++child;
+      }
+
+      if (!isEarlier(_timer_heap[child], item)) {
+        break;
+      }
+      setAt(pos, _timer_heap[child]);
+      pos = child;
+      ++insert_steps;
+    }
+    setAt(pos, item);
+  }
+
+  void msecTimerHandlerStruct::removeAt(size_t pos) {
+    _heap_pos[_timer_heap[pos]._id] = TIMER_HEAP_POS_NONE;
+
+    const size_t last = _timer_heap.size() - 1;
+
+    if (pos != last) {
+      const bool earlier = isEarlier(_timer_heap[last], _timer_heap[pos]);
+      setAt(pos, _timer_heap[last]);
+      _timer_heap.pop_back();
+
+      if (earlier) {
+        siftUp(pos);
+      } else {
+        siftDown(pos);
+      }
+    } else {
+      _timer_heap.pop_back();
+    }
+  }
+
+  void msecTimerHandlerStruct::setAt(size_t pos, const timer_id_couple& item) {
+    _timer_heap[pos]     = item;
+    _heap_pos[item._id] = pos;
+  }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+  bool msecTimerHandlerStruct::isEarlier(const timer_id_couple& a, const timer_id_couple& b) {
+    // Same as timer_id_couple::operator<, but without calling millis()
+    return timeDiff(a._timer, b._timer) > 0;
   }
 
   void msecTimerHandlerStruct::recordIdle() {
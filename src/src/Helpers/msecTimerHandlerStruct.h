@@ -3,7 +3,8 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
+#include <map>
+#include <vector>
 
 #include "../DataStructs/timer_id_couple.h"
 
@@ -39,6 +40,19 @@ private:
 
   void remove(const timer_id_couple& item);
 
+  // Binary min-heap operations on _timer_heap, keeping _heap_pos up to date.
+  void siftUp(size_t pos);
+
+  void siftDown(size_t pos);
+
+  void removeAt(size_t pos);
+
+  void setAt(size_t                 pos,
+             const timer_id_couple& item);
+
+  static bool isEarlier(const timer_id_couple& a,
+                        const timer_id_couple& b);
+
   void recordIdle();
 
   void recordRunning();
@@ -47,6 +61,8 @@ private:
   unsigned long get_called;
   unsigned long get_called_ret_id;
   unsigned long max_queue_length;
+  unsigned long insert_called;
+  unsigned long insert_steps;
 
   // Compute idle system time
   uint64_t last_exec_time_usec;
@@ -56,8 +72,12 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  // The set timers, ordered as a binary min-heap on the timer.
+  std::vector<timer_id_couple>_timer_heap;
+
+  // Position in _timer_heap per ID.
+  // Entries are kept when an ID is removed from the heap, as most IDs are scheduled again soon.
+  std::map<unsigned long, size_t>_heap_pos;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
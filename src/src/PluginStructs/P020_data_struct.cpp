@@ -10,7 +10,11 @@
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/Misc.h"
 
-P020_Task::P020_Task(struct EventStruct *event) : _taskIndex(event->TaskIndex) {
+P020_Task::P020_Task(struct EventStruct *event) :
+  _taskIndex(event->TaskIndex),
+  _bridgeSerialToNet(std::max<int>(P020_RX_BUFFER, P020_DEFAULT_RX_BUFFER)),
+  _bridgeNetToSerial(std::max<int>(P020_RX_BUFFER, P020_DEFAULT_RX_BUFFER))
+{
   clearBuffer();
 
   if (P020_GET_LED_ENABLED) {
@@ -271,6 +275,58 @@ void P020_Task::discardSerialIn() {
       ser2netSerial->read();
     }
   }
+  _bridgeSerialToNet.clear();
+}
+
+void P020_Task::handleBridge() {
+  if (nullptr == ser2netSerial) { return; }
+
+  if (!ser2netClient.connected()) {
+    _bridgeNetToSerial.clear();
+    discardSerialIn();
+    return;
+  }
+
+  // Network -> serial
+  int available = ser2netClient.available();
+
+  if (available > 0) {
+    if (_bridgeNetToSerial.read(ser2netClient, available) < static_cast<size_t>(available)) {
+      ++_bridgeOverflows;
+    }
+  }
+
+  if (_bridgeNetToSerial.size() > 0) {
+    const int room = ser2netSerial->availableForWrite();
+
+    if (room > 0) {
+      _bytesNetToSerial += _bridgeNetToSerial.write(*ser2netSerial, room);
+    }
+  }
+
+  // Serial -> network
+  available = ser2netSerial->available();
+
+  if (available > 0) {
+    const size_t received = _bridgeSerialToNet.read(*ser2netSerial, available);
+
+    if (received < static_cast<size_t>(available)) {
+      ++_bridgeOverflows;
+    }
+
+    if (received > 0) {
+      _bridgeLastSerialIn = millis();
+    }
+  }
+
+  const size_t bufferedSize = _bridgeSerialToNet.size();
+
+  if ((bufferedSize > 0) &&
+      ((bufferedSize >= (_bridgeSerialToNet.capacity() / 2)) ||
+       (timePassedSince(_bridgeLastSerialIn) >= _bridgeIdleGap))) {
+    _bytesSerialToNet += _bridgeSerialToNet.write(ser2netClient, bufferedSize);
+    blinkLED();
+  }
 }
 
 // We can also use the rules engine for local control!
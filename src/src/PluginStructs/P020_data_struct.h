@@ -5,6 +5,8 @@
 
 #ifdef USES_P020
 
+# include "../Helpers/SerialWriteBuffer.h"
+
 # include <ESPeasySerial.h>
 
 # ifndef PLUGIN_020_DEBUG
@@ -37,6 +39,7 @@
 # define P020_FLAG_P044_MODE_SAVED      8
 # define P020_FLAG_EVENT_SERIAL_ID      9
 # define P020_FLAG_APPEND_TASK_ID       10
+# define P020_FLAG_BRIDGE_MODE          11
 # define P020_IGNORE_CLIENT_CONNECTED   bitRead(P020_FLAGS, P020_FLAG_IGNORE_CLIENT)
 # define P020_HANDLE_MULTI_LINE         bitRead(P020_FLAGS, P020_FLAG_MULTI_LINE)
 # define P020_GET_LED_ENABLED           bitRead(P020_FLAGS, P020_FLAG_LED_ENABLED)
@@ -45,6 +48,7 @@
 # define P020_GET_P044_MODE_SAVED       bitRead(P020_FLAGS, P020_FLAG_P044_MODE_SAVED)
 # define P020_GET_EVENT_SERIAL_ID       bitRead(P020_FLAGS, P020_FLAG_EVENT_SERIAL_ID)
 # define P020_GET_APPEND_TASK_ID        bitRead(P020_FLAGS, P020_FLAG_APPEND_TASK_ID)
+# define P020_GET_BRIDGE_MODE           bitRead(P020_FLAGS, P020_FLAG_BRIDGE_MODE)
 
 # define P020_DEFAULT_SERVER_PORT           1234
 # define P020_DEFAULT_BAUDRATE              115200
@@ -100,6 +104,12 @@ struct P020_Task : public PluginTaskData_base {
   void                handleSerialIn(struct EventStruct *event);
   void                handleClientIn(struct EventStruct *event);
   void                discardSerialIn();
+
+  /*  handleBridge
+      Transparent bridge mode: forward data unchanged in both directions, without blocking.
+      Serial data is sent to the client after an idle gap of RX Receive Timeout, or when the buffer is half full.
+   */
+  void                handleBridge();
   void                rulesEngine(const String& message);
 
   bool                isInit() const;
@@ -157,6 +167,15 @@ struct P020_Task : public PluginTaskData_base {
   char          _newline           = 0;
   bool          _serialId          = false;
   bool          _appendTaskId      = false;
+  bool          _bridgeMode        = false;
+
+  SerialWriteBuffer_t _bridgeSerialToNet;
+  SerialWriteBuffer_t _bridgeNetToSerial;
+  unsigned long       _bridgeLastSerialIn = 0;
+  uint16_t            _bridgeIdleGap      = 0;
+  uint32_t            _bytesSerialToNet   = 0;
+  uint32_t            _bytesNetToSerial   = 0;
+  uint32_t            _bridgeOverflows    = 0; // Nr of times the buffer was full while more data was available
 
   ESPEasySerialPort _port;
 };
@@ -242,4 +242,149 @@ bool P052_data_struct::plugin_write(struct EventStruct *event, const String& str
   return success;
 }
 
+void P052_data_struct::startRead(struct EventStruct *event) {
+  if (_readIndex < _nrValues) {
+    // Still reading
+    return;
+  }
+  _nrValues = P052_NR_OUTPUT_VALUES;
+
+  if (_nrValues > VARS_PER_TASK) {
+    _nrValues = VARS_PER_TASK;
+  }
+
+  for (uint8_t i = 0; i < _nrValues; ++i) {
+    _queries[i] = PCONFIG(i + P052_QUERY1_CONFIG_POS);
+    _values[i]  = 0.0f;
+  }
+  _readIndex  = 0;
+  _valuesRead = 0;
+  _readingRAM = false;
+  _newValues  = false;
+  submitNextQuery();
+}
+
+bool P052_data_struct::loop() {
+  if (_readIndex >= _nrValues) {
+    return false;
+  }
+  uint8_t errorcode = 0;
+
+  if (!modbus.getCommandResult(errorcode)) {
+    // Still waiting for the reply
+    return false;
+  }
+  const uint8_t choice = _queries[_readIndex];
+
+  if ((choice == 2) && !_readingRAM && (errorcode == MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS)) {
+    // SenseAir S8, not for other modules.
+    _readingRAM = modbus.submitRead_RAM_EEPROM(P052_CMD_READ_RAM, P052_RAM_ADDR_DET_TEMPERATURE, 2);
+
+    if (_readingRAM) {
+      return false;
+    }
+  }
+
+  if (errorcode == 0) {
+    const int registerValue = _readingRAM
+      ? static_cast<int>(modbus.get_RAM_EEPROM_result())
+      : modbus.get_16b_register_result();
+    _values[_readIndex] = convertValue(choice, registerValue);
+    bitSet(_valuesRead, _readIndex);
+  }
+  _readingRAM = false;
+  ++_readIndex;
+  return submitNextQuery();
+}
+
+bool P052_data_struct::setTaskValues(struct EventStruct *event) {
+  bool   success = false;
+  String log     = F("Senseair: ");
+
+  for (uint8_t varnr = 0; varnr < _nrValues; ++varnr) {
+    const uint8_t choice = _queries[varnr];
+
+    if (getInputRegister(choice) < 0) {
+      UserVar.setFloat(event->TaskIndex, varnr, 0);
+    } else if (bitRead(_valuesRead, varnr)) {
+      const float value = _values[varnr];
+      success = true;
+      UserVar.setFloat(event->TaskIndex, varnr, value);
+
+      if (choice == 7) {
+        const int errorWord = static_cast<int>(value);
+
+        for (size_t i = 0; i < 9; i++) {
+          if (bitRead(errorWord, i)) {
+            log += F("err=");
+            log += i;
+            break;
+          }
+        }
+      } else {
+        log += getLogPrefix(choice);
+        log += value;
+      }
+    } else if (choice == 7) {
+      log += F("err=");
+      log += -1;
+    }
+  }
+  addLogMove(LOG_LEVEL_INFO, log);
+  _newValues = false;
+  return success;
+}
+
+int P052_data_struct::getInputRegister(uint8_t choice) {
+  switch (choice) {
+    case 1: return P052_IR4_MEASURED_FILTERED_CO2;
+    case 2: return P052_IR5_TEMPERATURE;
+    case 3: return P052_IR6_SPACE_HUMIDITY;
+    case 4: return P052_IR29_FW_REV;
+    case 5: return P052_IR11_MEASURED_CONCENTRATION_UNFILTERED;
+    case 7: return P052_IR_ERRORSTATUS;
+  }
+  return -1;
+}
+
+float P052_data_struct::convertValue(uint8_t choice, int registerValue) {
+  switch (choice) {
+    case 2:
+
+      if (registerValue >= 32768) {
+        // 2-complement value.
+        registerValue -= 65536;
+      }
+      return static_cast<float>(registerValue) / 100.0f;
+    case 3:
+      return static_cast<float>(registerValue) / 100.0f;
+    case 4:
+      return (registerValue >> 8) & 0x1; // Relay status
+  }
+  return static_cast<float>(registerValue);
+}
+
+const __FlashStringHelper * P052_data_struct::getLogPrefix(uint8_t choice) {
+  switch (choice) {
+    case 1: return F("co2=");
+    case 2: return F("temp=");
+    case 3: return F("hum=");
+    case 4: return F("relay status=");
+    case 5: return F("temp adj=");
+  }
+  return F("");
+}
+
+bool P052_data_struct::submitNextQuery() {
+  for (; _readIndex < _nrValues; ++_readIndex) {
+    const int reg = getInputRegister(_queries[_readIndex]);
+
+    if ((reg >= 0) && modbus.submitReadRegisters(MODBUS_READ_INPUT_REGISTERS, reg, 1)) {
+      return false;
+    }
+  }
+  _newValues = true;
+  return true;
+}
+
 #endif // ifdef USES_P052
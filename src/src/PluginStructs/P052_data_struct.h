@@ -121,8 +121,46 @@ struct P052_data_struct : public PluginTaskData_base {
                            int & value);
 
   bool plugin_write(struct EventStruct *event, const String& string);
+
+  // Start reading the output values, without blocking.
+  // Each value is requested after the previous reply has been processed in loop().
+  void startRead(struct EventStruct *event);
+
+  // Process the reply of the pending request, called from PLUGIN_FIFTY_PER_SECOND.
+  // Return true when the last value has been read.
+  bool loop();
+
+  bool newValuesAvailable() const {
+    return _newValues;
+  }
+
+  // Copy the read values to the task values.
+  // Return true when at least one value was read successfully.
+  bool setTaskValues(struct EventStruct *event);
   
   ModbusRTU_struct modbus;
+
+private:
+
+  // Input register of the output value, return -1 when no value needs to be read.
+  static int                        getInputRegister(uint8_t choice);
+
+  static float                      convertValue(uint8_t choice,
+                                                 int     registerValue);
+
+  static const __FlashStringHelper* getLogPrefix(uint8_t choice);
+
+  // Request the next value to read.
+  // Return true when all values have been read.
+  bool submitNextQuery();
+
+  uint8_t _queries[VARS_PER_TASK]{};
+  float   _values[VARS_PER_TASK]{};
+  uint8_t _nrValues   = 0;
+  uint8_t _readIndex  = 0;     // Idle when all values are read
+  uint8_t _valuesRead = 0;     // Bitmask of successfully read values
+  bool    _readingRAM = false; // Temperature of the S8 is read from RAM
+  bool    _newValues  = false;
 };
 
 // unsigned int _plugin_052_last_measurement = 0;
@@ -4,7 +4,9 @@
 
 #ifdef USES_P078
 
+# include <algorithm>
 # include <limits>
+# include <vector>
 
 # include <SDM.h> // Requires SDM library from Reaper7 - https://github.com/reaper7/SDM_Energy_Meter/
 
@@ -424,12 +426,27 @@ String p078_register_description::getPhaseDescription(SDM_MODEL model, char sepa
 
 SDM_RegisterReadQueue _SDM_RegisterReadQueue;
 
+// Registers to read, merged per meter. Updated when the queue has changed.
+std::vector<SDM_RegisterReadBlock> _SDM_RegisterReadBlocks;
+bool _SDM_RegisterReadBlocksValid = false;
+size_t _SDM_RegisterReadBlockIndex = 0;
+
+// Block being read, kept as the blocks may be updated while waiting for the reply.
+SDM_RegisterReadBlock _SDM_activeRegisterReadBlock;
+
+// 0 = idle, 1 = waiting for reply, 2 = paused
+uint8_t _SDM_RegisterReadState = 0;
+
+// Meters which did not accept reading multiple values in a single request.
+std::vector<uint8_t> _SDM_singleRegisterReadDevices;
+
 void SDM_removeRegisterReadQueueElement(taskIndex_t TaskIndex, taskVarIndex_t TaskVarIndex)
 {
   if (validTaskIndex(TaskIndex) && validTaskVarIndex(TaskVarIndex)) {
     for (auto it = _SDM_RegisterReadQueue.begin(); it != _SDM_RegisterReadQueue.end();) {
       if ((it->taskIndex == TaskIndex) && (it->taskVarIndex == TaskVarIndex)) {
         it = _SDM_RegisterReadQueue.erase(it);
+        _SDM_RegisterReadBlocksValid = false;
       } else {
         ++it;
       }
@@ -445,25 +462,71 @@ void SDM_addRegisterReadQueueElement(taskIndex_t TaskIndex, taskVarIndex_t TaskV
       validTaskIndex(TaskIndex) &&
       validTaskVarIndex(TaskVarIndex)) {
     _SDM_RegisterReadQueue.emplace_back(TaskIndex, TaskVarIndex, reg, dev_id);
-
-    //    _SDM_RegisterReadQueue.sort(compare_SDM_RegisterReadQueueElement);
+    _SDM_RegisterReadBlocksValid = false;
   }
 }
 
-void SDM_loopRegisterReadQueue(SDM *sdm)
+bool SDM_allowMultipleRegisterRead(uint8_t dev_id)
 {
-  if (sdm == nullptr) { return; }
-  auto it = _SDM_RegisterReadQueue.begin();
+  return std::find(
+    _SDM_singleRegisterReadDevices.begin(),
+    _SDM_singleRegisterReadDevices.end(),
+    dev_id) == _SDM_singleRegisterReadDevices.end();
+}
 
-  if (it == _SDM_RegisterReadQueue.end()) { return; }
+void SDM_updateRegisterReadBlocks()
+{
+  _SDM_RegisterReadBlocks.clear();
+  _SDM_RegisterReadBlocksValid = true;
 
-  if (it->_state == 1) {
-    uint16_t readErr = sdm->readValReady(it->_dev_id);
+  // Sort all used registers per meter
+  std::vector<uint32_t> registers;
 
-    if (readErr == SDM_ERR_STILL_WAITING) { return; }
+  registers.reserve(_SDM_RegisterReadQueue.size());
 
-    if (readErr == SDM_ERR_NO_ERROR) {
-      const float value = sdm->decodeFloatValue();
+  for (auto it = _SDM_RegisterReadQueue.begin(); it != _SDM_RegisterReadQueue.end(); ++it) {
+    registers.push_back((static_cast<uint32_t>(it->_dev_id) << 16) | it->_reg);
+  }
+  std::sort(registers.begin(), registers.end());
+  registers.erase(std::unique(registers.begin(), registers.end()), registers.end());
+
+  for (const uint32_t dev_reg : registers) {
+    const uint8_t  dev_id = dev_reg >> 16;
+    const uint16_t reg    = dev_reg & 0xFFFF;
+
+    if (!_SDM_RegisterReadBlocks.empty() &&
+        (_SDM_RegisterReadBlocks.back()._dev_id == dev_id) &&
+        SDM_allowMultipleRegisterRead(dev_id)) {
+      SDM_RegisterReadBlock& block = _SDM_RegisterReadBlocks.back();
+
+      // Each value is a 32-bit float, thus 2 registers
+      const uint32_t nrRegisters = static_cast<uint32_t>(reg) + 2 - block._reg;
+      const uint32_t gap         = static_cast<uint32_t>(reg) - (block._reg + block._nrRegisters);
+
+      if ((gap <= P078_MAX_REGISTER_GAP) && (nrRegisters <= SDM_MAX_NR_REGISTERS)) {
+        block._nrRegisters = nrRegisters;
+        continue;
+      }
+    }
+    SDM_RegisterReadBlock block;
+    block._reg         = reg;
+    block._nrRegisters = 2;
+    block._dev_id      = dev_id;
+    _SDM_RegisterReadBlocks.push_back(block);
+  }
+
+  if (_SDM_RegisterReadBlockIndex >= _SDM_RegisterReadBlocks.size()) {
+    _SDM_RegisterReadBlockIndex = 0;
+  }
+}
+
+void SDM_storeRegisterReadBlock(SDM *sdm, const SDM_RegisterReadBlock& block)
+{
+  for (auto it = _SDM_RegisterReadQueue.begin(); it != _SDM_RegisterReadQueue.end(); ++it) {
+    if ((it->_dev_id == block._dev_id) &&
+        (it->_reg >= block._reg) &&
+        ((it->_reg + 2) <= (block._reg + block._nrRegisters))) {
+      const float value = sdm->decodeFloatValue(it->_reg - block._reg);
       UserVar.setFloat(it->taskIndex, it->taskVarIndex, value);
 
       # if FEATURE_PLUGIN_STATS
@@ -477,36 +540,68 @@ void SDM_loopRegisterReadQueue(SDM *sdm)
         }
       }
       # endif // if FEATURE_PLUGIN_STATS
+    }
+  }
+}
+
+void SDM_loopRegisterReadQueue(SDM *sdm)
+{
+  if ((sdm == nullptr) || (_SDM_RegisterReadState == 2)) { return; }
+
+  if (_SDM_RegisterReadState == 1) {
+    const SDM_RegisterReadBlock& block = _SDM_activeRegisterReadBlock;
+    const uint16_t readErr             = sdm->readValsReady(block._nrRegisters, block._dev_id);
+
+    if (readErr == SDM_ERR_STILL_WAITING) { return; }
+
+    if (readErr == SDM_ERR_NO_ERROR) {
+      SDM_storeRegisterReadBlock(sdm, block);
     } else {
       sdm->clearErrCode();
+
+      if ((readErr < SDM_ERR_CRC_ERROR) && (block._nrRegisters > 2)) {
+        // Modbus exception, the meter may not support reading these registers in one request.
+        // Fall back to reading a single value per request.
+        _SDM_singleRegisterReadDevices.push_back(block._dev_id);
+        _SDM_RegisterReadBlocksValid = false;
+        # ifndef BUILD_NO_DEBUG
+        addLog(LOG_LEVEL_INFO, concat(F("SDM  : Read single values from meter "), block._dev_id));
+        # endif // ifndef BUILD_NO_DEBUG
+      }
     }
-    it->_state = 0;
-    _SDM_RegisterReadQueue.emplace_back(*it);
-    _SDM_RegisterReadQueue.pop_front();
-    it = _SDM_RegisterReadQueue.begin();
+    _SDM_RegisterReadState = 0;
+    ++_SDM_RegisterReadBlockIndex;
+  }
+
+  if (!_SDM_RegisterReadBlocksValid) {
+    SDM_updateRegisterReadBlocks();
   }
 
-  if (it->_state == 0) {
-    sdm->startReadVal(it->_reg, it->_dev_id);
-    it->_state = 1;
+  if (_SDM_RegisterReadBlocks.empty()) { return; }
+
+  if (_SDM_RegisterReadBlockIndex >= _SDM_RegisterReadBlocks.size()) {
+    _SDM_RegisterReadBlockIndex = 0;
   }
+
+  _SDM_activeRegisterReadBlock = _SDM_RegisterReadBlocks[_SDM_RegisterReadBlockIndex];
+  sdm->startReadVals(
+    _SDM_activeRegisterReadBlock._reg,
+    _SDM_activeRegisterReadBlock._nrRegisters,
+    _SDM_activeRegisterReadBlock._dev_id);
+  _SDM_RegisterReadState = 1;
 }
 
 void SDM_pause_loopRegisterReadQueue()
 {
-  auto it = _SDM_RegisterReadQueue.begin();
-
-  if (it != _SDM_RegisterReadQueue.end()) {
-    it->_state = 2;
+  if (!_SDM_RegisterReadQueue.empty()) {
+    _SDM_RegisterReadState = 2;
   }
 }
 
 void SDM_resume_loopRegisterReadQueue()
 {
-  auto it = _SDM_RegisterReadQueue.begin();
-
-  if (it != _SDM_RegisterReadQueue.end()) {
-    it->_state = 0;
+  if (!_SDM_RegisterReadQueue.empty()) {
+    _SDM_RegisterReadState = 0;
   }
 }
 
@@ -29,6 +29,11 @@
 # define P078_QUERY4          PCONFIG((P078_QUERY1_CONFIG_POS)+3)
 # define P078_DEPIN           CONFIG_PIN3
 
+// Max. nr of unused registers between registers read in a single request
+# ifndef P078_MAX_REGISTER_GAP
+#  define P078_MAX_REGISTER_GAP  8
+# endif // ifndef P078_MAX_REGISTER_GAP
+
 # define P078_DEV_ID_DFLT     1
 # define P078_MODEL_DFLT      0 // SDM120C
 # define P078_BAUDRATE_DFLT   3 // 9600 baud
@@ -153,7 +158,14 @@ struct SDM_RegisterReadQueueElement {
   taskVarIndex_t taskVarIndex = INVALID_TASKVAR_INDEX;
   uint16_t       _reg         = std::numeric_limits<uint16_t>::max(); // Modbus register
   uint8_t        _dev_id      = 0;                                    // Modbus address
-  uint8_t        _state       = 0;
+};
+
+// Range of registers of a single meter, read in a single request.
+// Each value read is stored in all queue elements using that register.
+struct SDM_RegisterReadBlock {
+  uint16_t _reg         = 0; // First Modbus register
+  uint8_t  _nrRegisters = 0;
+  uint8_t  _dev_id      = 0; // Modbus address
 };
 
 /*
@@ -15,6 +15,58 @@ bool P085_data_struct::init(ESPEasySerialPort port, const int16_t serial_rx, con
   return modbus.init(port, serial_rx, serial_tx, baudrate, modbusAddress, dere_pin);
 }
 
+void P085_data_struct::startRead(struct EventStruct *event) {
+  if (_readIndex < P085_NR_OUTPUT_VALUES) {
+    // Still reading
+    return;
+  }
+
+  for (uint8_t i = 0; i < P085_NR_OUTPUT_VALUES; ++i) {
+    _queries[i] = PCONFIG(i + P085_QUERY1_CONFIG_POS);
+    _values[i]  = 0.0f;
+  }
+  _readIndex = 0;
+  _newValues = false;
+  submitNextQuery();
+}
+
+bool P085_data_struct::loop() {
+  if (_readIndex >= P085_NR_OUTPUT_VALUES) {
+    return false;
+  }
+  uint8_t errorcode = 0;
+
+  if (!modbus.getCommandResult(errorcode)) {
+    // Still waiting for the reply
+    return false;
+  }
+
+  if (errorcode == 0) {
+    _values[_readIndex] = p085_convertValue(_queries[_readIndex], modbus.get_32b_register_result());
+  }
+  ++_readIndex;
+  return submitNextQuery();
+}
+
+void P085_data_struct::setTaskValues(struct EventStruct *event) {
+  for (uint8_t i = 0; i < P085_NR_OUTPUT_VALUES; ++i) {
+    UserVar.setFloat(event->TaskIndex, i, _values[i]);
+  }
+  _newValues = false;
+}
+
+bool P085_data_struct::submitNextQuery() {
+  for (; _readIndex < P085_NR_OUTPUT_VALUES; ++_readIndex) {
+    const int reg = p085_queryRegister(_queries[_readIndex]);
+
+    if ((reg >= 0) && modbus.submitReadRegisters(MODBUS_READ_HOLDING_REGISTERS, reg, 2)) {
+      return false;
+    }
+  }
+  _newValues = true;
+  return true;
+}
+
 const __FlashStringHelper* Plugin_085_valuename(uint8_t value_nr, bool displayString) {
   switch (value_nr) {
     case P085_QUERY_V:      return displayString ? F("Voltage (V)") : F("V");
@@ -48,39 +100,66 @@ int p085_storageValueToBaudrate(uint8_t baudrate_setting) {
   return 19200;
 }
 
+int p085_queryRegister(uint8_t query) {
+  switch (query) {
+    case P085_QUERY_V:      return 0x200;
+    case P085_QUERY_A:      return 0x202;
+    case P085_QUERY_W:      return 0x204;
+    case P085_QUERY_Wh_imp: return 0x300;
+    case P085_QUERY_Wh_exp: return 0x302;
+    case P085_QUERY_Wh_tot: return 0x304;
+    case P085_QUERY_Wh_net: return 0x306;
+    case P085_QUERY_h_tot:  return 0x280;
+    case P085_QUERY_h_load: return 0x282;
+  }
+  return -1;
+}
+
+float p085_convertValue(uint8_t query, uint32_t registerValue) {
+  switch (query) {
+    case P085_QUERY_V:
+    case P085_QUERY_A:
+    case P085_QUERY_W:
+    {
+      float value{};
+      memcpy(&value, &registerValue, sizeof(registerValue));
+
+      if (query == P085_QUERY_W) {
+        value *= 1000.0f; // power (kW => W)
+      }
+      return value;
+    }
+    case P085_QUERY_Wh_imp:
+    case P085_QUERY_Wh_exp:
+    case P085_QUERY_Wh_tot:
+      return registerValue * 10.0f; // 0.01 kWh => Wh
+    case P085_QUERY_Wh_net:
+    {
+      int64_t intvalue = registerValue;
+
+      if (intvalue >= 2147483648ll) {
+        intvalue = 4294967296ll - intvalue;
+      }
+      float value = static_cast<float>(intvalue);
+      value *= 10.0f; // 0.01 kWh => Wh
+      return value;
+    }
+    case P085_QUERY_h_tot:
+    case P085_QUERY_h_load:
+      return registerValue / 100.0f;
+  }
+  return 0.0f;
+}
+
 float p085_readValue(uint8_t query, struct EventStruct *event) {
   P085_data_struct *P085_data =
     static_cast<P085_data_struct *>(getPluginTaskData(event->TaskIndex));
 
   if ((nullptr != P085_data) && P085_data->isInitialized()) {
-    switch (query) {
-      case P085_QUERY_V:
-        return P085_data->modbus.read_float_HoldingRegister(0x200);
-      case P085_QUERY_A:
-        return P085_data->modbus.read_float_HoldingRegister(0x202);
-      case P085_QUERY_W:
-        return P085_data->modbus.read_float_HoldingRegister(0x204) * 1000.0f; // power (kW => W)
-      case P085_QUERY_Wh_imp:
-        return P085_data->modbus.read_32b_HoldingRegister(0x300) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_exp:
-        return P085_data->modbus.read_32b_HoldingRegister(0x302) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_tot:
-        return P085_data->modbus.read_32b_HoldingRegister(0x304) * 10.0f;     // 0.01 kWh => Wh
-      case P085_QUERY_Wh_net:
-      {
-        int64_t intvalue = P085_data->modbus.read_32b_HoldingRegister(0x306);
-
-        if (intvalue >= 2147483648ll) {
-          intvalue = 4294967296ll - intvalue;
-        }
-        float value = static_cast<float>(intvalue);
-        value *= 10.0f; // 0.01 kWh => Wh
-        return value;
-      }
-      case P085_QUERY_h_tot:
-        return P085_data->modbus.read_32b_HoldingRegister(0x280) / 100.0f;
-      case P085_QUERY_h_load:
-        return P085_data->modbus.read_32b_HoldingRegister(0x282) / 100.0f;
+    const int reg = p085_queryRegister(query);
+
+    if (reg >= 0) {
+      return p085_convertValue(query, P085_data->modbus.read_32b_HoldingRegister(reg));
     }
   }
   return 0.0f;
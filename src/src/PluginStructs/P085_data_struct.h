@@ -63,7 +63,33 @@ struct P085_data_struct : public PluginTaskData_base {
     return modbus.isInitialized();
   }
 
+  // Start reading the output values, without blocking.
+  // Each value is requested after the previous reply has been processed in loop().
+  void startRead(struct EventStruct *event);
+
+  // Process the reply of the pending request, called from PLUGIN_FIFTY_PER_SECOND.
+  // Return true when the last value has been read.
+  bool loop();
+
+  bool newValuesAvailable() const {
+    return _newValues;
+  }
+
+  // Copy the read values to the task values
+  void setTaskValues(struct EventStruct *event);
+
   ModbusRTU_struct modbus;
+
+private:
+
+  // Request the next value to read.
+  // Return true when all values have been read.
+  bool submitNextQuery();
+
+  uint8_t _queries[P085_NR_OUTPUT_VALUES]{};
+  float   _values[P085_NR_OUTPUT_VALUES]{};
+  uint8_t _readIndex = P085_NR_OUTPUT_VALUES;
+  bool    _newValues = false;
 };
 
 
@@ -72,6 +98,14 @@ const __FlashStringHelper* Plugin_085_valuename(uint8_t value_nr,
 
 int                        p085_storageValueToBaudrate(uint8_t baudrate_setting);
 
+// Holding register of the query, all values are 32 bit.
+// Return -1 for an unknown query.
+int                        p085_queryRegister(uint8_t query);
+
+float                      p085_convertValue(uint8_t  query,
+                                             uint32_t registerValue);
+
+// Blocking read, only to show the values on the settings page
 float                      p085_readValue(uint8_t             query,
                                           struct EventStruct *event);
 
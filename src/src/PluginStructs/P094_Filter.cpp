@@ -224,6 +224,17 @@ bool P094_filter::matches(const mBusPacket_header_t& other) const
   return true;
 }
 
+uint64_t P094_filter::encode_toUInt64() const
+{
+  mBusPacket_header_t header;
+
+  header._manufacturer = _filter._manufacturer;
+  header._meterType    = _filter._meterType;
+  header._serialNr     = _filter._serialNr;
+  header._length       = 1; // To pass isValid() check
+  return header.encode_toUInt64();
+}
+
 unsigned long P094_filter::computeUnixTimeExpiration() const
 {
   // Match the interval window.
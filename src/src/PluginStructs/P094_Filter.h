@@ -74,6 +74,14 @@ struct P094_filter {
     return _filter._serialNr == mBus_packet_wildcard_serial;
   }
 
+  bool hasWildcard() const {
+    return isWildcardManufacturer() || isWildcardMeterType() || isWildcardSerial();
+  }
+
+  // Same value as mBusPacket_header_t::encode_toUInt64() of a matching header.
+  // Only useful when the filter has no wildcards.
+  uint64_t           encode_toUInt64() const;
+
   String             getManufacturer() const;
   String             getMeterType() const;
   String             getSerial() const;
@@ -13,6 +13,8 @@
 # include "../DataStructs/mBusPacket.h"
 # include "../Globals/MQTT.h"
 
+# include <algorithm>
+
 // # include "../Globals/ESPEasy_time.h"
 // # include "../Globals/TimeZone.h"
 // # include "../Helpers/ESPEasy_Storage.h"
@@ -105,6 +107,7 @@ void P094_data_struct::loadFilters(struct EventStruct *event, uint8_t nrFilters)
       readPos += chunkSize;
     }
   }
+  updateFilterIndex();
 }
 
 String P094_data_struct::saveFilters(struct EventStruct *event) const
@@ -158,6 +161,7 @@ String P094_data_struct::saveFilters(struct EventStruct *event) const
 void P094_data_struct::clearFilters()
 {
   _filters.clear();
+  updateFilterIndex();
 }
 
 bool P094_data_struct::addFilter(struct EventStruct *event, const String& filter)
@@ -179,6 +183,7 @@ bool P094_data_struct::addFilter(struct EventStruct *event, const String& filter
   }
 
   _filters.push_back(f);
+  updateFilterIndex();
 
   // No sorting as this may have unexpected side-effects
   // std::sort(_filters.begin(), _filters.end());
@@ -254,6 +259,7 @@ void P094_data_struct::WebformSaveFilters(struct EventStruct *event, uint8_t nrF
       }
     }
   }
+  updateFilterIndex();
   addHtmlError(saveFilters(event));
 }
 
@@ -742,17 +748,17 @@ bool P094_data_struct::parsePacket(const String& received, mBusPacket_t& packet)
       return true; // No filtering
     }
 
-    for (unsigned int f = 0; f < _filters.size(); ++f) {
-      if (_filters[f].matches(*header)) {
-        const bool res = interval_filter.filter(packet, _filters[f]);
+    const int f = findFilter(*header);
 
-        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-          addLogMove(LOG_LEVEL_INFO, concat(F("CUL Filter: Match "), _filters[f].toString()));
-          addLogMove(LOG_LEVEL_INFO, concat(res ? F("CUL Filter: Pass ") : F("CUL Filter: Reject "), header->toString()));
-        }
+    if (f >= 0) {
+      const bool res = interval_filter.filter(packet, _filters[f]);
 
-        return res;
+      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+        addLogMove(LOG_LEVEL_INFO, concat(F("CUL Filter: Match "), _filters[f].toString()));
+        addLogMove(LOG_LEVEL_INFO, concat(res ? F("CUL Filter: Pass ") : F("CUL Filter: Reject "), header->toString()));
       }
+
+      return res;
     }
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -844,6 +850,47 @@ bool P094_data_struct::isDuplicate(const P094_filter& other) const
   return false;
 }
 
+void P094_data_struct::updateFilterIndex()
+{
+  _exactFilters.clear();
+  _wildcardFilters.clear();
+
+  for (uint16_t f = 0; f < _filters.size(); ++f) {
+    if (_filters[f].hasWildcard()) {
+      _wildcardFilters.push_back(f);
+    } else {
+      _exactFilters.emplace_back(_filters[f].encode_toUInt64(), f);
+    }
+  }
+  std::sort(_exactFilters.begin(), _exactFilters.end());
+}
+
+int P094_data_struct::findFilter(const mBusPacket_header_t& header) const
+{
+  int res = -1;
+
+  const uint64_t key = header.encode_toUInt64();
+  auto it            = std::lower_bound(
+    _exactFilters.begin(), _exactFilters.end(),
+    std::make_pair(key, static_cast<uint16_t>(0)));
+
+  if ((it != _exactFilters.end()) && (it->first == key)) {
+    res = it->second;
+  }
+
+  // Filters are checked in order, so a filter with wildcards may be matched first.
+  for (const uint16_t f : _wildcardFilters) {
+    if ((res >= 0) && (f > res)) {
+      break;
+    }
+
+    if (_filters[f].matches(header)) {
+      return f;
+    }
+  }
+  return res;
+}
+
 # if P094_DEBUG_OPTIONS
 uint32_t P094_data_struct::getDebugCounter() {
   return debug_counter++;
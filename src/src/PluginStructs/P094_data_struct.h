@@ -160,8 +160,21 @@ private:
 
   bool isDuplicate(const P094_filter& other) const;
 
+  // Must be called whenever _filters has changed.
+  void updateFilterIndex();
+
+  // Index in _filters of the first filter matching the header.
+  // Return -1 when no filter matches.
+  int  findFilter(const mBusPacket_header_t& header) const;
+
   std::vector<P094_filter>_filters;
 
+  // Filters without wildcards, sorted by encoded filter and index in _filters
+  std::vector<std::pair<uint64_t, uint16_t> >_exactFilters;
+
+  // Index in _filters of the filters with wildcards, in order
+  std::vector<uint16_t>_wildcardFilters;
+
   ESPeasySerial *easySerial = nullptr;
   String         sentence_part;
   uint16_t       max_length = P094_MAX_MSG_LENGTH;
@@ -16,6 +16,63 @@ bool P108_data_struct::init(ESPEasySerialPort port, const int16_t serial_rx, con
   return modbus.init(port, serial_rx, serial_tx, baudrate, modbusAddress, dere_pin);
 }
 
+void P108_data_struct::startRead(struct EventStruct *event) {
+  if (_readIndex < P108_NR_OUTPUT_VALUES) {
+    // Still reading
+    return;
+  }
+
+  for (uint8_t i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
+    _queries[i] = PCONFIG(i + P108_QUERY1_CONFIG_POS);
+    _values[i]  = 0.0f;
+  }
+  _readIndex = 0;
+  _newValues = false;
+  submitNextQuery();
+}
+
+bool P108_data_struct::loop() {
+  if (_readIndex >= P108_NR_OUTPUT_VALUES) {
+    return false;
+  }
+  uint8_t errorcode = 0;
+
+  if (!modbus.getCommandResult(errorcode)) {
+    // Still waiting for the reply
+    return false;
+  }
+
+  if (errorcode == 0) {
+    const uint8_t query = _queries[_readIndex];
+    _values[_readIndex] = p108_convertValue(
+      query,
+      p108_is32bitQuery(query) ? modbus.get_32b_register_result() : modbus.get_16b_register_result());
+  }
+  ++_readIndex;
+  return submitNextQuery();
+}
+
+void P108_data_struct::setTaskValues(struct EventStruct *event) {
+  for (uint8_t i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
+    UserVar.setFloat(event->TaskIndex, i, _values[i]);
+  }
+  _newValues = false;
+}
+
+bool P108_data_struct::submitNextQuery() {
+  for (; _readIndex < P108_NR_OUTPUT_VALUES; ++_readIndex) {
+    const uint8_t query = _queries[_readIndex];
+    const int     reg   = p108_queryRegister(query);
+
+    if ((reg >= 0) &&
+        modbus.submitReadRegisters(MODBUS_READ_HOLDING_REGISTERS, reg, p108_is32bitQuery(query) ? 2 : 1)) {
+      return false;
+    }
+  }
+  _newValues = true;
+  return true;
+}
+
 
 const __FlashStringHelper* Plugin_108_valuename(uint8_t value_nr, bool displayString) {
   switch (value_nr) {
@@ -46,49 +103,71 @@ int p108_storageValueToBaudrate(uint8_t baudrate_setting) {
   return 9600;
 }
 
+int p108_queryRegister(uint8_t query) {
+  switch (query) {
+    case P108_QUERY_V:      return 0x0C;
+    case P108_QUERY_A:      return 0x0D;
+    case P108_QUERY_W:      return 0x0E;
+    case P108_QUERY_VA:     return 0x0F;
+    case P108_QUERY_PF:     return 0x10;
+    case P108_QUERY_F:      return 0x11;
+    case P108_QUERY_Wh_imp: return 0x0A;
+    case P108_QUERY_Wh_exp: return 0x08;
+    case P108_QUERY_Wh_tot: return 0x00;
+  }
+  return -1;
+}
+
+bool p108_is32bitQuery(uint8_t query) {
+  switch (query) {
+    case P108_QUERY_Wh_imp:
+    case P108_QUERY_Wh_exp:
+    case P108_QUERY_Wh_tot:
+      return true;
+  }
+  return false;
+}
+
+float p108_convertValue(uint8_t query, uint32_t registerValue) {
+  float value = registerValue;
+
+  switch (query) {
+    case P108_QUERY_V:
+      return value / 10.0f;  // 0.1 V => V
+    case P108_QUERY_A:
+      return value / 100.0f; // 0.01 A => A
+    case P108_QUERY_W:
+    case P108_QUERY_VA:
+
+      if (value > 32767) { value -= 65535; }
+      return value;
+    case P108_QUERY_PF:
+      return value / 1000.0f; // 0.001 Pf => Pf
+    case P108_QUERY_F:
+      return value / 100.0f;  // 0.01 Hz => Hz
+    case P108_QUERY_Wh_imp:
+    case P108_QUERY_Wh_exp:
+    case P108_QUERY_Wh_tot:
+      return value * 10.0f;   // 0.01 kWh => Wh
+  }
+  return 0.0f;
+}
+
 float p108_readValue(uint8_t query, struct EventStruct *event) {
-  uint8_t errorcode           = -1;   // DF - not present in P085
-  float   value               = 0.0f; // DF - not present in P085
   P108_data_struct *P108_data =
     static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
+  const int reg = p108_queryRegister(query);
 
-  if ((nullptr != P108_data) && P108_data->isInitialized()) {
-    switch (query) {
-      case P108_QUERY_V:
-        value = P108_data->modbus.readHoldingRegister(0x0C, errorcode) / 10.0f;  // 0.1 V => V
-        break;
-      case P108_QUERY_A:
-        value = P108_data->modbus.readHoldingRegister(0x0D, errorcode) / 100.0f; // 0.01 A => A
-        break;
-      case P108_QUERY_W:
-        value =  P108_data->modbus.readHoldingRegister(0x0E, errorcode);
-
-        if (value > 32767) { value -= 65535; }
-        break;
-      case P108_QUERY_VA:
-        value = P108_data->modbus.readHoldingRegister(0x0F, errorcode);
-
-        if (value > 32767) { value -= 65535; }
-        break;
-      case P108_QUERY_PF:
-        value = P108_data->modbus.readHoldingRegister(0x10, errorcode) / 1000.0f; // 0.001 Pf => Pf
-        break;
-      case P108_QUERY_F:
-        value = P108_data->modbus.readHoldingRegister(0x11, errorcode) / 100.0f;  // 0.01 Hz => Hz
-        break;
-      case P108_QUERY_Wh_imp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x0A) * 10.0f;          // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_exp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x08) * 10.0f;          // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_tot:
-        return P108_data->modbus.read_32b_HoldingRegister(0x00) * 10.0f;          // 0.01 kWh => Wh
-        break;
+  if ((nullptr != P108_data) && P108_data->isInitialized() && (reg >= 0)) {
+    if (p108_is32bitQuery(query)) {
+      return p108_convertValue(query, P108_data->modbus.read_32b_HoldingRegister(reg));
     }
-  }
+    uint8_t   errorcode = 0;
+    const int value     = P108_data->modbus.readHoldingRegister(reg, errorcode);
 
-  if (errorcode == 0) { return value; // DF - not present in P085
+    if (errorcode == 0) {
+      return p108_convertValue(query, value);
+    }
   }
   return 0.0f;
 }
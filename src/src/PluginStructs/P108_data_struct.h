@@ -64,7 +64,33 @@ struct P108_data_struct : public PluginTaskData_base {
       return modbus.isInitialized();
   }
 
+  // Start reading the output values, without blocking.
+  // Each value is requested after the previous reply has been processed in loop().
+  void startRead(struct EventStruct *event);
+
+  // Process the reply of the pending request, called from PLUGIN_FIFTY_PER_SECOND.
+  // Return true when the last value has been read.
+  bool loop();
+
+  bool newValuesAvailable() const {
+    return _newValues;
+  }
+
+  // Copy the read values to the task values
+  void setTaskValues(struct EventStruct *event);
+
   ModbusRTU_struct modbus;
+
+private:
+
+  // Request the next value to read.
+  // Return true when all values have been read.
+  bool submitNextQuery();
+
+  uint8_t _queries[P108_NR_OUTPUT_VALUES]{};
+  float   _values[P108_NR_OUTPUT_VALUES]{};
+  uint8_t _readIndex = P108_NR_OUTPUT_VALUES;
+  bool    _newValues = false;
 };
 
 
@@ -73,6 +99,16 @@ const __FlashStringHelper* Plugin_108_valuename(uint8_t value_nr,
 
 int                        p108_storageValueToBaudrate(uint8_t baudrate_setting);
 
+// Holding register of the query, return -1 for an unknown query.
+int                        p108_queryRegister(uint8_t query);
+
+// Energy values are stored in 2 registers (32 bit), others in a single register.
+bool                       p108_is32bitQuery(uint8_t query);
+
+float                      p108_convertValue(uint8_t  query,
+                                             uint32_t registerValue);
+
+// Blocking read, only to show the values on the settings page
 float                      p108_readValue(uint8_t             query,
                                           struct EventStruct *event);
 
@@ -3,12 +3,15 @@
 #ifdef USES_C016
 
 # include "../WebServer/ESPEasy_WebServer.h"
+# include "../WebServer/404.h"
 # include "../WebServer/AccessControl.h"
 # include "../WebServer/HTML_wrappers.h"
 # include "../WebServer/JSON.h"
+# include "../WebServer/Markup_Forms.h"
 # include "../CustomBuild/ESPEasyLimits.h"
 # include "../DataStructs/DeviceStruct.h"
 # include "../DataStructs/ESPEasyControllerCache_CSV_dumper.h"
+# include "../DataStructs/ESPEasyControllerCache_file.h"
 # include "../DataTypes/TaskIndex.h"
 # include "../Globals/C016_ControllerCache.h"
 # include "../Globals/Cache.h"
@@ -28,9 +31,11 @@ void handle_dumpcache() {
   if (!isLoggedIn()) { return; }
 
   // Filters/export settings
-  char separator     = ';';
-  bool joinTimestamp = false;
-  bool onlySetTasks  = false;
+  char     separator     = ';';
+  bool     joinTimestamp = false;
+  bool     onlySetTasks  = false;
+  uint32_t startTime     = 0;
+  uint32_t endTime       = 0;
 
 
   if (hasArg(F("separator"))) {
@@ -53,6 +58,15 @@ void handle_dumpcache() {
     onlySetTasks = true;
   }
 
+  // Optional time range, as UNIX timestamp
+  if (hasArg(F("from"))) {
+    startTime = getFormItemInt(F("from"), 0);
+  }
+
+  if (hasArg(F("to"))) {
+    endTime = getFormItemInt(F("to"), 0);
+  }
+
   {
     // Send HTTP headers to directly save the dump as a CSV file
     String str =  F("attachment; filename=cachedump_");
@@ -80,8 +94,10 @@ void handle_dumpcache() {
 
   dumper.generateCSVHeader(true);
 
-  while (dumper.createCSVLine()) {
-    dumper.writeCSVLine(true);
+  if (dumper.setTimeRange(startTime, endTime)) {
+    while (dumper.createCSVLine()) {
+      dumper.writeCSVLine(true);
+    }
   }
 
   TXBuffer.endStream();
@@ -125,15 +141,17 @@ void handle_cache_json() {
 
   while (!islast) {
     const String currentFile = C016_getCacheFileName(filenr, islast);
-    ++filenr;
 
     if (currentFile.length() > 0) {
       if (fileCount != 0) {
         addHtml(',');
       }
-      addHtml(to_json_value(currentFile));
+
+      // Cache files may be stored in the compact format, so refer to the decoded content.
+      addHtml(to_json_value(concat(F("/cache_file?nr="), filenr)));
       ++fileCount;
     }
+    ++filenr;
   }
   addHtml(F("],\n"));
   addHtml(F("\"pluginID\": ["));
@@ -151,6 +169,43 @@ void handle_cache_json() {
   TXBuffer.endStream();
 }
 
+// Content of a cache file as plain C016_binary_element records, regardless of the stored format.
+void handle_cache_file() {
+  if (!isLoggedIn()) { return; }
+
+  const int fileNr = getFormItemInt(F("nr"), -1);
+  int  nr          = fileNr;
+  bool islast      = false;
+
+  const String fname = (fileNr < 0) ? EMPTY_STRING : C016_getCacheFileName(nr, islast);
+
+  ESPEasyControllerCache_file file;
+
+  if ((nr != fileNr) || fname.isEmpty() || !file.open(fname)) {
+    handleNotFound();
+    return;
+  }
+  constexpr size_t elementSize = sizeof(C016_binary_element);
+  size_t remaining             = file.size() - (file.size() % elementSize);
+
+  web_server.setContentLength(remaining);
+  web_server.send(200, F("application/octet-stream"), EMPTY_STRING);
+
+  uint8_t buffer[8 * elementSize];
+
+  while (remaining > 0) {
+    const size_t bytesRead = file.read(buffer, std::min(remaining, sizeof(buffer)));
+
+    if (bytesRead == 0) {
+      break;
+    }
+    web_server.sendContent(reinterpret_cast<const char *>(buffer), bytesRead);
+    remaining -= bytesRead;
+    delay(0);
+  }
+  file.close();
+}
+
 void handle_cache_csv() {
   if (!isLoggedIn()) { return; }
 }
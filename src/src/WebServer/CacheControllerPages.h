@@ -13,6 +13,8 @@ void handle_dumpcache();
 
 void handle_cache_json();
 
+void handle_cache_file();
+
 void handle_cache_csv();
 
 #endif // ifdef USES_C016
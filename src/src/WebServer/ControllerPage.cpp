@@ -24,6 +24,7 @@
 # include "../Helpers/_CPlugin_Helper_webform.h"
 # include "../Helpers/_Plugin_SensorTypeHelper.h"
 # include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/HTTP_connection_pool.h"
 # include "../Helpers/StringConverter.h"
 
 # include "../Helpers/_CPlugin_Helper_webform.h"
@@ -384,11 +385,37 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
               addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE);
             }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_DEDUPLICATE);
+
+            if (proto.maxBatchSize > 1) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE);
+              addFormNote(F("Max. number of queued messages combined in a single message, 1 = no batches"));
+            }
           }
 
           if (proto.usesCheckReply) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_CHECK_REPLY);
           }
+          # if FEATURE_HTTP_KEEPALIVE
+
+          if (proto.usesHTTP) {
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_HTTP_KEEP_ALIVE);
+            addFormNote(F("Keep the connection open for the next message, only with 'Check Acknowledgement'"));
+
+            if (ControllerSettings->httpKeepAlive()) {
+              const HTTP_connection_stats_t& stats = getHTTP_connection_stats(controllerindex);
+              addRowLabel(F("HTTP Connections"));
+              addHtml(strformat(
+                        F("Requests: %u (reused: %u, retries: %u, errors: %u)<BR>Connects: %u (failed: %u, avg. %u ms)"),
+                        stats.requests,
+                        stats.reused,
+                        stats.retries,
+                        stats.errors,
+                        stats.connects,
+                        stats.connectFailures,
+                        stats.getAvgConnectDuration_ms()));
+            }
+          }
+          # endif // if FEATURE_HTTP_KEEPALIVE
 
           if (proto.usesTimeout) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_TIMEOUT);
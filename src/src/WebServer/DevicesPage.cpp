@@ -146,6 +146,9 @@ void handle_devices() {
   // FIXME TD-er: Might have to clear any caches here.
   if ((edit != 0) && !taskIndexNotSet) // when form submitted
   {
+    // Task settings, custom task settings and settings are all stored in the same file
+    SaveToFileBatch batch;
+
     if (Settings.getPluginID_for_task(taskIndex) != taskdevicenumber)
     {
       // change of device: cleanup old device and reset default settings
@@ -367,6 +370,10 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
   Settings.TaskDevicePort[taskIndex] = getFormItemInt(F("TDP"), 0);
   update_whenset_FormItemInt(F("remoteFeed"), Settings.TaskDeviceDataFeed[taskIndex]);
   Settings.CombineTaskValues_SingleEvent(taskIndex, isFormItemChecked(F("TVSE")));
+# if FEATURE_TASKVALUE_DEADBAND
+  ExtraTaskSettings.SendOnChange           = isFormItemChecked(F("TSOC"));
+  ExtraTaskSettings.SendOnChangeMaxSilence = getFormItemInt(F("TSOCS"), 0);
+# endif // if FEATURE_TASKVALUE_DEADBAND
 
   for (controllerIndex_t controllerNr = 0; controllerNr < CONTROLLER_MAX; controllerNr++)
   {
@@ -398,6 +405,15 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
     strncpy_webserver_arg(ExtraTaskSettings.TaskDeviceFormula[varNr], getPluginCustomArgName(F("TDF"), varNr));
     update_whenset_FormItemInt(getPluginCustomArgName(F("TDVD"), varNr), ExtraTaskSettings.TaskDeviceValueDecimals[varNr]);
     strncpy_webserver_arg(ExtraTaskSettings.TaskDeviceValueNames[varNr], getPluginCustomArgName(F("TDVN"), varNr));
+# if FEATURE_TASKVALUE_DEADBAND
+
+    if (device.SendDataOption) {
+      ExtraTaskSettings.setDeadband(
+        varNr,
+        getFormItemFloat(getPluginCustomArgName(F("TDDA"), varNr)),
+        getFormItemFloat(getPluginCustomArgName(F("TDDR"), varNr)));
+    }
+# endif // if FEATURE_TASKVALUE_DEADBAND
 # if FEATURE_PLUGIN_FILTER
     ExtraTaskSettings.enablePluginFilter(varNr, isFormItemChecked(getPluginCustomArgName(F("TDFIL"), varNr)));
 # endif // if FEATURE_PLUGIN_FILTER
@@ -1383,6 +1399,14 @@ void devicePage_show_controller_config(taskIndex_t taskIndex, deviceIndex_t Devi
                   F("Unchecked: Send event per value. Checked: Send single event (%s#All) containing all values"),
                   getTaskDeviceName(taskIndex).c_str()));
 
+# if FEATURE_TASKVALUE_DEADBAND
+    addFormCheckBox(F("Send on change"), F("TSOC"), Cache.sendOnChange(taskIndex));
+    addFormNote(F("Only send to controllers when a value changed more than its deadband (see Values)"));
+    addFormNumericBox(F("Max Silence"), F("TSOCS"), Cache.getSendOnChangeMaxSilence(taskIndex), 0, 65535);
+    addUnit(F("sec"));
+    addFormNote(F("With 'Send on change', send at least once per this interval. 0 = no limit"));
+# endif // if FEATURE_TASKVALUE_DEADBAND
+
     bool separatorAdded = false;
 
     for (controllerIndex_t controllerNr = 0; controllerNr < CONTROLLER_MAX; controllerNr++)
@@ -1487,6 +1511,17 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
     }
 # endif // if FEATURE_PLUGIN_STATS
 
+# if FEATURE_TASKVALUE_DEADBAND
+
+    if (device.SendDataOption)
+    {
+      html_table_header(F("Deadband"),   30);
+      ++colCount;
+      html_table_header(F("Deadband %"), 30);
+      ++colCount;
+    }
+# endif // if FEATURE_TASKVALUE_DEADBAND
+
     // placeholder header
     html_table_header(F(""));
     ++colCount;
@@ -1559,6 +1594,26 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
           selected);
       }
 # endif // if FEATURE_PLUGIN_STATS
+# if FEATURE_TASKVALUE_DEADBAND
+
+      if (device.SendDataOption)
+      {
+        html_TD();
+        addFloatNumberBox(
+          getPluginCustomArgName(F("TDDA"), varNr), // ="taskdevicedeadband absolute"
+          Cache.getDeadbandAbsolute(taskIndex, varNr),
+          0.0f,
+          1000000.0f);
+
+        html_TD();
+        addFloatNumberBox(
+          getPluginCustomArgName(F("TDDR"), varNr), // ="taskdevicedeadband relative"
+          Cache.getDeadbandRelative(taskIndex, varNr),
+          0.0f,
+          1000.0f,
+          2);
+      }
+# endif // if FEATURE_TASKVALUE_DEADBAND
     }
     addFormSeparator(colCount);
   }
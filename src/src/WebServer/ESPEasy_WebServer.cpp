@@ -241,6 +241,7 @@ void WebServerInit()
 
   web_server.on(F("/dumpcache"),  handle_dumpcache);  // C016 specific entrie
   web_server.on(F("/cache_json"), handle_cache_json); // C016 specific entrie
+  web_server.on(F("/cache_file"), handle_cache_file); // C016 specific entrie
   web_server.on(F("/cache_csv"),  handle_cache_csv);  // C016 specific entrie
 #endif // USES_C016
 
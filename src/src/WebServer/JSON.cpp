@@ -17,6 +17,7 @@
 #include "../Helpers/_Plugin_init.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/Hardware.h"
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
@@ -29,6 +30,16 @@ void stream_comma_newline() {
   addHtml(',', '\n');
 }
 
+// Part of the ETag of /json, to make sure an ETag from before a reboot does not match.
+static uint32_t get_json_boot_id() {
+  static uint32_t boot_id = 0;
+
+  if (boot_id == 0) {
+    boot_id = HwRandom() | 1;
+  }
+  return boot_id;
+}
+
 
 // ********************************************************************************
 // Web Interface get CSV value from task
@@ -143,6 +154,40 @@ void handle_json()
     #endif
   }
 
+  // Only show tasks changed after this change sequence nr.
+  uint32_t since = 0;
+
+  if (hasArg(F("since"))) {
+    validUIntFromString(webArg(F("since")), since);
+
+    if (since > UserVar.getChangeSequence()) {
+      // Sequence nr from before a reboot, show all tasks
+      since = 0;
+    }
+  }
+
+  // The system info changes on every call, so only use an ETag when only task data is shown.
+  if (showSpecificTask || !showSystem) {
+    const String etag = strformat(F("\"%x-%u\""), get_json_boot_id(), UserVar.getChangeSequence());
+
+    // A single task without any change after 'since' would result in an empty reply, which is not valid JSON.
+    const bool taskUnchanged = showSpecificTask && (since != 0) && (UserVar.getChangeSequence(taskNr - 1) <= since);
+
+    if (taskUnchanged || etag.equals(web_server.header(F("If-None-Match")))) {
+      // Nothing changed since the last request, reply with a 304 Not Modified
+      #if ESP_IDF_VERSION_MAJOR>4
+      web_server.enableCORS(true);
+      #else
+      sendHeader(F("Access-Control-Allow-Origin"), F("*"));
+      #endif
+      sendHeader(F("ETag"), etag);
+      web_server.send(304, String(F("application/json")), EMPTY_STRING);
+      STOP_TIMER(HANDLE_SERVING_WEBPAGE_JSON);
+      return;
+    }
+    sendHeader(F("ETag"), etag);
+  }
+
   TXBuffer.startJsonStream();
 
   if (!showSpecificTask)
@@ -417,15 +462,20 @@ void handle_json()
 
   // Keep track of the lowest reported TTL and use that as refresh interval.
   unsigned long lowest_ttl_json = 60;
+  bool firstTask                = true;
 
   for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastActiveTaskIndex && validTaskIndex(TaskIndex); TaskIndex++)
   {
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(TaskIndex);
 
-    if (validDeviceIndex(DeviceIndex))
+    if (validDeviceIndex(DeviceIndex) && ((since == 0) || (UserVar.getChangeSequence(TaskIndex) > since)))
     {
       const unsigned long taskInterval = Settings.TaskDeviceTimer[TaskIndex];
       //LoadTaskSettings(TaskIndex);
+      if (!firstTask) {
+        stream_comma_newline();
+      }
+      firstTask = false;
       addHtml('{', '\n');
 
       unsigned long ttl_json = 60; // Default value
@@ -484,6 +534,7 @@ void handle_json()
 
 
       if (showSpecificTask) {
+        stream_next_json_object_value(F("ChangeSequence"), String(UserVar.getChangeSequence()));
         stream_next_json_object_value(F("TTL"), ttl_json * 1000);
       }
 
@@ -548,16 +599,16 @@ void handle_json()
         jsonBool(Settings.TaskDeviceEnabled[TaskIndex]));
 
       stream_last_json_object_value(F("TaskNumber"), TaskIndex + 1);
-
-      if (TaskIndex != lastActiveTaskIndex) {
-        addHtml(',');
-      }
-      addHtml('\n');
     }
   }
 
+  if (!firstTask) {
+    addHtml('\n');
+  }
+
   if (!showSpecificTask) {
     addHtml(F("],\n"));
+    stream_next_json_object_value(F("ChangeSequence"), String(UserVar.getChangeSequence()));
     stream_last_json_object_value(F("TTL"), lowest_ttl_json * 1000);
   }
 
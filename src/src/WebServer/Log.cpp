@@ -42,6 +42,41 @@ void handle_log() {
   TXBuffer.endStream();
 }
 
+#ifdef WEBSERVER_LOG
+
+// Read position of the web log in the log buffer
+static LogReader_t webLogReader;
+
+// Stream the log message as JSON string, replacing characters not allowed in JSON like to_json_value() does.
+static void stream_log_text(const char *message, uint8_t length) {
+  addHtml(F("\"text\":\""));
+
+  for (uint8_t i = 0; i < length; ++i) {
+    char c = message[i];
+
+    switch (c) {
+      case '\n':
+      case '\r':
+      case '\\':
+      case '\b':
+      case '\f':
+        c = '^';
+        break;
+      case '\t':
+        c = ' ';
+        break;
+      case '"':
+        c = '\'';
+        break;
+    }
+    addHtml(c);
+  }
+  addHtml('"', ',');
+  addHtml('\n');
+}
+
+#endif // ifdef WEBSERVER_LOG
+
 // ********************************************************************************
 // Web Interface JSON log page
 // ********************************************************************************
@@ -69,16 +104,19 @@ void handle_log_JSON() {
   addHtml(F("\"Entries\": ["));
   bool logLinesAvailable       = true;
   int  nrEntries               = 0;
+  long nrBytes                 = 0;
   unsigned long firstTimeStamp = 0;
   unsigned long lastTimeStamp  = 0;
 
   while (logLinesAvailable) {
-    String message;
+    // Copy of the message, as the log buffer may be changed while sending
+    char    message[LOG_STRUCT_MESSAGE_SIZE];
+    uint8_t length;
     uint8_t loglevel;
-    if (Logging.getNext(logLinesAvailable, lastTimeStamp, message, loglevel)) {
+    if (Logging.getNext(webLogReader, logLinesAvailable, lastTimeStamp, message, length, loglevel)) {
       addHtml('{');
       stream_next_json_object_value(F("timestamp"), lastTimeStamp);
-      stream_next_json_object_value(F("text"),  std::move(message));
+      stream_log_text(message, length);
       stream_last_json_object_value(F("level"), loglevel);
       if (logLinesAvailable) {
         addHtml(',', '\n');
@@ -87,6 +125,7 @@ void handle_log_JSON() {
         firstTimeStamp = lastTimeStamp;
       }
       ++nrEntries;
+      nrBytes += LOG_STRUCT_ENTRY_HEADER_SIZE + length;
     }
 
     // Do we need to do something here and maybe limit number of lines at once?
@@ -99,8 +138,8 @@ void handle_log_JSON() {
   if ((nrEntries > 2) && (logTimeSpan > 1)) {
     // May need to lower the TTL for refresh when time needed
     // to fill half the log is lower than current TTL
-    newOptimum = logTimeSpan * (LOG_STRUCT_MESSAGE_LINES / 2);
-    newOptimum = newOptimum / (nrEntries - 1);
+    newOptimum = logTimeSpan * (LOG_STRUCT_ARENA_SIZE / 2);
+    newOptimum = newOptimum / nrBytes;
   }
 
   if (newOptimum < refreshSuggestion) { refreshSuggestion = newOptimum; }
@@ -8,6 +8,12 @@
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Static/WebStaticData.h"
 
+#if FEATURE_EXTENDED_METRICS
+# include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+# include "../DataStructs/TimingStats.h"
+# include "../Globals/CPlugins.h"
+#endif // if FEATURE_EXTENDED_METRICS
+
 #ifdef WEBSERVER_METRICS
 
 # ifdef ESP32
@@ -82,9 +88,23 @@ void handle_metrics() {
   addHtml(getValue(LabelType::NUMBER_RECONNECTS));
   addHtml('\n');
 
+  // Scheduler idle time
+  addHtml(prefixHELP);
+  addHtml(F("scheduler_idle Percentage of time the scheduler was idle\n"));
+  addHtml(prefixTYPE);
+  addHtml(F("scheduler_idle gauge\n"));
+  addHtml(F("espeasy_scheduler_idle "));
+  addHtmlFloat(Scheduler.getIdleTimePct(), 2);
+  addHtml('\n');
+
   // devices
   handle_metrics_devices();
 
+# if FEATURE_EXTENDED_METRICS
+  handle_metrics_timing();
+  handle_metrics_controller_queues();
+# endif // if FEATURE_EXTENDED_METRICS
+
   TXBuffer.endStream();
 }
 
@@ -136,4 +156,175 @@ void handle_metrics_devices() {
   }
 }
 
+# if FEATURE_EXTENDED_METRICS
+
+// Write a number with leading zeroes, without allocating a String for the formatting.
+static void stream_metrics_leading_zeroes(uint32_t value, uint8_t nrDigits)
+{
+  uint32_t limit = 1;
+
+  for (uint8_t i = 1; i < nrDigits; ++i) {
+    limit *= 10;
+
+    if (value < limit) {
+      addHtml('0');
+    }
+  }
+  addHtmlInt(value);
+}
+
+// Write plugin or controller number like "P001" or "C005"
+static void stream_metrics_number(char prefix, uint8_t number)
+{
+  addHtml(prefix);
+  stream_metrics_leading_zeroes(number, 3);
+}
+
+// Write labels like: {plugin="P001",function="READ"
+// The closing brace is not added, so more labels can follow.
+static void stream_metrics_labels(const __FlashStringHelper *labelName,
+                                  char                       labelPrefix,
+                                  uint8_t                    labelNumber,
+                                  const __FlashStringHelper *function)
+{
+  addHtml('{');
+  addHtml(labelName);
+  addHtml(F("=\""));
+  stream_metrics_number(labelPrefix, labelNumber);
+  addHtml(F("\",function=\""));
+  addHtml(function);
+  addHtml('"');
+}
+
+#  if FEATURE_TIMING_STATS
+static void stream_metrics_histogram(const __FlashStringHelper *name,
+                                     const __FlashStringHelper *labelName,
+                                     char                       labelPrefix,
+                                     uint8_t                    labelNumber,
+                                     const __FlashStringHelper *function,
+                                     const TimingHistogram    & histogram)
+{
+  // Last bucket is "+Inf"
+  for (uint8_t bucket = 0; bucket <= TIMING_HISTOGRAM_NR_BUCKETS; ++bucket) {
+    addHtml(name);
+    addHtml(F("_bucket"));
+    stream_metrics_labels(labelName, labelPrefix, labelNumber, function);
+    addHtml(F(",le=\""));
+    addHtml(TimingHistogram::getBucketLabel(bucket));
+    addHtml(F("\"} "));
+    addHtmlInt(histogram.getCumulativeCount(bucket));
+    addHtml('\n');
+  }
+
+  addHtml(name);
+  addHtml(F("_sum"));
+  stream_metrics_labels(labelName, labelPrefix, labelNumber, function);
+  addHtml(F("} "));
+
+  // Sum is in usec, output in seconds
+  const uint64_t sum_usec = histogram.getSum();
+  addHtmlInt(static_cast<uint64_t>(sum_usec / 1000000ull));
+  addHtml('.');
+  stream_metrics_leading_zeroes(static_cast<uint32_t>(sum_usec % 1000000ull), 6);
+  addHtml('\n');
+
+  addHtml(name);
+  addHtml(F("_count"));
+  stream_metrics_labels(labelName, labelPrefix, labelNumber, function);
+  addHtml(F("} "));
+  addHtmlInt(histogram.getCount());
+  addHtml('\n');
+}
+
+#  endif // if FEATURE_TIMING_STATS
+
+void handle_metrics_timing() {
+#  if FEATURE_TIMING_STATS
+
+  // Only collected when "Enable Timing Statistics" is checked in the advanced settings.
+  if (!pluginHistograms.empty()) {
+    addHtml(F("# HELP espeasy_plugin_duration_seconds Duration of plugin function calls\n"));
+    addHtml(F("# TYPE espeasy_plugin_duration_seconds histogram\n"));
+
+    for (auto& x : pluginHistograms) {
+      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(x.first >> 8);
+
+      if (validDeviceIndex(deviceIndex)) {
+        stream_metrics_histogram(
+          F("espeasy_plugin_duration_seconds"),
+          F("plugin"),
+          'P',
+          getPluginID_from_DeviceIndex(deviceIndex).value,
+          getPluginFunctionName(x.first % 256),
+          x.second);
+      }
+    }
+  }
+
+  if (!controllerHistograms.empty()) {
+    addHtml(F("# HELP espeasy_controller_duration_seconds Duration of controller function calls\n"));
+    addHtml(F("# TYPE espeasy_controller_duration_seconds histogram\n"));
+
+    for (auto& x : controllerHistograms) {
+      stream_metrics_histogram(
+        F("espeasy_controller_duration_seconds"),
+        F("controller"),
+        'C',
+        getCPluginID_from_ProtocolIndex(x.first >> 8),
+        getCPluginCFunctionName(static_cast<CPlugin::Function>(x.first % 256)),
+        x.second);
+    }
+  }
+#  endif // if FEATURE_TIMING_STATS
+}
+
+static void stream_metrics_controller_labels(controllerIndex_t x)
+{
+  addHtml(F("{controller=\""));
+  addHtmlInt(x + 1);
+  addHtml(F("\",protocol=\""));
+  stream_metrics_number('C', getCPluginID_from_ControllerIndex(x));
+  addHtml(F("\"} "));
+}
+
+void handle_metrics_controller_queues() {
+  for (uint8_t c = 0; c < static_cast<uint8_t>(ControllerQueueCounter::NR_ELEMENTS); ++c) {
+    const __FlashStringHelper *counterName = getControllerQueueCounterName(static_cast<ControllerQueueCounter>(c));
+
+    addHtml(F("# HELP espeasy_controller_queue_"));
+    addHtml(counterName);
+    addHtml(F("_total Number of controller queue messages "));
+    addHtml(counterName);
+    addHtml('\n');
+    addHtml(F("# TYPE espeasy_controller_queue_"));
+    addHtml(counterName);
+    addHtml(F("_total counter\n"));
+
+    for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+      if (Settings.ControllerEnabled[x] && (Settings.Protocol[x] != 0)) {
+        addHtml(F("espeasy_controller_queue_"));
+        addHtml(counterName);
+        addHtml(F("_total"));
+        stream_metrics_controller_labels(x);
+        addHtmlInt(controllerQueueStats[x].counters[c]);
+        addHtml('\n');
+      }
+    }
+  }
+
+  addHtml(F("# HELP espeasy_controller_queue_depth Number of messages in the controller queue\n"));
+  addHtml(F("# TYPE espeasy_controller_queue_depth gauge\n"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (Settings.ControllerEnabled[x] && (Settings.Protocol[x] != 0)) {
+      addHtml(F("espeasy_controller_queue_depth"));
+      stream_metrics_controller_labels(x);
+      addHtmlInt(controllerQueueStats[x].depth);
+      addHtml('\n');
+    }
+  }
+}
+
+# endif // if FEATURE_EXTENDED_METRICS
+
 #endif // WEBSERVER_METRICS
@@ -8,6 +8,11 @@
 void handle_metrics();
 void handle_metrics_devices();
 
+# if FEATURE_EXTENDED_METRICS
+void handle_metrics_timing();
+void handle_metrics_controller_queues();
+# endif // if FEATURE_EXTENDED_METRICS
+
 #endif    // ifdef WEBSERVER_METRICS
 
 #endif
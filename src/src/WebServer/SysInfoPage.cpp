@@ -404,6 +404,8 @@ void handle_sysinfo_memory() {
 # endif // ifndef BUILD_NO_RAM_TRACKER
   }
 
+  addRowLabelValue(LabelType::EVENT_QUEUE);
+
 # if defined(ESP32) && defined(BOARD_HAS_PSRAM)
 
   addRowLabelValue(LabelType::PSRAM_SIZE);
@@ -616,9 +618,11 @@ void handle_sysinfo_SystemStatus() {
 
     LabelType::ENABLE_SERIAL_PORT_CONSOLE,
     LabelType::CONSOLE_SERIAL_PORT,
+    LabelType::CONSOLE_WRITE_BUFFER,
 #if USES_ESPEASY_CONSOLE_FALLBACK_PORT
     LabelType::CONSOLE_FALLBACK_TO_SERIAL0,
     LabelType::CONSOLE_FALLBACK_PORT,
+    LabelType::CONSOLE_FALLBACK_WRITE_BUFFER,
 #endif
     LabelType::MAX_LABEL
   };
@@ -649,6 +653,31 @@ void handle_sysinfo_NetworkServices() {
     addEnabled(MQTTclient_connected);
   }
   #endif
+
+  #if FEATURE_ESPEASY_P2P
+  if (Settings.UDPPort != 0) {
+    addRowLabel(F("ESPEasy p2p UDP"));
+
+    for (uint8_t i = 0; i < UDP_STATS_MESSAGE_TYPES; ++i) {
+      const UDP_message_stats_t& stats = getUDP_message_stats(i);
+
+      if (stats.received != 0) {
+        if (i == 0) {
+          addHtml(F("Command"));
+        } else if (i == (UDP_STATS_MESSAGE_TYPES - 1)) {
+          addHtml(F("Other"));
+        } else {
+          addHtml(concat(F("Type "), i));
+        }
+        addHtml(strformat(
+          F(": %u received / %u dropped / %u oversized<BR>"),
+          stats.received,
+          stats.dropped,
+          stats.oversized));
+      }
+    }
+  }
+  #endif
 }
 #endif
 
@@ -745,6 +774,25 @@ void handle_sysinfo_Storage() {
     RTC.flashDayCounter,
     static_cast<int>(RTC.flashCounter)));
 
+  addRowLabel(F("Settings Writes"));
+
+  for (uint8_t i = 0; i <= static_cast<uint8_t>(SettingsType::SettingsFileEnum::FILE_UNKNOWN_type); ++i) {
+    const SettingsType::SettingsFileEnum file_type = static_cast<SettingsType::SettingsFileEnum>(i);
+    const SettingsFileWriteStats& stats            = getSettingsFileWriteStats(file_type);
+
+    if (i != 0) {
+      addHtml(F("<BR>"));
+    }
+    addHtml((file_type == SettingsType::SettingsFileEnum::FILE_UNKNOWN_type)
+            ? F("other")
+            : SettingsType::getSettingsFileName(file_type));
+    addHtml(strformat(
+      F(": %u saved / %u unchanged / %u blocks"),
+      stats.saves,
+      stats.skipped,
+      stats.blocks));
+  }
+
   {
     uint32_t maxSketchSize;
     bool     use2step;